@@ -19,38 +19,199 @@
 //#include <KDB_ImGui/fonts/FontManager.h>
 
 #include <HBUI/WindowManager.h>
+#include <UIWindows/CommandPalette.h>
 #include <UIWindows/MainMenuBar.h>
-
-#include <portable-file-dialogs.h>
+#include <Rendering/FramePacer.h>
+#include <Plugins/PluginCatalog.h>
+#include <Profiling/Profiler.h>
+#include <Async/IoReactor.h>
+#include <Commands/PluginCommands.h>
+#include <Workspace/PluginWindows.h>
+#include <Memory/AllocationCounter.h>
+#include <Memory/FrameArena.h>
+#include <Memory/ImGuiAllocator.h>
+#include <Memory/MemoryPressureManager.h>
+#include <Metrics/MetricsServer.h>
+#include <Metrics/PluginMetrics.h>
+#include <Metrics/StatsRegistry.h>
+#include <Remote/AgentRegistry.h>
+#include <Startup/StartupTimeline.h>
+#include <Threading/FrameScheduler.h>
+#include <Threading/MainThreadQueue.h>
+#include <Threading/ThreadPool.h>
+#include <Utils/Input.h>
+#include <Workspace/WorkspaceManager.h>
 
 #include <dlfcn.h>
 #include <iostream>
 
-typedef bool (*LoadPluginFunc)(const std::filesystem::path &path, HummingBird::Plugins::IPlugin *pluginManager);
+typedef bool (*RegisterPluginFunc)(const HummingBird::Plugins::PluginManifest &manifest, HummingBird::Plugins::IPlugin *pluginManager);
 
 namespace HummingBirdCore {
+  namespace {
+    std::vector<uint8_t> readFontFile(const std::filesystem::path &path) {
+      const double start = Startup::StartupTimeline::now();
+      std::vector<uint8_t> data;
+      if (!Utils::FileUtils::readFromFile(path.string(), &data)) {
+        CORE_WARN("Unable to read font " + path.string() + ", using the default font");
+        data.clear();
+      }
+      Startup::StartupTimeline::addStage("Read font", start, true);
+      return data;
+    }
+  }// namespace
+
   void Application::init() {
+    Startup::StartupTimeline::begin();
+    //before any thread records a zone, the rings are sized when they are allocated
+    if (const char *zones = std::getenv("HUMMINGBIRD_PROFILE_ZONES"); zones != nullptr) {
+      const long long count = std::strtoll(zones, nullptr, 10);
+      if (count > 0)
+        Profiling::Profiler::setRingCapacity((uint64_t) count);
+      else
+        CORE_WARN("Ignoring invalid HUMMINGBIRD_PROFILE_ZONES: {0}", zones);
+    }
+    Profiling::Profiler::setThreadName("Main");
+    //before HBUI creates the ImGui context, every ImGui allocation has to come from the pools
+    Memory::ImGuiAllocator::install();
+
+    //disk and dynamic linker work overlaps with creating the window
+    Threading::ThreadPool &threadPool = Threading::ThreadPool::get();
+    m_fontData = threadPool.submit([path = c_fontPath] { return readFontFile(path); });
+    //reads the manifests and maps and relocates the libraries of the plugins that are not lazy
+    m_pluginPreload = threadPool.submit([managerPath = c_pluginManagerPath, examplePath = c_examplePluginPath, directory = c_testPluginsPath] {
+      const double start = Startup::StartupTimeline::now();
+      Plugins::PluginCatalog catalog;
+      catalog.discover({examplePath}, directory);
+      catalog.preload(Threading::ThreadPool::get(), {managerPath});
+      Startup::StartupTimeline::addStage("Preload plugins", start, true);
+      return catalog;
+    });
+
+    double start = Startup::StartupTimeline::now();
     HBUI::initialize();
-    pfd::message("Welcome to Hummingbird Core", "Welcome to Hummingbird Core, the core of the Hummingbird Engine. "
-                                                "This is a work in progress, so expect bugs and crashes. If you find any, "
-                                                "please report them to the Hummingbird Github page. \n"
-                                                "Enjoy!");
-    //load fonts
-    ImFontConfig fontConfig = ImFontConfig();
+    Startup::StartupTimeline::addStage("HBUI::initialize", start);
+    //after HBUI so ImGui's GLFW callbacks are the ones being chained
+    Input::install((GLFWwindow *) ImGui::GetMainViewport()->PlatformHandle);
 
-    fontConfig.RasterizerDensity = 2.0f;
-    fontConfig.RasterizerMultiply = 1.0f;
+    //opt-in, can also be toggled from View -> Idle Rendering
+    if (const char *idle = std::getenv("HUMMINGBIRD_IDLE_RENDERING"); idle != nullptr && std::string(idle) == "1") {
+      Rendering::FramePacer::setIdleMode(true);
+    }
+    //frame jobs get what is left of this, 16.6 ms by default
+    if (const char *frameTarget = std::getenv("HUMMINGBIRD_FRAME_TARGET_MS"); frameTarget != nullptr) {
+      const double targetMs = std::strtod(frameTarget, nullptr);
+      if (targetMs > 0.0)
+        Threading::FrameScheduler::setTargetFrameMs(targetMs);
+      else
+        CORE_WARN("Ignoring invalid HUMMINGBIRD_FRAME_TARGET_MS: {0}", frameTarget);
+    }
+
+    //windows register their reclaimable state with it on construction
+    Memory::MemoryPressureManager::initialize();
+
+    //opt-in, serves the stats registry to Prometheus on 127.0.0.1
+    if (const char *metricsPort = std::getenv("HUMMINGBIRD_METRICS_PORT"); metricsPort != nullptr) {
+      const long port = std::strtol(metricsPort, nullptr, 10);
+      if (port > 0 && port <= 65535)
+        Metrics::MetricsServer::start((uint16_t) port);
+      else
+        CORE_WARN("Ignoring invalid HUMMINGBIRD_METRICS_PORT: {0}", metricsPort);
+    }
+
+    //connects to the agents in HUMMINGBIRD_AGENTS, more can be added from Developer Tools -> Fleet
+    Remote::AgentRegistry::initialize();
 
     HummingBirdCore::UI::WindowManager *windowManager = new UI::WindowManager();
     HummingBirdCore::UI::WindowManager::setInstance(windowManager);
 
-    if (!loadPluginManager("plugins/manager/libHUMMINGBIRD_PLUGIN_MANAGER.dylib")) {
-      CORE_ERROR("Failed to load plugin manager");
+    Workspace::WorkspaceManager::registerCoreWindows();
+    Workspace::WorkspaceManager::loadRecentFiles();
+    UI::registerCommands();
+    //opt-in, restores the session on start and saves it again on exit
+    if (const char *workspace = std::getenv("HUMMINGBIRD_WORKSPACE"); workspace != nullptr) {
+      m_workspacePath = workspace;
+      if (std::filesystem::exists(m_workspacePath)) {
+        Threading::MainThreadQueue::post([path = m_workspacePath] { Workspace::WorkspaceManager::load(path); });
+      }
     }
+
+    loadFonts();
     run();
   }
 
-  bool Application::loadPluginManager(const std::filesystem::path &path) {
+  void Application::loadFonts() {
+    //the atlas can only change before the backend uploads it on the first frame, so this stage is waited on
+    const double start = Startup::StartupTimeline::now();
+    std::vector<uint8_t> fontData = m_fontData.get();
+    if (fontData.empty())
+      return;
+
+    ImFontConfig fontConfig = ImFontConfig();
+    fontConfig.RasterizerDensity = 2.0f;
+    fontConfig.RasterizerMultiply = 1.0f;
+
+    //the atlas owns the data and frees it with the ImGui allocator
+    void *data = IM_ALLOC(fontData.size());
+    std::memcpy(data, fontData.data(), fontData.size());
+    ImGuiIO &io = ImGui::GetIO();
+    //the font is only added to the atlas, the first font stays the default one like before
+    if (io.Fonts->Fonts.empty())
+      io.Fonts->AddFontDefault();
+    io.Fonts->AddFontFromMemoryTTF(data, (int) fontData.size(), 16.0f, &fontConfig);
+    Startup::StartupTimeline::addStage("Load fonts", start);
+  }
+
+  void Application::updateStartup() {
+    if (m_pluginsLoaded || !m_pluginPreload.isValid())
+      return;
+    if (!m_pluginPreload.isReady()) {
+      //keep the placeholder alive while the worker is busy
+      Rendering::FramePacer::requestFrameIn(0.05);
+      return;
+    }
+
+    Plugins::PluginCatalog catalog = m_pluginPreload.get();
+    const double start = Startup::StartupTimeline::now();
+    if (!loadPluginManager(c_pluginManagerPath, catalog)) {
+      CORE_ERROR("Failed to load plugin manager");
+    }
+    Startup::StartupTimeline::addStage("Load plugins", start);
+
+    //the plugin manager holds its own references now
+    catalog.release();
+
+    m_pluginsLoaded = true;
+    Rendering::FramePacer::requestFrame();
+    Startup::StartupTimeline::markInteractive();
+  }
+
+  void Application::renderWelcome() {
+    if (!m_showWelcome)
+      return;
+
+    const ImGuiViewport *viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x * 0.5f, viewport->WorkPos.y + viewport->WorkSize.y * 0.5f),
+                            ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(420.0f, 0.0f), ImGuiCond_Appearing);
+    if (ImGui::Begin("Welcome to Hummingbird Core", &m_showWelcome, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDocking)) {
+      ImGui::TextWrapped("Welcome to Hummingbird Core, the core of the Hummingbird Engine. "
+                         "This is a work in progress, so expect bugs and crashes. If you find any, "
+                         "please report them to the Hummingbird Github page.");
+      ImGui::TextWrapped("Enjoy!");
+      ImGui::Separator();
+      if (m_pluginsLoaded) {
+        ImGui::Text("Ready in %.0f ms", Startup::StartupTimeline::getTimeToInteractive());
+      } else {
+        ImGui::Text("Loading plugins...");
+      }
+      if (ImGui::Button("Close"))
+        m_showWelcome = false;
+    }
+    ImGui::End();
+  }
+
+  bool Application::loadPluginManager(const std::filesystem::path &path, const Plugins::PluginCatalog &catalog) {
     // Pass the context to the libraries
     handle = dlopen(path.string().c_str(),
                     RTLD_LAZY);
@@ -81,6 +242,7 @@ namespace HummingBirdCore {
     ImGuiMemFreeFunc p_free;
     void *p_user_data;
     ImGui::GetAllocatorFunctions(&p_alloc, &p_free, &p_user_data);
+    p_user_data = Memory::ImGuiAllocator::get().registerOwner("PluginManager");
     pluginManager =
             create_plugin(HummingBirdCore::UI::WindowManager::getInstance(), ImGui::GetCurrentContext(), p_alloc, p_free, p_user_data);
     if (pluginManager == nullptr) {
@@ -89,56 +251,107 @@ namespace HummingBirdCore {
       return false;
     }
 
+    pluginManager->setTaskScheduler(&Threading::ThreadPool::get());
+    pluginManager->setAllocatorRegistry(&Memory::ImGuiAllocator::get());
+    pluginManager->setMetrics(&Metrics::PluginMetrics::get());
+    pluginManager->setCommandRegistry(&Commands::PluginCommands::get());
+    pluginManager->setWindowRegistry(&Workspace::PluginWindows::get());
     pluginManager->initialize();
-    LoadPluginFunc loadPlugin = (LoadPluginFunc) dlsym(handle, "loadPlugin");
+    RegisterPluginFunc registerPlugin = (RegisterPluginFunc) dlsym(handle, "registerPlugin");
 
-    if (loadPlugin == nullptr) {
-      CORE_ERROR("Failed to load symbol loadPlugin");
+    if (registerPlugin == nullptr) {
+      CORE_ERROR("Failed to load symbol registerPlugin");
       dlclose(handle);
       pluginManager->cleanup();
       delete pluginManager;
       return false;
     }
 
-    loadPlugin("plugins/EXAMPLE/libHUMMINGBIRD_PLUGIN_EXAMPLE.dylib", pluginManager);
-    //plugins in this folder will be automatically loaded
-    if (std::filesystem::exists("plugins/testplugins")) {
-      auto entries = std::filesystem::directory_iterator("plugins/testplugins/");
-      if (entries == std::filesystem::directory_iterator()) {
-        CORE_ERROR("No plugins found in plugins directory");
-        return false;
-      }
-      for (const auto &entry: entries) {
-        if (entry.is_regular_file() && entry.path().extension() == ".dylib")
-          loadPlugin(entry.path(), pluginManager);
-      }
+    //in dependency order, lazy plugins only add their commands and windows until one of them is used
+    for (const Plugins::Manifest &manifest: catalog.getPlugins()) {
+      if (!registerPlugin(manifest, pluginManager))
+        CORE_ERROR("Failed to load plugin {0} from {1}", manifest.name, manifest.library.string());
     }
     return true;
   }
 
   bool Application::run() {
+    Metrics::Histogram &frameTime = Metrics::StatsRegistry::histogram("frame.time");
+    Metrics::Counter &frames = Metrics::StatsRegistry::counter("frame.count");
     while (!HBUI::wantToClose()) {
-      if (pluginManager)
+      Rendering::FramePacer::waitForNextFrame();
+      Threading::FrameScheduler::beginFrame();
+      Profiling::Profiler::beginFrame();
+      Memory::AllocationCounter::beginFrame();
+      updateStartup();
+      Threading::MainThreadQueue::drain();
+      Memory::MemoryPressureManager::update();
+      if (pluginManager) {
+        HB_PROFILE_SCOPE("PluginManager::update");
         pluginManager->update();
+      }
       render();
+      Startup::StartupTimeline::markFirstFrame();
+      Memory::AllocationCounter::endFrame();
+      Memory::ImGuiAllocator::updateStats();
+      Profiling::Profiler::endFrame();
+      Rendering::FramePacer::endFrame();
+      frameTime.record((uint64_t) (Profiling::Profiler::getLastFrameTime() * 1000.0f));
+      frames.add();
     }
+    return true;
   }
 
   void Application::render() {
-    HBUI::startFrame();
+    HB_PROFILE_SCOPE("Application::render");
+    {
+      HB_PROFILE_SCOPE("HBUI::startFrame");
+      HBUI::startFrame();
+    }
+    //everything that arrived while waiting and polling belongs to this frame
+    Input::beginFrame();
     HBUI::beginFullScreenDockspace(false, false);
-    HummingBirdCore::UI::WindowManager::getInstance()->render();
-    HBUI::endFrame();
+    {
+      HB_PROFILE_SCOPE("WindowManager::render");
+      HummingBirdCore::UI::WindowManager::getInstance()->render();
+    }
+    renderWelcome();
+    UI::CommandPalette::render();
+    //after the windows so the jobs only get the time they left, before endFrame so their ImGui state is in this frame
+    Threading::FrameScheduler::run();
+    {
+      HB_PROFILE_SCOPE("HBUI::endFrame");
+      HBUI::endFrame();
+    }
+    Input::endFrame();
+    //everything handed out this frame is released at once, ImGui copied what it needed
+    Memory::FrameArena::get().reset();
   }
 
   void Application::shutdown() {
     CORE_INFO("Shutting down");
+    if (!m_workspacePath.empty())
+      Workspace::WorkspaceManager::save(m_workspacePath);
+    //diff against the file of an earlier run to spot regressions
+    if (const char *statsPath = std::getenv("HUMMINGBIRD_STATS_OUT"); statsPath != nullptr)
+      Metrics::StatsRegistry::exportJson(statsPath);
+
     if (pluginManager != nullptr) {
       pluginManager->cleanup();
       delete pluginManager;
     }
-    dlclose(handle);
+    if (handle != nullptr)
+      dlclose(handle);
 
+    Remote::AgentRegistry::shutdown();
+    Metrics::MetricsServer::stop();
+    Memory::MemoryPressureManager::shutdown();
+    Input::uninstall();
     HBUI::shutdown();
+    //after the windows are gone, a command that is still reading gets its end of output
+    Async::IoReactor::shutdown();
+    //last, the reactor hands its cancelled watches to the pool. Joined here, not by the static destructor, while
+    //the statics the tasks use are still alive
+    Threading::ThreadPool::get().shutdown();
   }
 }// namespace HummingBirdCore
\ No newline at end of file
@@ -7,6 +7,9 @@
 #include <PCH/pch.h>
 #include <HBUI/HBUI.h>
 
+#include "Plugins/PluginCatalog.h"
+#include "Threading/ThreadPool.h"
+
 #include "../../HummingBirdPluginManager/include/IPlugin.h"
 
 namespace HummingBirdCore {
@@ -22,7 +25,14 @@ public:
 private:
     void init();
 
-    bool loadPluginManager(const std::filesystem::path &path);
+    bool loadPluginManager(const std::filesystem::path &path, const Plugins::PluginCatalog &catalog);
+
+    /**
+     * @brief Finishes the startup stages that completed on a worker, called at the start of every frame.
+     */
+    void updateStartup();
+    void loadFonts();
+    void renderWelcome();
 
     void render();
     void shutdown();
@@ -30,6 +40,18 @@ private:
 private:
     HummingBird::Plugins::IPlugin* pluginManager = nullptr;
     void* handle = nullptr;
+
+    //startup
+    Threading::TaskHandle<std::vector<uint8_t>> m_fontData;
+    Threading::TaskHandle<Plugins::PluginCatalog> m_pluginPreload;
+    bool m_pluginsLoaded = false;
+    bool m_showWelcome = true;
+    std::filesystem::path m_workspacePath;
+
+    const std::filesystem::path c_fontPath = "Assets/Fonts/JetBrainsMono/JetBrainsMonoNerdFont-Regular.ttf";
+    const std::filesystem::path c_pluginManagerPath = "plugins/manager/libHUMMINGBIRD_PLUGIN_MANAGER.dylib";
+    const std::filesystem::path c_examplePluginPath = "plugins/EXAMPLE/libHUMMINGBIRD_PLUGIN_EXAMPLE.dylib";
+    const std::filesystem::path c_testPluginsPath = "plugins/testplugins/";
   };
 
 }// namespace HummingBirdCore
\ No newline at end of file
@@ -0,0 +1,163 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Task.h"
+
+#include "Threading/MainThreadQueue.h"
+
+namespace HummingBirdCore::Async {
+  namespace Detail {
+    /**
+     * @brief Remembers the token of the awaiting task, resuming throws once it got cancelled meanwhile.
+     */
+    class CancellableAwaiter {
+  protected:
+      template<typename Promise>
+      void bindToken(std::coroutine_handle<Promise> handle) {
+        m_token = handle.promise().token;
+      }
+
+      void throwIfCancelled() const {
+        if (m_token.isCancelled())
+          throw CancelledError();
+      }
+
+  private:
+      Threading::CancellationToken m_token;
+    };
+
+    class PoolAwaiter : public CancellableAwaiter {
+  public:
+      bool await_ready() const noexcept { return false; }
+
+      template<typename Promise>
+      void await_suspend(std::coroutine_handle<Promise> handle) {
+        bindToken(handle);
+        Threading::ThreadPool::get().post([handle] { handle.resume(); });
+      }
+
+      void await_resume() const { throwIfCancelled(); }
+    };
+
+    class NextFrameAwaiter : public CancellableAwaiter {
+  public:
+      bool await_ready() const noexcept { return false; }
+
+      template<typename Promise>
+      void await_suspend(std::coroutine_handle<Promise> handle) {
+        bindToken(handle);
+        //never dropped, a cancelled task still has to resume to unwind. Awaited inside a drain the post lands behind
+        //the drain's snapshot, so the task continues in the next frame instead of spinning in this one
+        Threading::MainThreadQueue::post([handle] { handle.resume(); });
+      }
+
+      void await_resume() const { throwIfCancelled(); }
+    };
+
+    class CancelCheckAwaiter : public CancellableAwaiter {
+  public:
+      bool await_ready() const noexcept { return false; }
+
+      //only here to get at the promise, never actually suspends
+      template<typename Promise>
+      bool await_suspend(std::coroutine_handle<Promise> handle) {
+        bindToken(handle);
+        return false;
+      }
+
+      void await_resume() const { throwIfCancelled(); }
+    };
+
+    template<typename F>
+    class PoolCallAwaiter : public CancellableAwaiter {
+  public:
+      using Result = std::invoke_result_t<F>;
+
+      explicit PoolCallAwaiter(F func) : m_func(std::move(func)) {}
+
+      bool await_ready() const noexcept { return false; }
+
+      //the awaiter lives in the suspended coroutine frame until the worker resumes it
+      template<typename Promise>
+      void await_suspend(std::coroutine_handle<Promise> handle) {
+        bindToken(handle);
+        Threading::ThreadPool::get().post([this, handle] {
+          try {
+            if constexpr (std::is_void_v<Result>) {
+              m_func();
+            } else {
+              m_result.emplace(m_func());
+            }
+          } catch (...) {
+            m_exception = std::current_exception();
+          }
+          handle.resume();
+        });
+      }
+
+      Result await_resume() {
+        throwIfCancelled();
+        if (m_exception)
+          std::rethrow_exception(m_exception);
+        if constexpr (!std::is_void_v<Result>)
+          return std::move(*m_result);
+      }
+
+  private:
+      F m_func;
+      std::conditional_t<std::is_void_v<Result>, bool, std::optional<Result>> m_result = {};
+      std::exception_ptr m_exception = nullptr;
+    };
+  }// namespace Detail
+
+  /**
+   * @brief Continues the task on a pool worker.
+   */
+  inline Detail::PoolAwaiter switchToPool() {
+    return {};
+  }
+
+  /**
+   * @brief Continues the task on the main thread before the next frame renders, the only place to touch window state.
+   * Awaited on the main thread it always yields to the next frame, a loop of nextFrame() runs once per frame.
+   */
+  inline Detail::NextFrameAwaiter nextFrame() {
+    return {};
+  }
+
+  /**
+   * @brief Throws CancelledError when the task got cancelled, for long loops that never suspend.
+   */
+  inline Detail::CancelCheckAwaiter throwIfCancelled() {
+    return {};
+  }
+
+  /**
+   * @brief Runs func on a pool worker and continues the task there with its result, exceptions are rethrown.
+   */
+  template<typename F>
+  Detail::PoolCallAwaiter<std::decay_t<F>> runOnPool(F &&func) {
+    return Detail::PoolCallAwaiter<std::decay_t<F>>(std::forward<F>(func));
+  }
+
+  /**
+   * @brief Reads a whole file on a pool worker and continues the task there.
+   * @return The contents, nullopt when the file could not be read
+   */
+  inline auto readFile(std::filesystem::path path) {
+    return runOnPool([path = std::move(path)]() -> std::optional<std::string> {
+      std::ifstream file(path, std::ios::binary);
+      if (!file.is_open()) {
+        CORE_ERROR("Unable to open file: " + path.string());
+        return std::nullopt;
+      }
+      std::stringstream buffer;
+      buffer << file.rdbuf();
+      return buffer.str();
+    });
+  }
+}// namespace HummingBirdCore::Async
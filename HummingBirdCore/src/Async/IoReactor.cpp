@@ -0,0 +1,169 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "IoReactor.h"
+
+#include <fcntl.h>
+#include <csignal>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace HummingBirdCore::Async {
+  void IoReactor::watch(int fd, Callback callback, const Threading::CancellationToken &token) {
+    {
+      std::lock_guard<std::mutex> lock(s_mutex);
+      if (s_stopping) {
+        callback(true);
+        return;
+      }
+      start();
+      s_watches.push_back({fd, std::move(callback), token});
+    }
+    wake();
+  }
+
+  void IoReactor::reap(pid_t pid, std::chrono::milliseconds grace) {
+    {
+      std::lock_guard<std::mutex> lock(s_mutex);
+      if (!s_stopping) {
+        start();
+        s_reaps.push_back({pid, std::chrono::steady_clock::now() + grace});
+        return;
+      }
+    }
+    //shutting down, there is nobody left to wait for it
+    kill(-pid, SIGKILL);
+    while (waitpid(pid, nullptr, 0) == -1 && errno == EINTR) {
+    }
+  }
+
+  size_t IoReactor::getReapCount() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_reaps.size();
+  }
+
+  void IoReactor::reapChildren(bool force) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = s_reaps.begin(); it != s_reaps.end();) {
+      if (!it->killed && (force || now >= it->killAt)) {
+        CORE_WARN("Process {0} ignored SIGTERM, killing it", it->pid);
+        kill(-it->pid, SIGKILL);
+        it->killed = true;
+      }
+      const pid_t reaped = waitpid(it->pid, nullptr, it->killed && force ? 0 : WNOHANG);
+      if (reaped == it->pid || (reaped == -1 && errno == ECHILD))
+        it = s_reaps.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  size_t IoReactor::getWatchCount() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return s_watches.size();
+  }
+
+  void IoReactor::start() {
+    if (s_thread != nullptr)
+      return;
+    if (pipe(s_wakeFds) == -1) {
+      CORE_ERROR("Unable to create the I/O reactor wake pipe");
+      return;
+    }
+    for (int fd: s_wakeFds) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+    s_thread = new std::thread(&IoReactor::run);
+  }
+
+  void IoReactor::wake() {
+    if (s_wakeFds[1] == -1)
+      return;
+    const char byte = 0;
+    [[maybe_unused]] const ssize_t written = write(s_wakeFds[1], &byte, 1);
+  }
+
+  void IoReactor::shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(s_mutex);
+      s_stopping = true;
+    }
+    if (s_thread != nullptr) {
+      wake();
+      s_thread->join();
+      delete s_thread;
+      s_thread = nullptr;
+      close(s_wakeFds[0]);
+      close(s_wakeFds[1]);
+      s_wakeFds[0] = s_wakeFds[1] = -1;
+    }
+
+    reapChildren(true);
+
+    //after the join, the thread may have put watches back until it saw s_stopping
+    std::vector<Watch> watches;
+    {
+      std::lock_guard<std::mutex> lock(s_mutex);
+      watches.swap(s_watches);
+    }
+    for (Watch &watch: watches) {
+      watch.callback(true);
+    }
+  }
+
+  void IoReactor::run() {
+    Profiling::Profiler::setThreadName("I/O reactor");
+    std::vector<pollfd> fds;
+    std::vector<Watch> ready;
+    while (true) {
+      fds.clear();
+      fds.push_back({s_wakeFds[0], POLLIN, 0});
+      {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        if (s_stopping)
+          return;
+        for (const Watch &watch: s_watches) {
+          fds.push_back({watch.fd, POLLIN, 0});
+        }
+      }
+
+      if (poll(fds.data(), (nfds_t) fds.size(), c_cancelCheckMs) == -1 && errno != EINTR) {
+        CORE_ERROR("I/O reactor poll failed: {0}", strerror(errno));
+        std::this_thread::sleep_for(std::chrono::milliseconds(c_cancelCheckMs));
+        continue;
+      }
+      reapChildren(false);
+      if (fds[0].revents != 0) {
+        char drain[64];
+        while (read(s_wakeFds[0], drain, sizeof(drain)) > 0) {
+        }
+      }
+
+      //the callbacks run without the lock, they may watch again
+      ready.clear();
+      {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        for (auto it = s_watches.begin(); it != s_watches.end();) {
+          const auto polled = std::find_if(fds.begin() + 1, fds.end(), [&](const pollfd &fd) { return fd.fd == it->fd; });
+          const bool readable = polled != fds.end() && polled->revents != 0;
+          if (readable || it->token.isCancelled()) {
+            ready.push_back(std::move(*it));
+            it = s_watches.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+
+      for (Watch &watch: ready) {
+        if (watch.callback(watch.token.isCancelled()))
+          continue;
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_watches.push_back(std::move(watch));
+      }
+    }
+  }
+}// namespace HummingBirdCore::Async
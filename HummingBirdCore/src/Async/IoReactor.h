@@ -0,0 +1,77 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Threading/ThreadPool.h"
+
+#include <sys/types.h>
+
+namespace HummingBirdCore::Async {
+  /**
+   * @brief One thread that polls non-blocking file descriptors for the tasks waiting on them.
+   *
+   * Waiting for a pipe on a pool worker parks that worker for as long as the other side stays open, a couple of
+   * `tail -f` commands would take the whole pool. Here a wait costs a pollfd. Callbacks run on the reactor thread,
+   * they read what is there and hand the rest of the work to the pool, they never block.
+   *
+   * A watch whose token gets cancelled is called with cancelled set within c_cancelCheckMs, even when the fd never
+   * becomes readable. The thread starts on the first watch and is stopped by shutdown().
+   */
+  //Class is fully static
+  class IoReactor {
+public:
+    /**
+     * @brief Called when the fd is readable or closed, or with cancelled set once the token is cancelled.
+     * @return true to stop watching
+     */
+    using Callback = std::function<bool(bool cancelled)>;
+
+    static void watch(int fd, Callback callback, const Threading::CancellationToken &token = Threading::CancellationToken());
+
+    /**
+     * @brief Reaps a child process group that got SIGTERM, SIGKILL follows when it is still there after grace.
+     * For destructors, nobody has to wait for a child that ignores SIGTERM.
+     */
+    static void reap(pid_t pid, std::chrono::milliseconds grace);
+
+    /**
+     * @brief Cancels every watch and joins the thread, called by the application on exit.
+     */
+    static void shutdown();
+
+    static size_t getWatchCount();
+    static size_t getReapCount();
+
+private:
+    struct Watch {
+      int fd = -1;
+      Callback callback;
+      Threading::CancellationToken token;
+    };
+
+    struct Reap {
+      pid_t pid = -1;
+      std::chrono::steady_clock::time_point killAt;
+      bool killed = false;
+    };
+
+    static void start();
+    static void reapChildren(bool force);
+    static void wake();
+    static void run();
+
+private:
+    static constexpr int c_cancelCheckMs = 50;
+
+    inline static std::mutex s_mutex = {};
+    inline static std::vector<Watch> s_watches = {};
+    inline static std::vector<Reap> s_reaps = {};
+    //never destroyed, a reactor that was not shut down must not terminate the process on exit
+    inline static std::thread *s_thread = nullptr;
+    inline static int s_wakeFds[2] = {-1, -1};
+    inline static bool s_stopping = false;
+  };
+}// namespace HummingBirdCore::Async
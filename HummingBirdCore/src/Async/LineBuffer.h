@@ -0,0 +1,63 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+namespace HummingBirdCore::Async {
+  /**
+   * @brief Splits output that arrives in arbitrary chunks into lines.
+   *
+   * Lines are taken from a read offset, the consumed front is only dropped once it is more than half of the buffer,
+   * so taking every line of a large chunk stays linear.
+   */
+  class LineBuffer {
+public:
+    void append(const char *data, size_t size) { m_buffer.append(data, size); }
+
+    /**
+     * @brief No more output follows, the last line is handed out without a newline.
+     */
+    void markEnd() { m_ended = true; }
+    bool isEnded() const { return m_ended; }
+
+    /**
+     * @return true when takeLine() returns a line or the end, without waiting for more output
+     */
+    bool isReady() const {
+      return m_ended || m_buffer.find('\n', m_offset) != std::string::npos;
+    }
+
+    /**
+     * @brief The next complete line without its newline, nullopt when there is none yet or the output ended.
+     */
+    std::optional<std::string> takeLine() {
+      const size_t newline = m_buffer.find('\n', m_offset);
+      if (newline == std::string::npos) {
+        if (!m_ended || m_offset == m_buffer.size())
+          return std::nullopt;
+        std::string rest = m_buffer.substr(m_offset);
+        m_buffer.clear();
+        m_offset = 0;
+        return rest;
+      }
+
+      std::string line = m_buffer.substr(m_offset, newline - m_offset);
+      m_offset = newline + 1;
+      if (m_offset == m_buffer.size()) {
+        m_buffer.clear();
+        m_offset = 0;
+      } else if (m_offset > m_buffer.size() / 2) {
+        m_buffer.erase(0, m_offset);
+        m_offset = 0;
+      }
+      return line;
+    }
+
+private:
+    std::string m_buffer;
+    size_t m_offset = 0;
+    bool m_ended = false;
+  };
+}// namespace HummingBirdCore::Async
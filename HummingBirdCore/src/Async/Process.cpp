@@ -0,0 +1,150 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "Process.h"
+
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace HummingBirdCore::Async {
+  Process::~Process() {
+    if (!isRunning()) {
+      wait();
+      return;
+    }
+    //a child that ignores SIGTERM is killed and reaped on the reactor, the destructor never blocks on it
+    terminate();
+    int status = 0;
+    if (waitpid(m_pid, &status, WNOHANG) == 0)
+      IoReactor::reap(m_pid, std::chrono::milliseconds(c_killGraceMs));
+    m_pid = -1;
+    wait();
+  }
+
+  bool Process::start(const std::string &command, const std::filesystem::path &workingDirectory) {
+    int pipeFd[2];
+    if (pipe(pipeFd) == -1) {
+      CORE_ERROR("Unable to create a pipe for: " + command);
+      return false;
+    }
+    //pipe2 is not on macOS, the ends are marked here so children of other Processes never inherit them, dup2 clears the flag in our own child
+    for (const int fd : pipeFd)
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    const pid_t pid = fork();
+    if (pid == -1) {
+      CORE_ERROR("Unable to fork for: " + command);
+      close(pipeFd[0]);
+      close(pipeFd[1]);
+      return false;
+    }
+
+    if (pid == 0) {// child process
+      //its own process group, terminate() reaches whatever the shell started too
+      setpgid(0, 0);
+      close(pipeFd[0]);
+      dup2(pipeFd[1], STDOUT_FILENO);
+      dup2(pipeFd[1], STDERR_FILENO);
+      if (pipeFd[1] != STDOUT_FILENO && pipeFd[1] != STDERR_FILENO)
+        close(pipeFd[1]);
+      //a directory that is gone keeps the inherited one, like the shell does when cd fails
+      if (!workingDirectory.empty()) {
+        [[maybe_unused]] const int changed = chdir(workingDirectory.c_str());
+      }
+      execl("/bin/sh", "sh", "-c", command.c_str(), nullptr);
+      _exit(127);
+    }
+
+    //set from both sides so terminate() can not signal the group before the child made it, the loser fails harmlessly
+    setpgid(pid, pid);
+    close(pipeFd[1]);
+    m_pid = pid;
+    m_output = pipeFd[0];
+    if (fcntl(m_output, F_SETFL, fcntl(m_output, F_GETFL) | O_NONBLOCK) == -1) {
+      CORE_ERROR("Unable to make the output of {0} non-blocking", command);
+      stop();
+      return false;
+    }
+    return true;
+  }
+
+  void Process::terminate() {
+    if (m_pid != -1)
+      kill(-m_pid, SIGTERM);
+  }
+
+  int Process::wait() {
+    if (m_output != -1) {
+      close(m_output);
+      m_output = -1;
+    }
+    if (m_pid == -1)
+      return -1;
+
+    int status = 0;
+    while (waitpid(m_pid, &status, 0) == -1 && errno == EINTR) {
+    }
+    m_pid = -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  }
+
+  int Process::stop(std::chrono::milliseconds grace) {
+    if (m_pid == -1)
+      return wait();
+
+    terminate();
+    const auto deadline = std::chrono::steady_clock::now() + grace;
+    int status = 0;
+    pid_t reaped = 0;
+    while ((reaped = waitpid(m_pid, &status, WNOHANG)) == 0 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    if (reaped == m_pid) {
+      m_pid = -1;
+      wait();
+      return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    CORE_WARN("Process {0} ignored SIGTERM for {1} ms, killing it", m_pid, grace.count());
+    kill(-m_pid, SIGKILL);
+    return wait();
+  }
+
+  bool Process::fill() {
+    if (m_output == -1)
+      return true;
+
+    char buffer[4096];
+    while (true) {
+      const ssize_t length = read(m_output, buffer, sizeof(buffer));
+      if (length > 0) {
+        m_lines.append(buffer, (size_t) length);
+        continue;
+      }
+      if (length == -1 && errno == EINTR)
+        continue;
+      //EOF, or an error that ends the output all the same
+      if (length == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+        m_lines.markEnd();
+      break;
+    }
+    return m_lines.isReady();
+  }
+
+  std::optional<std::string> Process::readLineBlocking(const Threading::CancellationToken &token) {
+    while (m_output != -1 && !m_lines.isReady()) {
+      if (token.isCancelled())
+        return std::nullopt;
+      pollfd fd = {m_output, POLLIN, 0};
+      if (poll(&fd, 1, c_cancelCheckMs) == -1 && errno != EINTR)
+        m_lines.markEnd();
+      else
+        fill();
+    }
+    return m_lines.takeLine();
+  }
+}// namespace HummingBirdCore::Async
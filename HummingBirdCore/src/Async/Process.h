@@ -0,0 +1,119 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Awaiters.h"
+#include "IoReactor.h"
+#include "LineBuffer.h"
+
+#include <sys/types.h>
+
+namespace HummingBirdCore::Async {
+  /**
+   * @brief Child process running through /bin/sh with stdout and stderr on one pipe, read line by line from a task.
+   *
+   * The pipe is non-blocking, a task waiting for output is parked on the IoReactor instead of a pool worker. The
+   * destructor sends SIGTERM to a process that is still running without waiting for it, the IoReactor reaps it and
+   * kills it after c_killGraceMs when it ignores SIGTERM. A cancelled task never leaves a zombie or blocks a worker.
+   */
+  class Process {
+public:
+    Process() = default;
+    ~Process();
+
+    Process(const Process &) = delete;
+    Process &operator=(const Process &) = delete;
+
+    /**
+     * @brief Forks and runs command in workingDirectory, the current directory when it is empty or does not exist.
+     * @return false when the pipe or the fork failed
+     */
+    bool start(const std::string &command, const std::filesystem::path &workingDirectory = {});
+
+    class LineAwaiter;
+
+    /**
+     * @brief Waits for the next line of output without holding a thread and continues the task on a pool worker.
+     * The newline is stripped, nullopt once the process closed its output.
+     */
+    LineAwaiter readLine();
+
+    /**
+     * @brief Sends SIGTERM to the process and everything it started, pending reads finish once they are gone.
+     */
+    void terminate();
+
+    /**
+     * @brief Closes the output and reaps the process.
+     * @return The exit code, -1 when it did not exit normally or never started
+     */
+    int wait();
+
+    /**
+     * @brief terminate(), then SIGKILL for whatever is still running after grace, and reaps the process.
+     * @return The exit code, -1 when it did not exit normally or never started
+     */
+    int stop(std::chrono::milliseconds grace = std::chrono::milliseconds(c_killGraceMs));
+
+    pid_t getPid() const { return m_pid; }
+    bool isRunning() const { return m_pid != -1; }
+
+    /**
+     * @brief readLine() without the task, for a thread that does nothing but wait for this process.
+     * Returns nullopt within c_cancelCheckMs once token is cancelled, also when the process keeps quiet.
+     */
+    std::optional<std::string> readLineBlocking(const Threading::CancellationToken &token = Threading::CancellationToken());
+
+    class LineAwaiter : public Detail::CancellableAwaiter {
+  public:
+      explicit LineAwaiter(Process &process) : m_process(process) {}
+
+      bool await_ready() const noexcept { return m_process.m_output == -1 || m_process.m_lines.isReady(); }
+
+      //the awaiter lives in the suspended coroutine frame until the reactor hands it to the pool
+      template<typename Promise>
+      void await_suspend(std::coroutine_handle<Promise> handle) {
+        bindToken(handle);
+        IoReactor::watch(
+                m_process.m_output,
+                [this, handle](bool cancelled) {
+                  if (!cancelled && !m_process.fill())
+                    return false;
+                  Threading::ThreadPool::get().post([handle] { handle.resume(); });
+                  return true;
+                },
+                handle.promise().token);
+      }
+
+      std::optional<std::string> await_resume() {
+        throwIfCancelled();
+        return m_process.m_lines.takeLine();
+      }
+
+  private:
+      Process &m_process;
+    };
+
+private:
+    /**
+     * @brief Reads whatever the pipe holds without blocking.
+     * @return true when a line or the end of the output is ready
+     */
+    bool fill();
+
+private:
+    static constexpr int c_killGraceMs = 500;
+    static constexpr int c_cancelCheckMs = 50;
+
+    pid_t m_pid = -1;
+    int m_output = -1;
+    LineBuffer m_lines;
+  };
+
+  inline Process::LineAwaiter Process::readLine() {
+    return LineAwaiter(*this);
+  }
+}// namespace HummingBirdCore::Async
@@ -0,0 +1,221 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Threading/ThreadPool.h"
+
+#include <coroutine>
+#include <optional>
+
+namespace HummingBirdCore::Async {
+  /**
+   * @brief Thrown out of a co_await once the task's cancellation token is cancelled.
+   * Spawned tasks swallow it, the coroutine unwinds without running any more of its body.
+   */
+  class CancelledError : public std::exception {
+public:
+    const char *what() const noexcept override { return "Task cancelled"; }
+  };
+
+  template<typename T>
+  class Task;
+
+  namespace Detail {
+    struct PromiseBase {
+      struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+          PromiseBase &promise = handle.promise();
+          if (promise.continuation)
+            return promise.continuation;
+          //nobody awaits a spawned task, it cleans up after itself
+          if (promise.detached) {
+            promise.reportDetachedError();
+            handle.destroy();
+          }
+          return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+      };
+
+      std::suspend_always initial_suspend() const noexcept { return {}; }
+      FinalAwaiter final_suspend() const noexcept { return {}; }
+      void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+      void reportDetachedError() const noexcept {
+        if (exception == nullptr)
+          return;
+        try {
+          std::rethrow_exception(exception);
+        } catch (const CancelledError &) {
+        } catch (const std::exception &e) {
+          CORE_ERROR("Task threw: {0}", e.what());
+        } catch (...) {
+          CORE_ERROR("Task threw an unknown exception");
+        }
+      }
+
+      std::coroutine_handle<> continuation = nullptr;
+      //handed down to every task this one awaits
+      Threading::CancellationToken token;
+      std::exception_ptr exception = nullptr;
+      bool detached = false;
+    };
+
+    template<typename T>
+    struct Promise : PromiseBase {
+      Task<T> get_return_object() noexcept;
+      void return_value(T result) { value = std::move(result); }
+
+      std::optional<T> value = std::nullopt;
+    };
+
+    template<>
+    struct Promise<void> : PromiseBase {
+      Task<void> get_return_object() noexcept;
+      void return_void() const noexcept {}
+    };
+  }// namespace Detail
+
+  /**
+   * @brief Lazily started coroutine, runs when it is co_awaited or spawned.
+   *
+   * A task resumes on whichever thread finished the thing it awaited, a pool worker after switchToPool(), a file
+   * read or a process read, the main thread after nextFrame(). Window state is only touched after nextFrame(),
+   * anything the task needs on a worker is copied into the coroutine before it leaves the main thread.
+   *
+   * Awaiting a task passes the cancellation token down, once it is cancelled the next co_await throws CancelledError.
+   */
+  template<typename T = void>
+  class [[nodiscard]] Task {
+public:
+    using promise_type = Detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : m_handle(handle) {}
+    ~Task() {
+      if (m_handle)
+        m_handle.destroy();
+    }
+
+    Task(Task &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    Task &operator=(Task &&other) noexcept {
+      if (this != &other) {
+        if (m_handle)
+          m_handle.destroy();
+        m_handle = std::exchange(other.m_handle, nullptr);
+      }
+      return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    bool isValid() const { return (bool) m_handle; }
+    Handle release() { return std::exchange(m_handle, nullptr); }
+
+    struct Awaiter {
+      Handle handle;
+
+      bool await_ready() const noexcept { return !handle || handle.done(); }
+
+      template<typename Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> caller) noexcept {
+        handle.promise().continuation = caller;
+        handle.promise().token = caller.promise().token;
+        return handle;
+      }
+
+      T await_resume() {
+        promise_type &promise = handle.promise();
+        if (promise.exception)
+          std::rethrow_exception(promise.exception);
+        if constexpr (!std::is_void_v<T>)
+          return std::move(*promise.value);
+      }
+    };
+
+    Awaiter operator co_await() const noexcept { return Awaiter{m_handle}; }
+
+private:
+    Handle m_handle = nullptr;
+  };
+
+  namespace Detail {
+    template<typename T>
+    Task<T> Promise<T>::get_return_object() noexcept {
+      return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> Promise<void>::get_return_object() noexcept {
+      return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+  }// namespace Detail
+
+  /**
+   * @brief Starts task on the calling thread and lets it run to completion on its own.
+   * Exceptions other than CancelledError are logged.
+   */
+  inline void spawn(Task<void> task, const Threading::CancellationToken &token = Threading::CancellationToken()) {
+    Task<void>::Handle handle = task.release();
+    if (!handle)
+      return;
+    handle.promise().token = token;
+    handle.promise().detached = true;
+    handle.resume();
+  }
+
+  /**
+   * @brief Tasks started by a window, cancelled when the window closes.
+   *
+   * Cancelling does not stop a task that is running, its next co_await throws CancelledError instead of resuming
+   * the body. wait() is for windows whose tasks never await the main thread, they can block in their destructor
+   * until nothing touches them anymore.
+   */
+  class TaskScope {
+public:
+    TaskScope() = default;
+    ~TaskScope() { cancel(); }
+
+    TaskScope(const TaskScope &) = delete;
+    TaskScope &operator=(const TaskScope &) = delete;
+
+    void spawn(Task<void> task) {
+      m_running->add();
+      Async::spawn(track(std::move(task), m_running), m_token);
+    }
+
+    void cancel() { m_token.cancel(); }
+    bool isCancelled() const { return m_token.isCancelled(); }
+
+    /**
+     * @brief Blocks until every spawned task finished. Deadlocks when called on the main thread while a task awaits nextFrame().
+     */
+    void wait() { m_running->wait(); }
+
+private:
+    //the wait group outlives the scope, tasks that are still unwinding mark themselves done on it
+    static Task<void> track(Task<void> task, std::shared_ptr<Threading::WaitGroup> running) {
+      try {
+        co_await task;
+      } catch (const CancelledError &) {
+      } catch (const std::exception &e) {
+        CORE_ERROR("Task threw: {0}", e.what());
+      } catch (...) {
+        CORE_ERROR("Task threw an unknown exception");
+      }
+      running->done();
+    }
+
+private:
+    Threading::CancellationToken m_token;
+    std::shared_ptr<Threading::WaitGroup> m_running = std::make_shared<Threading::WaitGroup>();
+  };
+}// namespace HummingBirdCore::Async
@@ -0,0 +1,89 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include <Bench/BenchRunner.h>
+#include <Bench/Benchmarks.h>
+#include <Log.h>
+
+namespace {
+  void printUsage() {
+    std::cout << "Usage: HummingBirdBench [options]\n"
+                 "  --filter text     Only run benchmarks with text in their name\n"
+                 "  --sizes a,b,c     Fixture sizes, every benchmark runs once per size (default: 1000)\n"
+                 "  --iterations n    Timed iterations per benchmark and size (default: 50)\n"
+                 "  --warmup n        Untimed iterations before those (default: 5)\n"
+                 "  --seed n          Seed the fixtures are generated from (default: 1)\n"
+                 "  --out file        Write the results as json\n"
+                 "  --list            List the benchmarks and what their size counts\n";
+  }
+
+  std::vector<size_t> splitSizes(const std::string &list) {
+    std::vector<size_t> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (!item.empty())
+        sizes.push_back(std::stoul(item));
+    }
+    return sizes;
+  }
+}// namespace
+
+int main(int argc, char **argv) {
+  HummingBirdCore::Log::Init();
+  //the trace lines of the code under test would end up in the timings and bury the report
+  HummingBirdCore::Log::getCoreLogLevel(spdlog::level::info);
+
+  const std::vector<HummingBirdCore::Bench::Benchmark> benchmarks = HummingBirdCore::Bench::getCoreBenchmarks();
+  HummingBirdCore::Bench::BenchOptions options;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      return 0;
+    }
+    if (arg == "--list") {
+      for (const auto &benchmark: benchmarks) {
+        std::cout << benchmark.name << " (" << benchmark.sizeUnit << ")\n";
+      }
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      printUsage();
+      return 1;
+    }
+
+    const std::string value = argv[++i];
+    try {
+      if (arg == "--filter") {
+        options.filter = value;
+      } else if (arg == "--sizes") {
+        options.sizes = splitSizes(value);
+      } else if (arg == "--iterations") {
+        options.iterations = std::stoi(value);
+      } else if (arg == "--warmup") {
+        options.warmupIterations = std::stoi(value);
+      } else if (arg == "--seed") {
+        options.seed = (uint32_t) std::stoul(value);
+      } else if (arg == "--out") {
+        options.outputPath = value;
+      } else {
+        std::cerr << "Unknown option " << arg << std::endl;
+        printUsage();
+        return 1;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+      return 1;
+    }
+  }
+  if (options.sizes.empty() || options.iterations <= 0) {
+    std::cerr << "Need at least one size and one iteration" << std::endl;
+    return 1;
+  }
+
+  HummingBirdCore::Bench::BenchRunner runner(options);
+  return runner.run(benchmarks);
+}
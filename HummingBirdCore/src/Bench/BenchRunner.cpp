@@ -0,0 +1,170 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "BenchRunner.h"
+
+#include <unistd.h>
+
+namespace HummingBirdCore::Bench {
+  namespace {
+    double percentile(const std::vector<double> &sorted, double p) {
+      if (sorted.empty())
+        return 0.0;
+      const double rank = p * (double) (sorted.size() - 1);
+      const size_t lower = (size_t) rank;
+      const size_t upper = std::min(lower + 1, sorted.size() - 1);
+      return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - (double) lower);
+    }
+
+    //FNV-1a, std::hash differs between standard libraries and the fixtures should not
+    uint32_t hashName(const std::string &name) {
+      uint32_t hash = 2166136261u;
+      for (char c: name) {
+        hash = (hash ^ (uint8_t) c) * 16777619u;
+      }
+      return hash;
+    }
+
+    std::string escape(const std::string &value) {
+      std::string escaped;
+      for (char c: value) {
+        if (c == '"' || c == '\\')
+          escaped += '\\';
+        escaped += c;
+      }
+      return escaped;
+    }
+  }// namespace
+
+  void BenchResult::calculate() {
+    if (iterationUs.empty())
+      return;
+
+    std::vector<double> sorted = iterationUs;
+    std::sort(sorted.begin(), sorted.end());
+    min = sorted.front();
+    p50 = percentile(sorted, 0.50);
+    p99 = percentile(sorted, 0.99);
+    max = sorted.back();
+    mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / (double) sorted.size();
+    //from the median, one slow iteration should not move the throughput
+    if (p50 > 0.0) {
+      itemsPerSecond = (double) items / (p50 / 1e6);
+      bytesPerSecond = (double) bytes / (p50 / 1e6);
+    }
+  }
+
+  BenchRunner::BenchRunner(const BenchOptions &options) : m_options(options) {
+    m_fixtureRoot = std::filesystem::temp_directory_path() / "HummingBird" / ("bench-" + std::to_string(getpid()));
+  }
+
+  BenchRunner::~BenchRunner() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_fixtureRoot, ec);
+  }
+
+  int BenchRunner::run(const std::vector<Benchmark> &benchmarks) {
+    bool success = true;
+    bool matched = false;
+    for (const auto &benchmark: benchmarks) {
+      if (!m_options.filter.empty() && !benchmark.name.contains(m_options.filter))
+        continue;
+      matched = true;
+      for (size_t size: m_options.sizes) {
+        BenchResult result;
+        result.name = benchmark.name;
+        result.size = size;
+        if (!runBenchmark(benchmark, size, result)) {
+          success = false;
+          continue;
+        }
+        result.calculate();
+        m_results.push_back(std::move(result));
+      }
+    }
+    if (!matched) {
+      CORE_ERROR("No benchmark matches " + m_options.filter);
+      return 1;
+    }
+
+    printReport();
+    if (!m_options.outputPath.empty() && !writeReport(m_options.outputPath))
+      success = false;
+    return success ? 0 : 1;
+  }
+
+  bool BenchRunner::runBenchmark(const Benchmark &benchmark, size_t size, BenchResult &result) {
+    BenchContext context;
+    context.size = size;
+    //seeded per benchmark, adding or filtering benchmarks does not change the fixtures of the others
+    context.random.seed(m_options.seed ^ hashName(benchmark.name));
+    context.fixtureDirectory = m_fixtureRoot / fmt::format("{0}-{1}", benchmark.name, size);
+
+    std::error_code ec;
+    std::filesystem::create_directories(context.fixtureDirectory, ec);
+    if (ec) {
+      CORE_ERROR("Unable to create fixture folder {0}: {1}", context.fixtureDirectory.string(), ec.message());
+      return false;
+    }
+
+    BenchIteration iteration;
+    try {
+      iteration = benchmark.setup(context);
+    } catch (const std::exception &e) {
+      CORE_ERROR("Unable to set up {0} for size {1}: {2}", benchmark.name, size, e.what());
+      return false;
+    }
+    result.items = context.items;
+    result.bytes = context.bytes;
+
+    CORE_INFO("Running {0} ({1} {2}): {3} warm-up iterations, {4} timed iterations", benchmark.name, size, benchmark.sizeUnit,
+              m_options.warmupIterations, m_options.iterations);
+    for (int i = 0; i < m_options.warmupIterations; i++) {
+      iteration();
+    }
+    result.iterationUs.reserve(m_options.iterations);
+    for (int i = 0; i < m_options.iterations; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      iteration();
+      const auto end = std::chrono::steady_clock::now();
+      result.iterationUs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    std::filesystem::remove_all(context.fixtureDirectory, ec);
+    return true;
+  }
+
+  void BenchRunner::printReport() const {
+    std::cout << fmt::format("{:<26}{:>10}{:>12}{:>12}{:>12}{:>12}{:>14}{:>12}\n", "Benchmark", "Size", "Min (us)", "p50 (us)", "p99 (us)",
+                             "Mean (us)", "Items/s", "MB/s");
+    for (const auto &result: m_results) {
+      std::cout << fmt::format("{:<26}{:>10}{:>12.2f}{:>12.2f}{:>12.2f}{:>12.2f}{:>14.0f}{:>12.1f}\n", result.name, result.size, result.min,
+                               result.p50, result.p99, result.mean, result.itemsPerSecond, result.bytesPerSecond / (1024.0 * 1024.0));
+    }
+  }
+
+  bool BenchRunner::writeReport(const std::filesystem::path &path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      CORE_ERROR("Unable to write bench report: " + path.string());
+      return false;
+    }
+
+    out << "{\"seed\":" << m_options.seed << ",\"iterations\":" << m_options.iterations << ",\"warmupIterations\":" << m_options.warmupIterations
+        << ",\"unit\":\"us\",\"benchmarks\":[";
+    for (size_t i = 0; i < m_results.size(); i++) {
+      const BenchResult &result = m_results[i];
+      if (i > 0)
+        out << ",";
+      out << fmt::format("{{\"name\":\"{}\",\"size\":{},\"items\":{},\"bytes\":{},\"min\":{:.4f},\"p50\":{:.4f},\"p99\":{:.4f},\"mean\":{:.4f},"
+                         "\"max\":{:.4f},\"itemsPerSecond\":{:.1f},\"bytesPerSecond\":{:.1f}}}",
+                         escape(result.name), result.size, result.items, result.bytes, result.min, result.p50, result.p99, result.mean, result.max,
+                         result.itemsPerSecond, result.bytesPerSecond);
+    }
+    out << "]}\n";
+
+    CORE_INFO("Wrote bench report to " + path.string());
+    return true;
+  }
+}// namespace HummingBirdCore::Bench
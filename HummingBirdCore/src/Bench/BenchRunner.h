@@ -0,0 +1,115 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <random>
+
+namespace HummingBirdCore::Bench {
+  struct BenchOptions {
+    //substring of the benchmark names to run, all of them when empty
+    std::string filter = {};
+    std::vector<size_t> sizes = {1000};
+    int iterations = 50;
+    int warmupIterations = 5;
+    //fixtures are generated from this seed, the same seed and size give the same fixture on every run
+    uint32_t seed = 1;
+    std::filesystem::path outputPath = {};
+  };
+
+  /**
+   * @brief What a benchmark gets to build its fixture with.
+   */
+  struct BenchContext {
+    size_t size = 0;
+    std::mt19937 random;
+    //empty folder for this benchmark and size, removed after it ran
+    std::filesystem::path fixtureDirectory = {};
+
+    //work done by one iteration, for the throughput columns. Set by the setup
+    size_t items = 0;
+    size_t bytes = 0;
+
+    size_t nextIndex(size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(random); }
+  };
+
+  /**
+   * @brief The timed part of a benchmark, set up once per size.
+   */
+  using BenchIteration = std::function<void()>;
+
+  struct Benchmark {
+    std::string name;
+    //what size counts, shown in --list
+    std::string sizeUnit;
+    /**
+     * @brief Generates the fixture for context.size and returns the iteration that runs on it.
+     * Throws when the fixture can not be built, the benchmark is reported as failed.
+     */
+    std::function<BenchIteration(BenchContext &)> setup;
+  };
+
+  struct BenchResult {
+    std::string name;
+    size_t size = 0;
+    size_t items = 0;
+    size_t bytes = 0;
+    std::vector<double> iterationUs = {};
+
+    double min = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+    double itemsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+
+    void calculate();
+  };
+
+  /**
+   * @brief Keeps the compiler from dropping work whose result is never used.
+   */
+  template<typename T>
+  inline void keep(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+  }
+
+  /**
+   * @brief Runs microbenchmarks of the core hot paths on generated fixtures.
+   *
+   * Every benchmark runs once per size: the setup builds its fixture, then the iteration runs the warm-up
+   * iterations untimed and the timed iterations one by one, so the report has the spread and not only an average.
+   * The fixtures only depend on the seed and the size, two runs with the same options measure the same work and
+   * their json reports can be compared to spot regressions.
+   */
+  class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions &options);
+    ~BenchRunner();
+
+    /**
+     * @brief Runs every benchmark that matches the filter and prints the report.
+     * @return Process exit code, 0 when every benchmark ran
+     */
+    int run(const std::vector<Benchmark> &benchmarks);
+
+private:
+    bool runBenchmark(const Benchmark &benchmark, size_t size, BenchResult &result);
+
+    void printReport() const;
+    bool writeReport(const std::filesystem::path &path) const;
+
+private:
+    BenchOptions m_options;
+    std::filesystem::path m_fixtureRoot = {};
+    std::vector<BenchResult> m_results = {};
+  };
+}// namespace HummingBirdCore::Bench
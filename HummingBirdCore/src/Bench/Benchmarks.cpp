@@ -0,0 +1,244 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "Benchmarks.h"
+
+#include <Async/LineBuffer.h>
+#include <Folder.h>
+#include <System/Hosts/EditHostsWindow.h>
+#include <Terminal/TerminalWindow.h>
+#include <Utils/Plist/PlistUtil.h>
+#include <Utils/UUID.h>
+#include <Utils/Utils.h>
+
+namespace HummingBirdCore::Bench {
+  namespace {
+    constexpr const char *c_words[] = {"local", "dev", "staging", "api", "cache", "db", "mail", "proxy", "build", "metrics"};
+    constexpr size_t c_wordCount = sizeof(c_words) / sizeof(c_words[0]);
+
+    void writeFixture(const std::filesystem::path &path, const std::string &content) {
+      std::ofstream out(path, std::ios::binary);
+      if (!out.is_open())
+        throw std::runtime_error("Unable to write " + path.string());
+      out << content;
+    }
+
+    std::string makeIPv4(BenchContext &context) {
+      return fmt::format("{0}.{1}.{2}.{3}", 10 + context.nextIndex(200), context.nextIndex(256), context.nextIndex(256), 1 + context.nextIndex(254));
+    }
+
+    std::string makeHostname(BenchContext &context, size_t line) {
+      return fmt::format("{0}-{1}.{2}.example.com", c_words[context.nextIndex(c_wordCount)], line, c_words[context.nextIndex(c_wordCount)]);
+    }
+
+    /**
+     * @brief A hosts file with enabled and disabled IPv4 and IPv6 entries, comments and blank lines, one per item.
+     */
+    std::string makeHostsFile(BenchContext &context) {
+      std::string hosts;
+      for (size_t line = 0; line < context.size; line++) {
+        const size_t kind = context.nextIndex(10);
+        if (kind < 4)
+          hosts += makeIPv4(context) + "\t" + makeHostname(context, line) + "\n";
+        else if (kind < 5)
+          hosts += fmt::format("2001:db8::{0:x}\t{1}\n", 1 + context.nextIndex(0xfffe), makeHostname(context, line));
+        else if (kind < 7)
+          hosts += "#" + makeIPv4(context) + " " + makeHostname(context, line) + "\n";
+        else if (kind < 9)
+          hosts += fmt::format("# {0} entries for the {1} machines\n", c_words[context.nextIndex(c_wordCount)], c_words[context.nextIndex(c_wordCount)]);
+        else
+          hosts += "\n";
+      }
+      return hosts;
+    }
+
+    /**
+     * @brief A launch agent with one extra key per item, strings, integers, booleans and small arrays.
+     */
+    std::string makePlist(BenchContext &context) {
+      std::string plist = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                          "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+                          "<plist version=\"1.0\">\n<dict>\n"
+                          "<key>Label</key>\n<string>com.hummingbird.bench</string>\n"
+                          "<key>ProgramArguments</key>\n<array>\n<string>/usr/bin/true</string>\n<string>--bench</string>\n</array>\n"
+                          "<key>StartCalendarInterval</key>\n<dict>\n<key>Minute</key>\n<integer>30</integer>\n<key>Hour</key>\n<integer>4</integer>\n</dict>\n";
+      for (size_t key = 0; key < context.size; key++) {
+        plist += fmt::format("<key>Key{0}</key>\n", key);
+        switch (context.nextIndex(4)) {
+          case 0:
+            plist += fmt::format("<string>/Users/bench/{0}/{1}</string>\n", c_words[context.nextIndex(c_wordCount)], key);
+            break;
+          case 1:
+            plist += fmt::format("<integer>{0}</integer>\n", context.nextIndex(100000));
+            break;
+          case 2:
+            plist += context.nextIndex(2) == 0 ? "<true/>\n" : "<false/>\n";
+            break;
+          default:
+            plist += "<array>\n";
+            for (size_t item = 0; item < 3; item++) {
+              plist += fmt::format("<string>{0}</string>\n", c_words[context.nextIndex(c_wordCount)]);
+            }
+            plist += "</array>\n";
+            break;
+        }
+      }
+      plist += "</dict>\n</plist>\n";
+      return plist;
+    }
+
+    /**
+     * @brief Lines of command output, between empty and a couple of hundred characters.
+     */
+    std::string makeOutput(BenchContext &context, size_t lines) {
+      std::string output;
+      for (size_t line = 0; line < lines; line++) {
+        const size_t words = context.nextIndex(24);
+        for (size_t word = 0; word < words; word++) {
+          output += c_words[context.nextIndex(c_wordCount)];
+          output += ' ';
+        }
+        output += '\n';
+      }
+      return output;
+    }
+
+    BenchIteration setupFolderScan(BenchContext &context, bool cold) {
+      for (size_t i = 0; i < context.size; i++) {
+        std::filesystem::create_directory(context.fixtureDirectory / fmt::format("folder-{0}", i));
+        //files are skipped by the scan but still have to be looked at
+        if (i % 4 == 0)
+          writeFixture(context.fixtureDirectory / fmt::format("file-{0}.txt", i), "bench");
+      }
+      context.items = context.size + context.size / 4;
+
+      auto folder = std::make_shared<Folder>(context.fixtureDirectory, "bench");
+      auto modified = std::make_shared<std::filesystem::file_time_type>(std::filesystem::last_write_time(context.fixtureDirectory));
+      return [folder, modified, cold] {
+        //a new modification time makes the folder cache list the folder again
+        if (cold) {
+          *modified += std::chrono::seconds(1);
+          std::filesystem::last_write_time(folder->Path, *modified);
+        }
+        folder->setChildDirectories();
+        keep(folder->SubDirectories.size());
+      };
+    }
+
+    BenchIteration setupFileRead(BenchContext &context, bool bytes) {
+      const std::filesystem::path path = context.fixtureDirectory / "fixture.txt";
+      std::string content = makeOutput(context, context.size * 8);
+      content.resize(context.size * 1024, 'x');
+      writeFixture(path, content);
+      context.items = 1;
+      context.bytes = content.size();
+
+      if (bytes) {
+        return [path] {
+          std::vector<uint8_t> contents;
+          Utils::FileUtils::readFromFile(path.string(), &contents);
+          keep(contents.size());
+        };
+      }
+      return [path] {
+        std::string contents;
+        Utils::FileUtils::readFromFile(path.string(), &contents);
+        keep(contents.size());
+      };
+    }
+  }// namespace
+
+  std::vector<Benchmark> getCoreBenchmarks() {
+    std::vector<Benchmark> benchmarks;
+
+    benchmarks.push_back({"hosts.parse", "lines", [](BenchContext &context) -> BenchIteration {
+                            auto hosts = std::make_shared<std::string>(makeHostsFile(context));
+                            context.items = context.size;
+                            context.bytes = hosts->size();
+                            return [hosts] {
+                              std::istringstream stream(*hosts);
+                              keep(System::EditHostsWindow::parseHostsFile(stream).size());
+                            };
+                          }});
+
+    benchmarks.push_back({"plist.parse", "keys", [](BenchContext &context) -> BenchIteration {
+                            const std::filesystem::path path = context.fixtureDirectory / "fixture.plist";
+                            const std::string plist = makePlist(context);
+                            writeFixture(path, plist);
+                            context.items = context.size;
+                            context.bytes = plist.size();
+                            return [path] {
+                              Utils::PlistUtil::Plist parsed;
+                              parsed.parsePlist(path.string());
+                              keep(parsed.getRootNode().children.size());
+                            };
+                          }});
+
+    benchmarks.push_back({"plist.write", "keys", [](BenchContext &context) -> BenchIteration {
+                            const std::filesystem::path source = context.fixtureDirectory / "fixture.plist";
+                            writeFixture(source, makePlist(context));
+                            auto plist = std::make_shared<Utils::PlistUtil::Plist>();
+                            if (!plist->parsePlist(source.string()))
+                              throw std::runtime_error("Unable to parse the generated plist");
+                            context.items = context.size;
+                            auto file = std::make_shared<Utils::File>("written", context.fixtureDirectory, ".plist", "");
+                            return [plist, file] { keep(plist->writePlist(*file)); };
+                          }});
+
+    benchmarks.push_back({"terminal.split_command", "commands", [](BenchContext &context) -> BenchIteration {
+                            auto command = std::make_shared<std::string>();
+                            for (size_t i = 0; i < context.size; i++) {
+                              if (i > 0)
+                                *command += " && ";
+                              //a single & is not a separator and stays in the command
+                              *command += fmt::format("cd /tmp/{0}-{1} & ls -la | grep {2}", c_words[context.nextIndex(c_wordCount)], i,
+                                                      c_words[context.nextIndex(c_wordCount)]);
+                            }
+                            context.items = context.size;
+                            context.bytes = command->size();
+                            return [command] { keep(Terminal::TerminalWindow::splitCommand(*command).size()); };
+                          }});
+
+    benchmarks.push_back({"terminal.output_lines", "lines", [](BenchContext &context) -> BenchIteration {
+                            auto output = std::make_shared<std::string>(makeOutput(context, context.size));
+                            context.items = context.size;
+                            context.bytes = output->size();
+                            //the chunks a terminal command reads from its pipe, without the process and the pipe around it
+                            return [output] {
+                              constexpr size_t c_chunkSize = 4096;
+                              Async::LineBuffer lines;
+                              size_t count = 0;
+                              for (size_t offset = 0; offset < output->size(); offset += c_chunkSize) {
+                                lines.append(output->data() + offset, std::min(c_chunkSize, output->size() - offset));
+                                while (std::optional<std::string> line = lines.takeLine()) {
+                                  count++;
+                                }
+                              }
+                              lines.markEnd();
+                              while (std::optional<std::string> line = lines.takeLine()) {
+                                count++;
+                              }
+                              keep(count);
+                            };
+                          }});
+
+    benchmarks.push_back({"folder.scan", "folders", [](BenchContext &context) { return setupFolderScan(context, true); }});
+    benchmarks.push_back({"folder.scan_cached", "folders", [](BenchContext &context) { return setupFolderScan(context, false); }});
+
+    benchmarks.push_back({"uuid.generate", "uuids", [](BenchContext &context) -> BenchIteration {
+                            const size_t count = context.size;
+                            context.items = count;
+                            return [count] {
+                              for (size_t i = 0; i < count; i++) {
+                                keep(Utils::generate_uuid());
+                              }
+                            };
+                          }});
+
+    benchmarks.push_back({"file.read_string", "KiB", [](BenchContext &context) { return setupFileRead(context, false); }});
+    benchmarks.push_back({"file.read_bytes", "KiB", [](BenchContext &context) { return setupFileRead(context, true); }});
+
+    return benchmarks;
+  }
+}// namespace HummingBirdCore::Bench
@@ -0,0 +1,15 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "BenchRunner.h"
+
+namespace HummingBirdCore::Bench {
+  /**
+   * @brief The hosts file, plist, terminal, folder, uuid and file read benchmarks, in the order they run.
+   */
+  std::vector<Benchmark> getCoreBenchmarks();
+}// namespace HummingBirdCore::Bench
@@ -0,0 +1,33 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "CommandRegistry.h"
+
+namespace HummingBirdCore::Commands {
+  void CommandRegistry::add(std::string category, std::string name, std::function<void()> action) {
+    add({std::move(category), std::move(name), std::move(action)});
+  }
+
+  void CommandRegistry::add(Command command) {
+    s_commands.push_back(std::move(command));
+    s_version++;
+  }
+
+  void CommandRegistry::remove(const std::string &category, const std::string &name) {
+    if (std::erase_if(s_commands, [&](const Command &command) { return command.category == category && command.name == name; }) > 0)
+      s_version++;
+  }
+
+  void CommandRegistry::addProvider(Provider provider) {
+    s_providers.push_back(std::move(provider));
+  }
+
+  void CommandRegistry::collect(std::vector<Command> &commands) {
+    HB_PROFILE_SCOPE("CommandRegistry::collect");
+    commands.insert(commands.end(), s_commands.begin(), s_commands.end());
+    for (const Provider &provider: s_providers) {
+      provider(commands);
+    }
+  }
+}// namespace HummingBirdCore::Commands
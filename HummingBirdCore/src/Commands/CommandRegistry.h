@@ -0,0 +1,67 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+namespace HummingBirdCore::Commands {
+  struct Command {
+    //shown in front of the name and searched with it, "Tools", "Window", "Terminal history"
+    //for fixed commands this is the menu path as well, '/' separates submenus: "Tools/System Tools"
+    std::string category;
+    std::string name;
+    std::function<void()> action;
+    //set for toggles, the menu shows a check mark while it returns true
+    std::function<bool()> isChecked = nullptr;
+    //only shown in the menu, the key itself is handled by whoever owns it
+    std::string shortcut = "";
+    //the menu draws a separator above it
+    bool separator = false;
+    bool enabled = true;
+  };
+
+  /**
+   * @brief Every action the main menu and the command palette can run.
+   *
+   * Fixed actions, the menu items and what plugins contribute, are added once and build the main menu as well.
+   * State that changes while the app runs, the open windows, recent workspaces and terminal history, is listed by
+   * providers that are asked each time the palette opens. Main thread only.
+   */
+  //Class is fully static
+  class CommandRegistry {
+public:
+    using Provider = std::function<void(std::vector<Command> &commands)>;
+
+    static void add(std::string category, std::string name, std::function<void()> action);
+    static void add(Command command);
+    /**
+     * @brief Removes every fixed command with this category and name.
+     */
+    static void remove(const std::string &category, const std::string &name);
+    static void addProvider(Provider provider);
+
+    /**
+     * @brief Appends the fixed commands followed by what every provider lists right now.
+     */
+    static void collect(std::vector<Command> &commands);
+
+    static size_t getCommandCount() { return s_commands.size(); }
+
+    /**
+     * @brief The fixed commands in the order they were added.
+     * Running one can add or remove commands, copy the action before calling it.
+     */
+    static const std::vector<Command> &getCommands() { return s_commands; }
+
+    /**
+     * @brief Changes whenever a fixed command is added or removed, the main menu rebuilds when it does.
+     */
+    static uint64_t getVersion() { return s_version; }
+
+private:
+    inline static std::vector<Command> s_commands = {};
+    inline static uint64_t s_version = 0;
+    inline static std::vector<Provider> s_providers = {};
+  };
+}// namespace HummingBirdCore::Commands
@@ -0,0 +1,231 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "FuzzyMatcher.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace HummingBirdCore::Commands {
+  namespace {
+    char toLower(char c) {
+      return (c >= 'A' && c <= 'Z') ? (char) (c - 'A' + 'a') : c;
+    }
+
+    bool isAlphaNumeric(char c) {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+    }
+
+    /**
+     * @return The first c in [it, end), or end
+     */
+    const char *findByte(const char *it, const char *end, char c) {
+#if defined(__SSE2__)
+      const __m128i needle = _mm_set1_epi8(c);
+      for (; end - it >= 16; it += 16) {
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) it), needle));
+        if (mask != 0)
+          return it + __builtin_ctz((unsigned) mask);
+      }
+#elif defined(__ARM_NEON)
+      const uint8x16_t needle = vdupq_n_u8((uint8_t) c);
+      for (; end - it >= 16; it += 16) {
+        const uint8x16_t equal = vceqq_u8(vld1q_u8((const uint8_t *) it), needle);
+        //NEON has no movemask, the narrowing shift packs every byte into 4 bits of one 64 bit lane
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+        if (mask != 0)
+          return it + (__builtin_ctzll(mask) >> 2);
+      }
+#endif
+      for (; it != end; ++it) {
+        if (*it == c)
+          return it;
+      }
+      return end;
+    }
+  }// namespace
+
+  uint32_t FuzzyMatcher::add(std::string_view text) {
+    const uint32_t id = (uint32_t) m_masks.size();
+    m_offsets.push_back((uint32_t) m_text.size());
+    m_lengths.push_back((uint32_t) text.size());
+
+    uint64_t mask = 0;
+    //the start of the entry counts as a word start
+    char previous = ' ';
+    for (const char c: text) {
+      int8_t bonus = 0;
+      if (!isAlphaNumeric(previous) && (unsigned char) previous < 0x80 && isAlphaNumeric(c))
+        bonus = c_bonusBoundary;
+      else if ((previous >= 'a' && previous <= 'z' && c >= 'A' && c <= 'Z') || (!(previous >= '0' && previous <= '9') && c >= '0' && c <= '9'))
+        bonus = c_bonusCamel;
+
+      const char lowered = toLower(c);
+      m_text.push_back(lowered);
+      m_bonus.push_back(bonus);
+      mask |= getCharMask(lowered);
+      previous = c;
+    }
+    m_masks.push_back(mask);
+    //the remembered candidates do not know about the new entry
+    m_hasCandidates = false;
+    return id;
+  }
+
+  void FuzzyMatcher::clear() {
+    m_text.clear();
+    m_bonus.clear();
+    m_offsets.clear();
+    m_lengths.clear();
+    m_masks.clear();
+    m_lastQuery.clear();
+    m_candidates.clear();
+    m_hasCandidates = false;
+  }
+
+  void FuzzyMatcher::reserve(size_t entries, size_t bytes) {
+    m_text.reserve(bytes);
+    m_bonus.reserve(bytes);
+    m_offsets.reserve(entries);
+    m_lengths.reserve(entries);
+    m_masks.reserve(entries);
+  }
+
+  void FuzzyMatcher::match(std::string_view query, size_t maxResults, std::vector<Match> &results) {
+    HB_PROFILE_SCOPE("FuzzyMatcher::match");
+    results.clear();
+    if (maxResults == 0)
+      return;
+
+    std::string lowered;
+    lowered.reserve(query.size());
+    uint64_t queryMask = 0;
+    for (const char c: query) {
+      lowered.push_back(toLower(c));
+      queryMask |= getCharMask(lowered.back());
+    }
+
+    if (lowered.empty()) {
+      for (uint32_t id = 0; id < m_masks.size() && results.size() < maxResults; id++) {
+        results.push_back({id, 0});
+      }
+      return;
+    }
+
+    //higher score first, shorter entry on a tie, ids keep the order stable
+    const auto better = [this](const Match &a, const Match &b) {
+      if (a.score != b.score)
+        return a.score > b.score;
+      if (m_lengths[a.id] != m_lengths[b.id])
+        return m_lengths[a.id] < m_lengths[b.id];
+      return a.id < b.id;
+    };
+
+    const bool narrow = m_hasCandidates && lowered.size() > m_lastQuery.size() && lowered.starts_with(m_lastQuery);
+    std::vector<uint32_t> candidates;
+    if (narrow)
+      candidates.reserve(m_candidates.size());
+
+    //bounded heap with the worst kept match in front
+    const auto visit = [&](uint32_t id) {
+      if ((m_masks[id] & queryMask) != queryMask || m_lengths[id] < lowered.size())
+        return;
+
+      Match match = {id, 0};
+      if (!score(id, lowered, match.score))
+        return;
+      candidates.push_back(id);
+
+      if (results.size() < maxResults) {
+        results.push_back(match);
+        std::push_heap(results.begin(), results.end(), better);
+      } else if (better(match, results.front())) {
+        std::pop_heap(results.begin(), results.end(), better);
+        results.back() = match;
+        std::push_heap(results.begin(), results.end(), better);
+      }
+    };
+    if (narrow) {
+      for (const uint32_t id: m_candidates) {
+        visit(id);
+      }
+    } else {
+      for (uint32_t id = 0; id < m_masks.size(); id++) {
+        visit(id);
+      }
+    }
+    m_lastQuery = std::move(lowered);
+    m_candidates = std::move(candidates);
+    m_hasCandidates = true;
+    std::sort_heap(results.begin(), results.end(), better);
+  }
+
+  uint64_t FuzzyMatcher::getCharMask(char lowered) {
+    const auto c = (unsigned char) lowered;
+    if (c >= 'a' && c <= 'z')
+      return 1ull << (c - 'a');
+    if (c >= '0' && c <= '9')
+      return 1ull << (26 + c - '0');
+    //punctuation and UTF-8 bytes share the remaining bits, a shared bit only lets more entries through to the scan
+    return 1ull << (36 + c % 28);
+  }
+
+  bool FuzzyMatcher::score(uint32_t id, std::string_view query, int32_t &score) const {
+    const char *text = m_text.data() + m_offsets[id];
+    const char *end = text + m_lengths[id];
+
+    //forward, the earliest position every query character can be matched at gives the end of the window
+    const char *it = text;
+    for (const char c: query) {
+      it = findByte(it, end, c);
+      if (it == end)
+        return false;
+      ++it;
+    }
+    const size_t last = (size_t) (it - text) - 1;
+
+    //backward from there, the latest start that still holds the whole query gives the tightest window
+    size_t first = last;
+    for (size_t queryIndex = query.size() - 1;; first--) {
+      if (text[first] == query[queryIndex]) {
+        if (queryIndex == 0)
+          break;
+        queryIndex--;
+      }
+    }
+
+    const int8_t *bonuses = m_bonus.data() + m_offsets[id];
+    score = 0;
+    size_t queryIndex = 0;
+    int32_t consecutive = 0;
+    int32_t firstBonus = 0;
+    bool inGap = false;
+    for (size_t index = first; index <= last; index++) {
+      if (queryIndex < query.size() && text[index] == query[queryIndex]) {
+        int32_t bonus = bonuses[index];
+        if (consecutive == 0) {
+          firstBonus = bonus;
+        } else {
+          //a run keeps the bonus of the word start it began on
+          if (bonus >= c_bonusBoundary && bonus > firstBonus)
+            firstBonus = bonus;
+          bonus = std::max({bonus, firstBonus, c_bonusConsecutive});
+        }
+        score += c_scoreMatch + (queryIndex == 0 ? bonus * c_bonusFirstMultiplier : bonus);
+        inGap = false;
+        consecutive++;
+        queryIndex++;
+      } else {
+        score += inGap ? c_scoreGapExtension : c_scoreGapStart;
+        inGap = true;
+        consecutive = 0;
+        firstBonus = 0;
+      }
+    }
+    return true;
+  }
+}// namespace HummingBirdCore::Commands
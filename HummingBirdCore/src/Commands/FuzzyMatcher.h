@@ -0,0 +1,73 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+namespace HummingBirdCore::Commands {
+  /**
+   * @brief Fuzzy subsequence matcher over an index that is prepared once and searched on every keystroke.
+   *
+   * add() lowercases every entry into one contiguous buffer, stores a per byte bonus for word starts and camel case
+   * humps and a 64 bit mask of the characters the entry contains. A search first rejects every entry whose mask
+   * misses a query character, which is a single AND over a flat array, then walks the query through the survivors
+   * with a 16 byte SIMD scan (SSE2 or NEON, scalar elsewhere) and scores the tightest window that contains the query.
+   * Scores follow fzf: matched characters, boundary bonuses and consecutive runs count up, gaps count down.
+   * ASCII is folded to lowercase, other bytes have to match exactly.
+   *
+   * Every entry that contained the previous query is remembered, a query that extends it (the user typed another
+   * character) only searches those again.
+   */
+  class FuzzyMatcher {
+public:
+    struct Match {
+      uint32_t id = 0;
+      int32_t score = 0;
+    };
+
+    /**
+     * @return The id of the entry, ids count up from 0 in the order they were added
+     */
+    uint32_t add(std::string_view text);
+    void clear();
+    void reserve(size_t entries, size_t bytes);
+
+    size_t size() const { return m_masks.size(); }
+
+    /**
+     * @brief Finds the best maxResults entries for the query, best first. An empty query matches every entry in order.
+     */
+    void match(std::string_view query, size_t maxResults, std::vector<Match> &results);
+
+private:
+    static uint64_t getCharMask(char lowered);
+    /**
+     * @return false when the entry does not contain the query as a subsequence
+     */
+    bool score(uint32_t id, std::string_view query, int32_t &score) const;
+
+private:
+    static constexpr int32_t c_scoreMatch = 16;
+    static constexpr int32_t c_scoreGapStart = -3;
+    static constexpr int32_t c_scoreGapExtension = -1;
+    static constexpr int32_t c_bonusBoundary = 8;
+    static constexpr int32_t c_bonusCamel = 7;
+    static constexpr int32_t c_bonusConsecutive = 4;
+    //the first query character counts its bonus this many times, typing the start of a word ranks highest
+    static constexpr int32_t c_bonusFirstMultiplier = 2;
+
+    //lowercased text of every entry, back to back
+    std::string m_text;
+    //bonus for matching the byte at the same offset in m_text
+    std::vector<int8_t> m_bonus;
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_lengths;
+    std::vector<uint64_t> m_masks;
+
+    //lowercased, m_candidates holds every entry that contains it
+    std::string m_lastQuery;
+    std::vector<uint32_t> m_candidates;
+    bool m_hasCandidates = false;
+  };
+}// namespace HummingBirdCore::Commands
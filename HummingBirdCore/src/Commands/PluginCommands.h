@@ -0,0 +1,34 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <IPlugin.h>
+#include "CommandRegistry.h"
+
+namespace HummingBirdCore::Commands {
+  /**
+   * @brief Hands the command registry to plugins, their commands are listed under the plugin's own category in the
+   * Plugins menu.
+   */
+  class PluginCommands : public HummingBird::Plugins::ICommandRegistry {
+public:
+    static PluginCommands &get() {
+      static PluginCommands s_instance;
+      return s_instance;
+    }
+
+    void addCommand(const char *category, const char *name, std::function<void()> action) override {
+      CommandRegistry::add(c_menu + category, name, std::move(action));
+    }
+
+    void removeCommand(const char *category, const char *name) override {
+      CommandRegistry::remove(c_menu + category, name);
+    }
+
+private:
+    inline static const std::string c_menu = "Plugins/";
+  };
+}// namespace HummingBirdCore::Commands
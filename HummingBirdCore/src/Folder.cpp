@@ -0,0 +1,72 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "Folder.h"
+
+#include "Memory/Cache.h"
+
+namespace HummingBirdCore {
+  namespace {
+    struct FolderListing {
+      std::filesystem::file_time_type modified;
+      std::vector<Folder> subDirectories = {};
+    };
+
+    Memory::Cache<std::string, FolderListing> &getFolderCache() {
+      static Memory::Cache<std::string, FolderListing> cache("folders", [](const FolderListing &listing) {
+        size_t size = listing.subDirectories.capacity() * sizeof(Folder);
+        for (const auto &folder: listing.subDirectories) {
+          size += folder.Path.native().capacity() + folder.Name.capacity();
+        }
+        return size;
+      });
+      return cache;
+    }
+  }// namespace
+
+  void Folder::setChildDirectories() {
+    SubDirectories.clear();
+    //the default folders do not exist on every machine (headless runs, other users)
+    std::error_code ec;
+    //adding or removing an entry bumps the modification time of the folder itself
+    const std::filesystem::file_time_type modified = std::filesystem::last_write_time(Path, ec);
+    if (ec) {
+      CORE_WARN("Unable to list " + Path.string() + ": " + ec.message());
+      return;
+    }
+
+    Memory::Cache<std::string, FolderListing>::Value listing = getFolderCache().getOrLoad(
+            Path.string(),
+            [this, modified]() -> std::optional<FolderListing> {
+              std::error_code ec;
+              std::filesystem::directory_iterator it(Path, ec);
+              if (ec) {
+                CORE_WARN("Unable to list " + Path.string() + ": " + ec.message());
+                return std::nullopt;
+              }
+
+              FolderListing listing{modified};
+              for (auto &p: it) {
+                try {
+                  if (std::filesystem::is_directory(p.symlink_status())) {
+                    if (std::filesystem::is_symlink(p.symlink_status())) {
+                      std::filesystem::path real_path = std::filesystem::read_symlink(p.path());
+                      if (real_path == Path) {
+                        continue;// Avoid adding if it points back to the parent directory
+                      }
+                    }
+                    listing.subDirectories.emplace_back(p.path(), p.path().filename().string());
+                  }
+                } catch (const std::filesystem::filesystem_error &e) {
+                  CORE_ERROR("Error: {0}", e.what());
+                }
+              }
+              return listing;
+            },
+            [modified](const FolderListing &listing) { return listing.modified == modified; });
+
+    if (listing != nullptr)
+      SubDirectories = listing->subDirectories;
+  }
+}// namespace HummingBirdCore
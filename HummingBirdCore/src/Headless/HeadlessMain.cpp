@@ -0,0 +1,99 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include <Headless/HeadlessRunner.h>
+#include <Log.h>
+#include <Profiling/Profiler.h>
+
+namespace {
+  void printUsage() {
+    std::cout << "Usage: HummingBirdHeadless [options]\n"
+                 "  --windows a,b,c   Windows to run (default: all)\n"
+                 "  --frames n        Timed frames per window (default: 600)\n"
+                 "  --warmup n        Untimed frames per window (default: 60)\n"
+                 "  --rows n          Rows in the generated DataViewer table (default: 10000)\n"
+                 "  --size wxh        Display size (default: 1280x800)\n"
+                 "  --input file      Input recording to replay\n"
+                 "  --out file        Write the results as json\n"
+                 "  --trace file      Write a Chrome trace of the timed frames\n"
+                 "  --trace-zones n   Zones every thread keeps for the trace (default: 4096)\n"
+                 "  --stats file      Write the stats registry as json, to diff against a baseline run\n"
+                 "  --present-ms n    Upload the draw data and wait n ms per frame like a vsynced backend\n"
+                 "Windows: ";
+    for (const auto &window: HummingBirdCore::Headless::HeadlessRunner::getAvailableWindows()) {
+      std::cout << window << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::vector<std::string> splitList(const std::string &list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      if (!item.empty())
+        items.push_back(item);
+    }
+    return items;
+  }
+}// namespace
+
+int main(int argc, char **argv) {
+  HummingBirdCore::Log::Init();
+
+  HummingBirdCore::Headless::HeadlessOptions options;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      printUsage();
+      return 1;
+    }
+
+    const std::string value = argv[++i];
+    try {
+      if (arg == "--windows") {
+        options.windows = splitList(value);
+      } else if (arg == "--frames") {
+        options.frames = std::stoi(value);
+      } else if (arg == "--warmup") {
+        options.warmupFrames = std::stoi(value);
+      } else if (arg == "--rows") {
+        options.dataViewerRows = std::stoi(value);
+      } else if (arg == "--size") {
+        const size_t x = value.find('x');
+        options.displaySize = ImVec2(std::stof(value.substr(0, x)), std::stof(value.substr(x + 1)));
+      } else if (arg == "--input") {
+        options.inputPath = value;
+      } else if (arg == "--out") {
+        options.outputPath = value;
+      } else if (arg == "--trace") {
+        options.tracePath = value;
+      } else if (arg == "--trace-zones") {
+        const int zones = std::stoi(value);
+        if (zones <= 0)
+          throw std::out_of_range(value);
+        HummingBirdCore::Profiling::Profiler::setRingCapacity((uint64_t) zones);
+      } else if (arg == "--stats") {
+        options.statsPath = value;
+      } else if (arg == "--present-ms") {
+        options.presentMs = std::stod(value);
+      } else {
+        std::cerr << "Unknown option " << arg << std::endl;
+        printUsage();
+        return 1;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+      return 1;
+    }
+  }
+
+  HummingBirdCore::Headless::HeadlessRunner runner(options);
+  return runner.run();
+}
@@ -0,0 +1,246 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "HeadlessRunner.h"
+
+#include <Memory/AllocationCounter.h>
+#include <Memory/FrameArena.h>
+#include <Memory/ImGuiAllocator.h>
+#include <Metrics/StatsRegistry.h>
+#include <Profiling/Profiler.h>
+#include <System/Hosts/EditHostsWindow.h>
+#include <System/LaunchDaemonsManager.h>
+#include <Terminal/TerminalWindow.h>
+#include <Threading/FrameScheduler.h>
+#include <Threading/MainThreadQueue.h>
+#include <Utils/Input.h>
+#include <UIWindows/ContentExplorer.h>
+#include <UIWindows/Widget/DataViewer.h>
+
+namespace HummingBirdCore::Headless {
+  namespace {
+    constexpr float c_deltaTime = 1.0f / 60.0f;
+
+    double percentile(const std::vector<double> &sorted, double p) {
+      if (sorted.empty())
+        return 0.0;
+      const double rank = p * (double) (sorted.size() - 1);
+      const size_t lower = (size_t) rank;
+      const size_t upper = std::min(lower + 1, sorted.size() - 1);
+      return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - (double) lower);
+    }
+
+    void fillTable(Widgets::Table &table, int rows) {
+      table.name = "Headless";
+      table.headers = {{"id"}, {"name"}, {"path"}, {"size"}, {"modified"}};
+      table.rows.reserve(rows);
+      for (int i = 0; i < rows; i++) {
+        Widgets::Row &row = table.rows.emplace_back(i);
+        row["id"] = std::to_string(i);
+        row["name"] = "item_" + std::to_string(i);
+        row["path"] = "/opt/homebrew/Cellar/item_" + std::to_string(i % 97) + "/bin";
+        row["size"] = std::to_string((i * 7919) % 1048576);
+        row["modified"] = "2026-10-" + std::to_string(1 + i % 28);
+      }
+      table.isInitialized = true;
+    }
+  }// namespace
+
+  void WindowTimings::calculate() {
+    if (frameMs.empty())
+      return;
+
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    p50 = percentile(sorted, 0.50);
+    p99 = percentile(sorted, 0.99);
+    max = sorted.back();
+    mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / (double) sorted.size();
+    allocationsPerFrame = (double) allocations / (double) frameMs.size();
+  }
+
+  HeadlessRunner::HeadlessRunner(const HeadlessOptions &options) : m_options(options) {
+    Memory::ImGuiAllocator::install();
+    m_context = ImGui::CreateContext();
+    ImGui::SetCurrentContext(m_context);
+
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.DisplaySize = m_options.displaySize;
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+    io.DeltaTime = c_deltaTime;
+
+    //no renderer, the atlas only has to exist so NewFrame() does not assert
+    unsigned char *pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->AddFontDefault();
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID) 1);
+
+    if (!m_options.inputPath.empty())
+      m_input.load(m_options.inputPath);
+  }
+
+  HeadlessRunner::~HeadlessRunner() {
+    if (m_context != nullptr)
+      ImGui::DestroyContext(m_context);
+  }
+
+  std::vector<std::string> HeadlessRunner::getAvailableWindows() {
+    return {"Terminal", "DataViewer", "ContentExplorer", "EditHosts", "LaunchDaemons"};
+  }
+
+  int HeadlessRunner::run() {
+    Profiling::Profiler::setThreadName("Headless");
+
+    bool success = true;
+    for (const auto &name: m_options.windows) {
+      WindowTimings timings;
+      timings.name = name;
+      if (!runWindow(name, timings)) {
+        success = false;
+        continue;
+      }
+      timings.calculate();
+      m_results.push_back(std::move(timings));
+    }
+
+    printReport();
+    if (!m_options.outputPath.empty() && !writeReport(m_options.outputPath))
+      success = false;
+    if (!m_options.tracePath.empty())
+      Profiling::Profiler::dumpChromeTrace(m_options.tracePath);
+    if (!m_options.statsPath.empty() && !Metrics::StatsRegistry::exportJson(m_options.statsPath))
+      success = false;
+
+    return success ? 0 : 1;
+  }
+
+  std::shared_ptr<UIWindow> HeadlessRunner::createWindow(const std::string &name) {
+    if (name == "Terminal")
+      return std::make_shared<Terminal::TerminalWindow>(name);
+    if (name == "ContentExplorer")
+      return std::make_shared<UIWindows::ContentExplorer>(name);
+    if (name == "EditHosts")
+      return std::make_shared<System::EditHostsWindow>(name);
+    if (name == "LaunchDaemons")
+      return std::make_shared<System::LaunchDaemonsManager>(name);
+    if (name == "DataViewer") {
+      auto dataViewer = std::make_shared<Widgets::DataViewer>(name);
+      dataViewer->buildTable([this](Widgets::Table &table) { fillTable(table, m_options.dataViewerRows); });
+      return dataViewer;
+    }
+    return nullptr;
+  }
+
+  bool HeadlessRunner::runWindow(const std::string &name, WindowTimings &timings) {
+    std::shared_ptr<UIWindow> window = createWindow(name);
+    if (window == nullptr) {
+      CORE_ERROR("Unknown headless window: " + name);
+      return false;
+    }
+    window->initialize();
+
+    CORE_INFO("Running {0}: {1} warm-up frames, {2} timed frames", name, m_options.warmupFrames, m_options.frames);
+    for (int i = 0; i < m_options.warmupFrames; i++) {
+      renderFrame(*window, name, i);
+    }
+
+    timings.frameMs.reserve(m_options.frames);
+    Metrics::Histogram &frameTime = Metrics::StatsRegistry::histogram("headless." + name + ".frame_time");
+    for (int i = 0; i < m_options.frames; i++) {
+      Profiling::Profiler::beginFrame();
+      Memory::AllocationCounter::beginFrame();
+      const int64_t start = Profiling::Profiler::nowNs();
+      renderFrame(*window, name, m_options.warmupFrames + i);
+      const int64_t end = Profiling::Profiler::nowNs();
+      Memory::AllocationCounter::endFrame();
+      Profiling::Profiler::endFrame();
+
+      timings.allocations += Memory::AllocationCounter::getLastFrameAllocations();
+      timings.frameMs.push_back((double) (end - start) / 1e6);
+      frameTime.record((uint64_t) (end - start) / 1000);
+    }
+
+    window->cleanUpOnClose();
+    return true;
+  }
+
+  void HeadlessRunner::renderFrame(UIWindow &window, const std::string &name, int frame) {
+    HB_PROFILE_SCOPE("HeadlessRunner::renderFrame");
+    ImGuiIO &io = ImGui::GetIO();
+    io.DeltaTime = c_deltaTime;
+    m_input.replay(frame, io);
+    Threading::FrameScheduler::beginFrame();
+    Input::beginFrame();
+    Threading::MainThreadQueue::drain();
+
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    if (ImGui::Begin(name.c_str(), nullptr, ImGuiWindowFlags_NoSavedSettings)) {
+      window.render();
+    }
+    ImGui::End();
+    Threading::FrameScheduler::run();
+    ImGui::Render();
+    if (isSubmitting())
+      submitFrame(*ImGui::GetDrawData());
+    Input::endFrame();
+    Memory::FrameArena::get().reset();
+  }
+
+  void HeadlessRunner::submitFrame(ImDrawData &drawData) {
+    HB_PROFILE_SCOPE("HeadlessRunner::submitFrame");
+    m_stagingVertices.resize((size_t) drawData.TotalVtxCount);
+    m_stagingIndices.resize((size_t) drawData.TotalIdxCount);
+    size_t vertexOffset = 0;
+    size_t indexOffset = 0;
+    for (int i = 0; i < drawData.CmdListsCount; i++) {
+      const ImDrawList *list = drawData.CmdLists[i];
+      std::memcpy(m_stagingVertices.data() + vertexOffset, list->VtxBuffer.Data, (size_t) list->VtxBuffer.size_in_bytes());
+      std::memcpy(m_stagingIndices.data() + indexOffset, list->IdxBuffer.Data, (size_t) list->IdxBuffer.size_in_bytes());
+      vertexOffset += (size_t) list->VtxBuffer.Size;
+      indexOffset += (size_t) list->IdxBuffer.Size;
+    }
+
+    if (m_options.presentMs > 0.0)
+      std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(m_options.presentMs));
+  }
+
+  void HeadlessRunner::printReport() const {
+    std::cout << fmt::format("{:<18}{:>10}{:>12}{:>12}{:>12}{:>12}{:>14}\n", "Window", "Frames", "p50 (ms)", "p99 (ms)", "Mean (ms)", "Max (ms)",
+                             "Allocs/frame");
+    for (const auto &result: m_results) {
+      std::cout << fmt::format("{:<18}{:>10}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.3f}{:>14.1f}\n", result.name, result.frameMs.size(), result.p50,
+                               result.p99, result.mean, result.max, result.allocationsPerFrame);
+    }
+    if (!Memory::AllocationCounter::isEnabled())
+      std::cout << "Allocation counts need a build with HUMMINGBIRD_COUNT_ALLOCATIONS" << std::endl;
+  }
+
+  bool HeadlessRunner::writeReport(const std::filesystem::path &path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      CORE_ERROR("Unable to write headless report: " + path.string());
+      return false;
+    }
+
+    out << "{\"frames\":" << m_options.frames << ",\"warmupFrames\":" << m_options.warmupFrames
+        << ",\"input\":\"" << m_options.inputPath.string() << "\",\"presentMs\":" << m_options.presentMs << ",\"windows\":[";
+    for (size_t i = 0; i < m_results.size(); i++) {
+      const WindowTimings &result = m_results[i];
+      if (i > 0)
+        out << ",";
+      out << fmt::format("{{\"name\":\"{}\",\"p50\":{:.4f},\"p99\":{:.4f},\"mean\":{:.4f},\"max\":{:.4f},\"allocationsPerFrame\":{:.2f}}}",
+                         result.name, result.p50, result.p99, result.mean, result.max, result.allocationsPerFrame);
+    }
+    out << "]}\n";
+
+    CORE_INFO("Wrote headless report to " + path.string());
+    return true;
+  }
+}// namespace HummingBirdCore::Headless
@@ -0,0 +1,83 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "InputRecording.h"
+
+#include <HBUI/UIWindow.h>
+
+namespace HummingBirdCore::Headless {
+  struct HeadlessOptions {
+    std::vector<std::string> windows = {"Terminal", "DataViewer", "ContentExplorer", "EditHosts", "LaunchDaemons"};
+    int frames = 600;
+    int warmupFrames = 60;
+    int dataViewerRows = 10000;
+    ImVec2 displaySize = ImVec2(1280.0f, 800.0f);
+    std::filesystem::path inputPath = {};
+    std::filesystem::path outputPath = {};
+    std::filesystem::path tracePath = {};
+    std::filesystem::path statsPath = {};
+    //stand-in for the backend: upload the draw data and wait presentMs for vsync, off unless it is set
+    double presentMs = 0.0;
+  };
+
+  struct WindowTimings {
+    std::string name;
+    std::vector<double> frameMs = {};
+
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+    //main thread heap allocations per timed frame, 0 when built without HUMMINGBIRD_COUNT_ALLOCATIONS
+    double allocationsPerFrame = 0.0;
+    uint64_t allocations = 0;
+
+    void calculate();
+  };
+
+  /**
+   * @brief Drives the ImGui frame loop without HBUI, a window or a GPU backend.
+   *
+   * Every scripted window gets its own run of warm-up and timed frames. A frame is NewFrame() up to and
+   * including Render(), so the timings are the CPU cost of building the draw lists.
+   *
+   * With --present-ms the frame also copies the draw data into a staging buffer, like a backend uploading it, and
+   * sleeps to stand in for the vsync wait.
+   */
+  class HeadlessRunner {
+public:
+    explicit HeadlessRunner(const HeadlessOptions &options);
+    ~HeadlessRunner();
+
+    /**
+     * @brief Runs every scripted window and prints the report.
+     * @return Process exit code, 0 when every window ran
+     */
+    int run();
+
+    static std::vector<std::string> getAvailableWindows();
+
+private:
+    std::shared_ptr<UIWindow> createWindow(const std::string &name);
+    bool runWindow(const std::string &name, WindowTimings &timings);
+    void renderFrame(UIWindow &window, const std::string &name, int frame);
+    void submitFrame(ImDrawData &drawData);
+    bool isSubmitting() const { return m_options.presentMs > 0.0; }
+
+    void printReport() const;
+    bool writeReport(const std::filesystem::path &path) const;
+
+private:
+    HeadlessOptions m_options;
+    InputRecording m_input = {};
+    ImGuiContext *m_context = nullptr;
+    std::vector<WindowTimings> m_results = {};
+
+    std::vector<ImDrawVert> m_stagingVertices = {};
+    std::vector<ImDrawIdx> m_stagingIndices = {};
+  };
+}// namespace HummingBirdCore::Headless
@@ -0,0 +1,230 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "InputRecording.h"
+
+#include "Utils/Input.h"
+
+#include <charconv>
+#include <cwctype>
+
+namespace HummingBirdCore::Headless {
+  namespace {
+    struct KeyName {
+      ImGuiKey key;
+      const char *name;
+    };
+
+    const KeyName c_keyNames[] = {
+            {ImGuiKey_Enter, "Enter"},
+            {ImGuiKey_Backspace, "Backspace"},
+            {ImGuiKey_Tab, "Tab"},
+            {ImGuiKey_Escape, "Escape"},
+            {ImGuiKey_Space, "Space"},
+            {ImGuiKey_UpArrow, "Up"},
+            {ImGuiKey_DownArrow, "Down"},
+            {ImGuiKey_LeftArrow, "Left"},
+            {ImGuiKey_RightArrow, "Right"},
+            {ImGuiKey_LeftCtrl, "LeftCtrl"},
+            {ImGuiKey_LeftShift, "LeftShift"},
+            {ImGuiKey_LeftAlt, "LeftAlt"},
+            {ImGuiKey_LeftSuper, "LeftSuper"},
+    };
+
+    /**
+     * @brief The code point of a character written as UTF-8 or as U+hex, 0 when token is not exactly one character.
+     */
+    unsigned int parseCharacter(const std::string &token) {
+      if (token == "space")
+        return ' ';
+      if (token.size() > 2 && token.starts_with("U+")) {
+        unsigned int character = 0;
+        const auto [end, ec] = std::from_chars(token.data() + 2, token.data() + token.size(), character, 16);
+        return ec == std::errc() && end == token.data() + token.size() && character <= 0x10FFFF ? character : 0;
+      }
+
+      const auto *bytes = (const unsigned char *) token.data();
+      size_t length = 0;
+      unsigned int character = 0;
+      if (bytes[0] < 0x80) {
+        length = 1;
+        character = bytes[0];
+      } else if ((bytes[0] & 0xE0) == 0xC0) {
+        length = 2;
+        character = bytes[0] & 0x1F;
+      } else if ((bytes[0] & 0xF0) == 0xE0) {
+        length = 3;
+        character = bytes[0] & 0x0F;
+      } else if ((bytes[0] & 0xF8) == 0xF0) {
+        length = 4;
+        character = bytes[0] & 0x07;
+      }
+      if (length == 0 || token.size() != length)
+        return 0;
+      for (size_t i = 1; i < length; i++) {
+        if ((bytes[i] & 0xC0) != 0x80)
+          return 0;
+        character = (character << 6) | (bytes[i] & 0x3F);
+      }
+      return character <= 0x10FFFF ? character : 0;
+    }
+  }// namespace
+
+  bool InputRecording::load(const std::filesystem::path &path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+      CORE_ERROR("Unable to open input recording: " + path.string());
+      return false;
+    }
+
+    m_events.clear();
+    m_frameCount = 0;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+      lineNumber++;
+      if (line.empty() || line[0] == '#')
+        continue;
+
+      std::stringstream ss(line);
+      InputEvent event;
+      std::string type;
+      if (!(ss >> event.frame >> type)) {
+        CORE_WARN("Skipping malformed input event on line {0}", lineNumber);
+        continue;
+      }
+
+      bool valid = true;
+      if (type == "mouse_pos") {
+        event.type = InputEventMousePos;
+        valid = (bool) (ss >> event.x >> event.y);
+      } else if (type == "mouse_button") {
+        event.type = InputEventMouseButton;
+        valid = (bool) (ss >> event.button >> event.down);
+      } else if (type == "mouse_wheel") {
+        event.type = InputEventMouseWheel;
+        valid = (bool) (ss >> event.x >> event.y);
+      } else if (type == "key") {
+        std::string keyName;
+        event.type = InputEventKey;
+        valid = (bool) (ss >> keyName >> event.down);
+        event.key = keyFromName(keyName);
+        valid = valid && event.key != ImGuiKey_None;
+      } else if (type == "char") {
+        std::string character;
+        event.type = InputEventChar;
+        valid = (bool) (ss >> character);
+        event.character = valid ? parseCharacter(character) : 0;
+        valid = valid && event.character != 0;
+      } else {
+        valid = false;
+      }
+
+      if (!valid) {
+        CORE_WARN("Skipping unknown input event on line {0}: {1}", lineNumber, line);
+        continue;
+      }
+      add(event);
+    }
+
+    CORE_INFO("Loaded {0} input events over {1} frames from {2}", m_events.size(), m_frameCount, path.string());
+    return true;
+  }
+
+  bool InputRecording::save(const std::filesystem::path &path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+      CORE_ERROR("Unable to write input recording: " + path.string());
+      return false;
+    }
+
+    file << "# frame type arguments\n";
+    for (const auto &event: m_events) {
+      file << event.frame << " ";
+      switch (event.type) {
+        case InputEventMousePos:
+          file << "mouse_pos " << event.x << " " << event.y;
+          break;
+        case InputEventMouseButton:
+          file << "mouse_button " << event.button << " " << event.down;
+          break;
+        case InputEventMouseWheel:
+          file << "mouse_wheel " << event.x << " " << event.y;
+          break;
+        case InputEventKey:
+          file << "key " << nameFromKey(event.key) << " " << event.down;
+          break;
+        case InputEventChar:
+          if (event.character == ' ') {
+            file << "char space";
+          } else if (event.character < 0x20 || event.character == 0x7F || std::iswspace((wint_t) event.character)) {
+            //would not survive the whitespace split on load
+            file << fmt::format("char U+{0:04X}", event.character);
+          } else {
+            std::string character;
+            Input::appendUtf8(character, event.character);
+            file << "char " << character;
+          }
+          break;
+      }
+      file << "\n";
+    }
+    return true;
+  }
+
+  void InputRecording::add(const InputEvent &event) {
+    m_events.push_back(event);
+    m_frameCount = std::max(m_frameCount, event.frame + 1);
+  }
+
+  void InputRecording::replay(int frame, ImGuiIO &io) const {
+    if (m_frameCount == 0)
+      return;
+
+    const int recordingFrame = frame % m_frameCount;
+    for (const auto &event: m_events) {
+      if (event.frame != recordingFrame)
+        continue;
+
+      switch (event.type) {
+        case InputEventMousePos:
+          io.AddMousePosEvent(event.x, event.y);
+          break;
+        case InputEventMouseButton:
+          io.AddMouseButtonEvent(event.button, event.down);
+          Input::addMouseButton(event.button, event.down);
+          break;
+        case InputEventMouseWheel:
+          io.AddMouseWheelEvent(event.x, event.y);
+          Input::addScroll(event.x, event.y);
+          break;
+        case InputEventKey:
+          io.AddKeyEvent(event.key, event.down);
+          Input::addKey(event.key, event.down);
+          break;
+        case InputEventChar:
+          io.AddInputCharacter(event.character);
+          Input::addCharacter(event.character);
+          break;
+      }
+    }
+  }
+
+  ImGuiKey InputRecording::keyFromName(const std::string &name) {
+    for (const auto &keyName: c_keyNames) {
+      if (name == keyName.name)
+        return keyName.key;
+    }
+    return ImGuiKey_None;
+  }
+
+  const char *InputRecording::nameFromKey(ImGuiKey key) {
+    for (const auto &keyName: c_keyNames) {
+      if (key == keyName.key)
+        return keyName.name;
+    }
+    return "None";
+  }
+}// namespace HummingBirdCore::Headless
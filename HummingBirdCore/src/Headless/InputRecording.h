@@ -0,0 +1,70 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <imgui.h>
+
+namespace HummingBirdCore::Headless {
+  enum InputEventType {
+    InputEventMousePos,
+    InputEventMouseButton,
+    InputEventMouseWheel,
+    InputEventKey,
+    InputEventChar
+  };
+
+  struct InputEvent {
+    int frame = 0;
+    InputEventType type = InputEventMousePos;
+    float x = 0.0f;
+    float y = 0.0f;
+    int button = 0;
+    bool down = false;
+    ImGuiKey key = ImGuiKey_None;
+    //a full code point, not a byte
+    unsigned int character = 0;
+  };
+
+  /**
+   * @brief Input events recorded per frame, replayed into ImGuiIO by the headless runner.
+   *
+   * Text format, one event per line, frames are relative to the start of the recording:
+   * @code
+   * # frame type arguments
+   * 0 mouse_pos 400 300
+   * 1 mouse_button 0 1
+   * 2 mouse_wheel 0 -1
+   * 3 char a
+   * 3 char é
+   * 3 char U+00E9
+   * 4 key Enter 1
+   * @endcode
+   * A char is one UTF-8 encoded character, space, or U+ and the hex code point.
+   */
+  class InputRecording {
+public:
+    bool load(const std::filesystem::path &path);
+    bool save(const std::filesystem::path &path) const;
+
+    void add(const InputEvent &event);
+
+    /**
+     * @brief Feeds every event of the given frame to ImGui and Input, the recording loops when the frame is past the end.
+     */
+    void replay(int frame, ImGuiIO &io) const;
+
+    bool empty() const { return m_events.empty(); }
+    int getFrameCount() const { return m_frameCount; }
+
+private:
+    static ImGuiKey keyFromName(const std::string &name);
+    static const char *nameFromKey(ImGuiKey key);
+
+private:
+    std::vector<InputEvent> m_events = {};
+    int m_frameCount = 0;
+  };
+}// namespace HummingBirdCore::Headless
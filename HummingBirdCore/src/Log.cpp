@@ -11,7 +11,28 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include "Metrics/StatsRegistry.h"
+
 namespace HummingBirdCore {
+  namespace {
+    /**
+     * @brief Counts what goes through the logger for the stats registry, formats nothing.
+     */
+    class StatsSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+  protected:
+      void sink_it_(const spdlog::details::log_msg &msg) override {
+        m_messages.add();
+        m_bytes.add((int64_t) msg.payload.size());
+      }
+
+      void flush_() override {}
+
+  private:
+      Metrics::Counter &m_messages = Metrics::StatsRegistry::counter("log.messages");
+      Metrics::Counter &m_bytes = Metrics::StatsRegistry::counter("log.bytes");
+    };
+  }// namespace
+
   std::shared_ptr<spdlog::logger> Log::s_coreLogger = nullptr;
 
   void Log::Init() {
@@ -26,6 +47,8 @@ namespace HummingBirdCore {
     fileSink->set_pattern("[source %s] [function %!] [line %#] %v");
     s_logSinks.emplace_back(fileSink);
 
+    s_logSinks.emplace_back(std::make_shared<StatsSink>());
+
     s_coreLogger = std::make_shared<spdlog::logger>("HummingBirdCore", begin(s_logSinks), end(s_logSinks));
     s_coreLogger->set_level(spdlog::level::trace);
 
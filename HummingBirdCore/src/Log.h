@@ -19,7 +19,7 @@ public:
 
     template<typename... Args>
     inline static void log(spdlog::source_loc loc, spdlog::level::level_enum lvl, spdlog::format_string_t<Args...> fmt, Args &&...args) {
-      log(loc, lvl, fmt, std::forward<Args>(args)...);
+      getCoreLogger()->log(loc, lvl, fmt, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
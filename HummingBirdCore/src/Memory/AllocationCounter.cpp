@@ -0,0 +1,94 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <new>
+
+namespace HummingBirdCore::Memory {
+  namespace {
+    std::atomic<uint64_t> s_totalAllocations = 0;
+    std::atomic<uint64_t> s_totalBytes = 0;
+    thread_local uint64_t s_threadAllocations = 0;
+  }// namespace
+
+#ifdef HUMMINGBIRD_COUNT_ALLOCATIONS
+  namespace Detail {
+    inline void countAllocation(size_t size) {
+      s_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+      s_totalBytes.fetch_add(size, std::memory_order_relaxed);
+      s_threadAllocations++;
+    }
+
+    void *allocate(size_t size) {
+      countAllocation(size);
+      if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+      throw std::bad_alloc();
+    }
+
+    void *allocateAligned(size_t size, std::align_val_t alignment) {
+      countAllocation(size);
+      void *ptr = nullptr;
+      if (posix_memalign(&ptr, std::max(sizeof(void *), static_cast<size_t>(alignment)), size == 0 ? 1 : size) != 0)
+        throw std::bad_alloc();
+      return ptr;
+    }
+  }// namespace Detail
+#endif
+
+  bool AllocationCounter::isEnabled() {
+#ifdef HUMMINGBIRD_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  uint64_t AllocationCounter::getTotalAllocations() { return s_totalAllocations.load(std::memory_order_relaxed); }
+  uint64_t AllocationCounter::getTotalBytes() { return s_totalBytes.load(std::memory_order_relaxed); }
+  uint64_t AllocationCounter::getThreadAllocations() { return s_threadAllocations; }
+
+  void AllocationCounter::beginFrame() {
+    s_frameStartAllocations = s_threadAllocations;
+  }
+
+  void AllocationCounter::endFrame() {
+    s_lastFrameAllocations = s_threadAllocations - s_frameStartAllocations;
+  }
+}// namespace HummingBirdCore::Memory
+
+#ifdef HUMMINGBIRD_COUNT_ALLOCATIONS
+void *operator new(size_t size) { return HummingBirdCore::Memory::Detail::allocate(size); }
+void *operator new[](size_t size) { return HummingBirdCore::Memory::Detail::allocate(size); }
+void *operator new(size_t size, std::align_val_t alignment) { return HummingBirdCore::Memory::Detail::allocateAligned(size, alignment); }
+void *operator new[](size_t size, std::align_val_t alignment) { return HummingBirdCore::Memory::Detail::allocateAligned(size, alignment); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return HummingBirdCore::Memory::Detail::allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  try {
+    return HummingBirdCore::Memory::Detail::allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+#endif
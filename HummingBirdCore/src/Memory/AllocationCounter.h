@@ -0,0 +1,37 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+namespace HummingBirdCore::Memory {
+  /**
+   * @brief Counts global operator new calls, only when built with HUMMINGBIRD_COUNT_ALLOCATIONS.
+   *
+   * The frame loop calls beginFrame()/endFrame() to get the number of allocations the main thread did in a frame,
+   * a steady state frame should report zero.
+   */
+  class AllocationCounter {
+public:
+    static bool isEnabled();
+
+    static uint64_t getTotalAllocations();
+    static uint64_t getTotalBytes();
+
+    /**
+     * @brief Allocations done by the calling thread.
+     */
+    static uint64_t getThreadAllocations();
+
+    static void beginFrame();
+    static void endFrame();
+
+    static uint64_t getLastFrameAllocations() { return s_lastFrameAllocations; }
+
+private:
+    //main thread only
+    inline static uint64_t s_frameStartAllocations = 0;
+    inline static uint64_t s_lastFrameAllocations = 0;
+  };
+}// namespace HummingBirdCore::Memory
@@ -0,0 +1,285 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "CacheBudget.h"
+
+#include "Metrics/StatsRegistry.h"
+#include "Threading/ThreadPool.h"
+
+#include <future>
+#include <list>
+
+namespace HummingBirdCore::Memory {
+  /**
+   * @brief Thread-safe LRU cache that charges the shared CacheBudget for what it holds.
+   *
+   * Values are handed out as shared_ptr<const V>, an evicted value stays alive for whoever still holds it but no
+   * longer counts against the budget. Pinned entries are never evicted. When several threads miss on the same key
+   * only the first one runs the loader, the others wait for its result.
+   *
+   * Hits, misses, coalesced misses and evictions are counted in the stats registry as "cache.<name>.*".
+   */
+  template<typename K, typename V, typename Hash = std::hash<K>>
+  class Cache : public ICache {
+public:
+    using Value = std::shared_ptr<const V>;
+    using SizeFunction = std::function<size_t(const V &)>;
+    //nullopt when there is nothing to cache, the miss is not remembered
+    using Loader = std::function<std::optional<V>()>;
+    //false when the cached value is out of date, it is loaded again
+    using Validator = std::function<bool(const V &)>;
+
+    Cache(std::string name, SizeFunction sizeOf) : m_name(std::move(name)),
+                                                    m_sizeOf(std::move(sizeOf)),
+                                                    m_hits(Metrics::StatsRegistry::counter("cache." + m_name + ".hits")),
+                                                    m_misses(Metrics::StatsRegistry::counter("cache." + m_name + ".misses")),
+                                                    m_coalesced(Metrics::StatsRegistry::counter("cache." + m_name + ".coalesced")),
+                                                    m_evictions(Metrics::StatsRegistry::counter("cache." + m_name + ".evictions")),
+                                                    m_bytesGauge(Metrics::StatsRegistry::gauge("cache." + m_name + ".bytes")) {
+      CacheBudget::registerCache(this);
+    }
+
+    ~Cache() override {
+      CacheBudget::unregisterCache(this);
+      clear();
+    }
+
+    Cache(const Cache &) = delete;
+    Cache &operator=(const Cache &) = delete;
+
+    /**
+     * @return The cached value or nullptr, counts as a hit or a miss
+     */
+    Value find(const K &key) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_entries.find(key);
+      if (it == m_entries.end()) {
+        m_misses.add();
+        return nullptr;
+      }
+      m_hits.add();
+      touchLocked(it->second);
+      return it->second->value;
+    }
+
+    Value insert(const K &key, V value) {
+      Value result;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        result = storeLocked(key, std::make_shared<const V>(std::move(value)));
+      }
+      CacheBudget::enforce();
+      return result;
+    }
+
+    /**
+     * @brief Returns the cached value or runs loader on the calling thread to fill it.
+     * A concurrent miss on the same key waits for the running load instead of loading twice, a loader that throws
+     * rethrows in every waiting thread.
+     * @return nullptr when loader had nothing to cache
+     */
+    Value getOrLoad(const K &key, const Loader &loader, const Validator &isValid = nullptr) {
+      std::shared_ptr<std::promise<Value>> promise;
+      std::shared_future<Value> pending;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+          if (isValid == nullptr || isValid(*it->second->value)) {
+            m_hits.add();
+            touchLocked(it->second);
+            return it->second->value;
+          }
+          removeLocked(it);
+        }
+
+        m_misses.add();
+        auto loading = m_loading.find(key);
+        if (loading != m_loading.end()) {
+          m_coalesced.add();
+          pending = loading->second;
+        } else {
+          promise = std::make_shared<std::promise<Value>>();
+          m_loading.emplace(key, promise->get_future().share());
+        }
+      }
+      if (promise == nullptr)
+        return pending.get();
+
+      Value value = nullptr;
+      try {
+        std::optional<V> loaded = loader();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (loaded.has_value())
+          value = storeLocked(key, std::make_shared<const V>(std::move(*loaded)));
+        m_loading.erase(key);
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_loading.erase(key);
+        }
+        promise->set_exception(std::current_exception());
+        throw;
+      }
+      promise->set_value(value);
+      CacheBudget::enforce();
+      return value;
+    }
+
+    /**
+     * @brief getOrLoad() on the thread pool, the cache has to outlive the task.
+     */
+    Threading::TaskHandle<Value> getOrLoadAsync(K key, Loader loader, Validator isValid = nullptr) {
+      return Threading::ThreadPool::get().submit([this, key = std::move(key), loader = std::move(loader), isValid = std::move(isValid)] {
+        return getOrLoad(key, loader, isValid);
+      });
+    }
+
+    /**
+     * @brief Keeps the entry from being evicted until a matching unpin(), pins nest.
+     * @return false when the key is not cached
+     */
+    bool pin(const K &key) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_entries.find(key);
+      if (it == m_entries.end())
+        return false;
+      if (it->second->pins++ == 0) {
+        m_pinned.splice(m_pinned.begin(), m_lru, it->second);
+        m_pinnedCount++;
+      }
+      return true;
+    }
+
+    void unpin(const K &key) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_entries.find(key);
+      if (it == m_entries.end() || it->second->pins == 0)
+        return;
+      if (--it->second->pins == 0) {
+        m_lru.splice(m_lru.begin(), m_pinned, it->second);
+        it->second->lastUse = CacheBudget::nextUse();
+        m_pinnedCount--;
+      }
+    }
+
+    void erase(const K &key) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_entries.find(key);
+      if (it != m_entries.end())
+        removeLocked(it);
+    }
+
+    //ICache
+    const std::string &getName() const override { return m_name; }
+
+    CacheStats getStats() const override {
+      CacheStats stats;
+      stats.hits = (uint64_t) m_hits.get();
+      stats.misses = (uint64_t) m_misses.get();
+      stats.coalesced = (uint64_t) m_coalesced.get();
+      stats.evictions = (uint64_t) m_evictions.get();
+      std::lock_guard<std::mutex> lock(m_mutex);
+      stats.bytes = m_bytes;
+      stats.entries = m_entries.size();
+      stats.pinned = m_pinnedCount;
+      return stats;
+    }
+
+    uint64_t getOldestUse() const override {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_lru.empty() ? c_nothingToEvict : m_lru.back().lastUse;
+    }
+
+    size_t evictOldest() override {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_lru.empty())
+        return 0;
+      const size_t bytes = m_lru.back().bytes;
+      removeLocked(m_entries.find(m_lru.back().key));
+      m_evictions.add();
+      return bytes;
+    }
+
+    void clear() override {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      CacheBudget::release(m_bytes);
+      m_bytes = 0;
+      m_pinnedCount = 0;
+      m_entries.clear();
+      m_lru.clear();
+      m_pinned.clear();
+      m_bytesGauge.set(0.0);
+    }
+
+private:
+    struct Entry {
+      K key;
+      Value value;
+      size_t bytes = 0;
+      uint64_t lastUse = 0;
+      int pins = 0;
+    };
+    using EntryList = std::list<Entry>;
+
+    void touchLocked(typename EntryList::iterator entry) {
+      entry->lastUse = CacheBudget::nextUse();
+      if (entry->pins == 0)
+        m_lru.splice(m_lru.begin(), m_lru, entry);
+    }
+
+    Value storeLocked(const K &key, Value value) {
+      auto existing = m_entries.find(key);
+      if (existing != m_entries.end())
+        removeLocked(existing);
+
+      //the list node, the map node and the key are not free either
+      const size_t bytes = m_sizeOf(*value) + sizeof(Entry) + sizeof(K) + c_entryOverhead;
+      m_lru.push_front(Entry{key, value, bytes, CacheBudget::nextUse(), 0});
+      m_entries.emplace(key, m_lru.begin());
+      m_bytes += bytes;
+      CacheBudget::charge(bytes);
+      m_bytesGauge.set((double) m_bytes);
+      return value;
+    }
+
+    void removeLocked(typename std::unordered_map<K, typename EntryList::iterator, Hash>::iterator it) {
+      auto entry = it->second;
+      m_bytes -= entry->bytes;
+      CacheBudget::release(entry->bytes);
+      if (entry->pins > 0) {
+        m_pinned.erase(entry);
+        m_pinnedCount--;
+      } else {
+        m_lru.erase(entry);
+      }
+      m_entries.erase(it);
+      m_bytesGauge.set((double) m_bytes);
+    }
+
+private:
+    static constexpr size_t c_entryOverhead = 64;
+
+    std::string m_name;
+    SizeFunction m_sizeOf;
+
+    mutable std::mutex m_mutex;
+    //front is the most recently used, pinned entries live in their own list so eviction never walks over them
+    EntryList m_lru;
+    EntryList m_pinned;
+    std::unordered_map<K, typename EntryList::iterator, Hash> m_entries;
+    std::unordered_map<K, std::shared_future<Value>, Hash> m_loading;
+    size_t m_bytes = 0;
+    size_t m_pinnedCount = 0;
+
+    Metrics::Counter &m_hits;
+    Metrics::Counter &m_misses;
+    Metrics::Counter &m_coalesced;
+    Metrics::Counter &m_evictions;
+    Metrics::Gauge &m_bytesGauge;
+  };
+}// namespace HummingBirdCore::Memory
@@ -0,0 +1,59 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "CacheBudget.h"
+
+namespace HummingBirdCore::Memory {
+  void CacheBudget::setLimit(size_t bytes) {
+    s_limit.store(bytes, std::memory_order_relaxed);
+    CORE_INFO("Cache budget set to {0} MB", bytes / (1024 * 1024));
+    enforce();
+  }
+
+  size_t CacheBudget::trim(size_t targetBytes) {
+    HB_PROFILE_SCOPE("CacheBudget::trim");
+    //one trim at a time, the registry cannot change underneath it
+    std::lock_guard<std::mutex> lock(s_mutex);
+    size_t evicted = 0;
+    while (getUsed() > targetBytes) {
+      ICache *oldestCache = nullptr;
+      uint64_t oldestUse = ICache::c_nothingToEvict;
+      for (ICache *cache: s_caches) {
+        const uint64_t use = cache->getOldestUse();
+        if (use < oldestUse) {
+          oldestUse = use;
+          oldestCache = cache;
+        }
+      }
+      if (oldestCache == nullptr)
+        break;
+      evicted += oldestCache->evictOldest();
+    }
+    return evicted;
+  }
+
+  void CacheBudget::clearAll() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (ICache *cache: s_caches) {
+      cache->clear();
+    }
+  }
+
+  void CacheBudget::registerCache(ICache *cache) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_caches.push_back(cache);
+  }
+
+  void CacheBudget::unregisterCache(ICache *cache) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    std::erase(s_caches, cache);
+  }
+
+  void CacheBudget::forEachCache(const std::function<void(const ICache &)> &fn) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (const ICache *cache: s_caches) {
+      fn(*cache);
+    }
+  }
+}// namespace HummingBirdCore::Memory
@@ -0,0 +1,95 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <atomic>
+
+namespace HummingBirdCore::Memory {
+  struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    //misses that waited for a load another thread already started
+    uint64_t coalesced = 0;
+    uint64_t evictions = 0;
+    size_t bytes = 0;
+    size_t entries = 0;
+    size_t pinned = 0;
+  };
+
+  /**
+   * @brief What the budget needs from a cache to evict across all of them.
+   */
+  class ICache {
+public:
+    static constexpr uint64_t c_nothingToEvict = std::numeric_limits<uint64_t>::max();
+
+    virtual ~ICache() = default;
+
+    virtual const std::string &getName() const = 0;
+    virtual CacheStats getStats() const = 0;
+
+    /**
+     * @brief Use stamp of the least recently used entry that is not pinned, c_nothingToEvict when there is none.
+     */
+    virtual uint64_t getOldestUse() const = 0;
+
+    /**
+     * @brief Drops the least recently used entry that is not pinned.
+     * @return The bytes it was accounted for
+     */
+    virtual size_t evictOldest() = 0;
+
+    virtual void clear() = 0;
+  };
+
+  /**
+   * @brief One memory budget shared by every cache in the process.
+   *
+   * Caches charge the budget for what they hold, when an insert pushes the total over the limit the least recently
+   * used entries are evicted across all caches, so a big directory listing can push out an old plist. Every use of
+   * an entry takes a stamp from one global clock, that is what makes entries of different caches comparable.
+   */
+  class CacheBudget {
+public:
+    static void setLimit(size_t bytes);
+    static size_t getLimit() { return s_limit.load(std::memory_order_relaxed); }
+    static size_t getUsed() { return s_used.load(std::memory_order_relaxed); }
+
+    static uint64_t nextUse() { return s_clock.fetch_add(1, std::memory_order_relaxed); }
+
+    static void charge(size_t bytes) { s_used.fetch_add(bytes, std::memory_order_relaxed); }
+    static void release(size_t bytes) { s_used.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    /**
+     * @brief Evicts until the caches hold at most targetBytes or only pinned entries are left.
+     * Caches call this after an insert, never while holding their own lock.
+     * @return The bytes that were evicted
+     */
+    static size_t trim(size_t targetBytes);
+
+    static void enforce() {
+      if (getUsed() > getLimit())
+        trim(getLimit());
+    }
+
+    static void clearAll();
+
+    static void registerCache(ICache *cache);
+    static void unregisterCache(ICache *cache);
+
+    static void forEachCache(const std::function<void(const ICache &)> &fn);
+
+private:
+    static constexpr size_t c_defaultLimit = 256 * 1024 * 1024;
+
+    inline static std::mutex s_mutex;
+    inline static std::vector<ICache *> s_caches = {};
+
+    inline static std::atomic<size_t> s_limit = c_defaultLimit;
+    inline static std::atomic<size_t> s_used = 0;
+    inline static std::atomic<uint64_t> s_clock = 0;
+  };
+}// namespace HummingBirdCore::Memory
@@ -0,0 +1,101 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "FrameArena.h"
+
+namespace HummingBirdCore::Memory {
+  FrameArena::FrameArena(size_t blockSize) : m_blockSize(blockSize) {
+    addBlock(m_blockSize);
+  }
+
+  FrameArena::~FrameArena() {
+    for (auto &block: m_blocks) {
+      std::free(block.data);
+    }
+  }
+
+  FrameArena &FrameArena::get() {
+    static FrameArena arena;
+    return arena;
+  }
+
+  void FrameArena::addBlock(size_t minimumSize) {
+    Block block;
+    block.size = std::max(minimumSize, m_blockSize);
+    block.data = static_cast<char *>(std::malloc(block.size));
+    if (block.data == nullptr)
+      throw std::bad_alloc();
+    m_blocks.push_back(block);
+  }
+
+  void *FrameArena::allocate(size_t size, size_t alignment) {
+    Block *block = &m_blocks.back();
+    size_t offset = (block->offset + alignment - 1) & ~(alignment - 1);
+    if (offset + size > block->size) {
+      addBlock(size + alignment);
+      block = &m_blocks.back();
+      offset = (block->offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    m_usedBytes += offset - block->offset + size;
+    block->offset = offset + size;
+    return block->data + offset;
+  }
+
+  const char *FrameArena::copy(std::string_view str) {
+    char *buffer = static_cast<char *>(allocate(str.size() + 1, 1));
+    std::memcpy(buffer, str.data(), str.size());
+    buffer[str.size()] = '\0';
+    return buffer;
+  }
+
+  size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const auto &block: m_blocks) {
+      capacity += block.size;
+    }
+    return capacity;
+  }
+
+  void FrameArena::reset() {
+    m_peakBytes = std::max(m_peakBytes, m_usedBytes);
+    m_usedBytes = 0;
+
+    //this frame did not fit in one block, make the next one fit
+    if (m_blocks.size() > 1) {
+      const size_t capacity = getCapacity();
+      for (auto &block: m_blocks) {
+        std::free(block.data);
+      }
+      m_blocks.clear();
+      addBlock(capacity);
+    }
+    m_blocks.back().offset = 0;
+  }
+
+  FrameStringBuilder::FrameStringBuilder(size_t capacity, FrameArena &arena) : m_arena(arena) {
+    reserve(capacity);
+    m_data[0] = '\0';
+  }
+
+  FrameStringBuilder &FrameStringBuilder::append(std::string_view str) {
+    reserve(m_size + str.size());
+    std::memcpy(m_data + m_size, str.data(), str.size());
+    m_size += str.size();
+    m_data[m_size] = '\0';
+    return *this;
+  }
+
+  void FrameStringBuilder::reserve(size_t size) {
+    if (size + 1 <= m_capacity)
+      return;
+
+    const size_t capacity = std::max(size + 1, m_capacity * 2);
+    char *data = static_cast<char *>(m_arena.allocate(capacity, 1));
+    if (m_data != nullptr)
+      std::memcpy(data, m_data, m_size + 1);
+    m_data = data;
+    m_capacity = capacity;
+  }
+}// namespace HummingBirdCore::Memory
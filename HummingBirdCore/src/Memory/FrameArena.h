@@ -0,0 +1,115 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <fmt/format.h>
+
+namespace HummingBirdCore::Memory {
+  /**
+   * @brief Bump allocator for data that only lives until the end of the frame, main thread only.
+   *
+   * Everything is released at once by reset() after HBUI::endFrame(). When a frame needed more than one block the
+   * blocks are merged into one big enough block on reset, so steady state frames never touch the heap.
+   */
+  class FrameArena {
+public:
+    explicit FrameArena(size_t blockSize = c_defaultBlockSize);
+    ~FrameArena();
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T *allocateArray(size_t count) {
+      return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Copies str into the arena.
+     * @return Null terminated copy that is valid until the end of the frame
+     */
+    const char *copy(std::string_view str);
+
+    /**
+     * @brief fmt::format into the arena.
+     * @return Null terminated string that is valid until the end of the frame
+     */
+    template<typename... Args>
+    const char *format(fmt::format_string<Args...> formatString, Args &&...args) {
+      const size_t size = fmt::formatted_size(formatString, std::forward<Args>(args)...);
+      char *buffer = static_cast<char *>(allocate(size + 1, 1));
+      fmt::format_to(buffer, formatString, std::forward<Args>(args)...);
+      buffer[size] = '\0';
+      return buffer;
+    }
+
+    void reset();
+
+    size_t getUsedBytes() const { return m_usedBytes; }
+    size_t getPeakBytes() const { return m_peakBytes; }
+    size_t getCapacity() const;
+    size_t getBlockCount() const { return m_blocks.size(); }
+
+    /**
+     * @brief The arena of the main thread frame loop.
+     */
+    static FrameArena &get();
+
+private:
+    struct Block {
+      char *data = nullptr;
+      size_t size = 0;
+      size_t offset = 0;
+    };
+
+    void addBlock(size_t minimumSize);
+
+private:
+    static constexpr size_t c_defaultBlockSize = 64 * 1024;
+
+    std::vector<Block> m_blocks = {};
+    size_t m_blockSize;
+    size_t m_usedBytes = 0;
+    size_t m_peakBytes = 0;
+  };
+
+  /**
+   * @brief Builds a string piece by piece in the frame arena.
+   * Appending grows the buffer inside the arena, the old buffer is not reclaimed until the arena resets.
+   */
+  class FrameStringBuilder {
+public:
+    explicit FrameStringBuilder(size_t capacity = 128, FrameArena &arena = FrameArena::get());
+
+    FrameStringBuilder &append(std::string_view str);
+    FrameStringBuilder &append(char c) { return append(std::string_view(&c, 1)); }
+
+    template<typename... Args>
+    FrameStringBuilder &appendFormat(fmt::format_string<Args...> formatString, Args &&...args) {
+      const size_t size = fmt::formatted_size(formatString, std::forward<Args>(args)...);
+      reserve(m_size + size);
+      fmt::format_to(m_data + m_size, formatString, std::forward<Args>(args)...);
+      m_size += size;
+      m_data[m_size] = '\0';
+      return *this;
+    }
+
+    const char *c_str() const { return m_data; }
+    std::string_view view() const { return {m_data, m_size}; }
+    size_t size() const { return m_size; }
+
+private:
+    void reserve(size_t size);
+
+private:
+    FrameArena &m_arena;
+    char *m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+  };
+}// namespace HummingBirdCore::Memory
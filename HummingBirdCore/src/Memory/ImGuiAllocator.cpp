@@ -0,0 +1,193 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "ImGuiAllocator.h"
+
+#include <cassert>
+
+namespace HummingBirdCore::Memory {
+  namespace {
+    constexpr double c_statsInterval = 1.0;
+    //a pool is held for a few pointer writes, past this many pauses the holder was most likely preempted
+    constexpr int c_spinsBeforeYield = 64;
+
+    struct FreeBlock {
+      FreeBlock *next;
+    };
+
+    struct Pool {
+      std::atomic<bool> locked = false;
+      FreeBlock *freeList = nullptr;
+    };
+
+    //one pool per ImGuiAllocator::c_sizeClasses entry
+    std::array<Pool, 16> s_pools = {};
+
+    inline void spinPause() {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#elif defined(__aarch64__)
+      asm volatile("yield");
+#endif
+    }
+
+    void lockPool(Pool &pool) {
+      int spins = 0;
+      while (pool.locked.exchange(true, std::memory_order_acquire)) {
+        //wait on a plain load, retrying the exchange would bounce the cache line between the waiting cores
+        while (pool.locked.load(std::memory_order_relaxed)) {
+          if (++spins < c_spinsBeforeYield)
+            spinPause();
+          else
+            std::this_thread::yield();
+        }
+      }
+    }
+
+    void unlockPool(Pool &pool) {
+      pool.locked.store(false, std::memory_order_release);
+    }
+  }// namespace
+
+  ImGuiAllocator &ImGuiAllocator::get() {
+    static ImGuiAllocator allocator;
+    return allocator;
+  }
+
+  void ImGuiAllocator::install() {
+    void *core = getOwnerCount() > 0 ? &s_owners[0] : get().registerOwner("Core");
+    ImGui::SetAllocatorFunctions(&ImGuiAllocator::allocate, &ImGuiAllocator::free, core);
+    s_lastStatsUpdate = std::chrono::steady_clock::now();
+  }
+
+  void *ImGuiAllocator::registerOwner(const char *name) {
+    const size_t index = s_ownersReserved.fetch_add(1, std::memory_order_relaxed);
+    if (index >= c_maxOwners) {
+      CORE_WARN("Out of allocator owners, {0} is accounted to {1}", name, s_owners[0].name);
+      return &s_owners[0];
+    }
+
+    AllocatorOwner &owner = s_owners[index];
+    owner.name = name;
+    owner.index = (uint16_t) index;
+    //publish in slot order, a reader walking up to getOwnerCount() never sees an owner that is still being filled in
+    size_t published = index;
+    while (!s_ownerCount.compare_exchange_weak(published, index + 1, std::memory_order_release, std::memory_order_relaxed)) {
+      published = index;
+      spinPause();
+    }
+    return &owner;
+  }
+
+  int ImGuiAllocator::getSizeClass(size_t size) {
+    for (size_t i = 0; i < c_sizeClasses.size(); i++) {
+      if (size <= c_sizeClasses[i])
+        return (int) i;
+    }
+    return -1;
+  }
+
+  void *ImGuiAllocator::allocateFromPool(int sizeClass) {
+    Pool &pool = s_pools[sizeClass];
+    lockPool(pool);
+
+    if (pool.freeList == nullptr) {
+      //carve a new chunk into blocks of this class
+      const size_t blockSize = c_sizeClasses[sizeClass];
+      const size_t blockCount = std::max<size_t>(1, c_chunkSize / blockSize);
+      char *chunk = static_cast<char *>(std::malloc(blockSize * blockCount));
+      if (chunk == nullptr) {
+        unlockPool(pool);
+        return nullptr;
+      }
+      for (size_t i = 0; i < blockCount; i++) {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + i * blockSize);
+        block->next = pool.freeList;
+        pool.freeList = block;
+      }
+      s_pooledBytes.fetch_add(blockSize * blockCount, std::memory_order_relaxed);
+    }
+
+    FreeBlock *block = pool.freeList;
+    pool.freeList = block->next;
+    unlockPool(pool);
+    return block;
+  }
+
+  void ImGuiAllocator::freeToPool(void *ptr, int sizeClass) {
+    Pool &pool = s_pools[sizeClass];
+    lockPool(pool);
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = pool.freeList;
+    pool.freeList = block;
+    unlockPool(pool);
+  }
+
+  void *ImGuiAllocator::allocate(size_t size, void *userData) {
+    AllocatorOwner *owner = userData != nullptr ? static_cast<AllocatorOwner *>(userData) : &s_owners[0];
+    const size_t total = size + sizeof(Header);
+
+    const int sizeClass = getSizeClass(total);
+    void *block = sizeClass >= 0 ? allocateFromPool(sizeClass) : std::malloc(total);
+    if (block == nullptr)
+      return nullptr;
+
+    Header *header = static_cast<Header *>(block);
+    header->owner = owner->index;
+    header->sizeClass = sizeClass >= 0 ? (uint16_t) sizeClass : c_largeClass;
+    header->magic = c_headerMagic;
+    header->size = size;
+
+    const int64_t live = owner->liveBytes.fetch_add((int64_t) size, std::memory_order_relaxed) + (int64_t) size;
+    int64_t peak = owner->peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !owner->peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    owner->liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    owner->allocations.fetch_add(1, std::memory_order_relaxed);
+
+    return header + 1;
+  }
+
+  void ImGuiAllocator::free(void *ptr, void *userData) {
+    if (ptr == nullptr)
+      return;
+
+    //the header knows the owner, userData is whoever happens to free it
+    Header *header = static_cast<Header *>(ptr) - 1;
+    //freed twice or never allocated here, leaking it beats corrupting a pool
+    const bool valid = header->magic == c_headerMagic && header->owner < c_maxOwners &&
+                       (header->sizeClass == c_largeClass || header->sizeClass < c_sizeClasses.size());
+    assert(valid && "ImGuiAllocator::free got a block it did not allocate");
+    if (!valid) {
+      CORE_ERROR("ImGuiAllocator::free got a block it did not allocate or that was freed already, leaking it");
+      return;
+    }
+    header->magic = 0;
+    AllocatorOwner &owner = s_owners[header->owner];
+    owner.liveBytes.fetch_sub((int64_t) header->size, std::memory_order_relaxed);
+    owner.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+    if (header->sizeClass == c_largeClass) {
+      std::free(header);
+    } else {
+      freeToPool(header, header->sizeClass);
+    }
+  }
+
+  void ImGuiAllocator::updateStats() {
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - s_lastStatsUpdate).count();
+    if (elapsed < c_statsInterval)
+      return;
+
+    const size_t ownerCount = getOwnerCount();
+    for (size_t i = 0; i < ownerCount; i++) {
+      AllocatorOwner &owner = s_owners[i];
+      const uint64_t allocations = owner.allocations.load(std::memory_order_relaxed);
+      owner.allocationsPerSecond = (float) ((double) (allocations - owner.lastAllocations) / elapsed);
+      owner.lastAllocations = allocations;
+    }
+    s_lastStatsUpdate = now;
+  }
+}// namespace HummingBirdCore::Memory
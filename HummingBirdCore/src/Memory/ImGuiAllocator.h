@@ -0,0 +1,92 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <IPlugin.h>
+
+#include <array>
+#include <atomic>
+
+namespace HummingBirdCore::Memory {
+  /**
+   * @brief Who asked for memory through the ImGui allocator functions: core, the plugin manager or a single plugin.
+   */
+  struct AllocatorOwner {
+    std::string name;
+    uint16_t index = 0;
+
+    std::atomic<int64_t> liveBytes = 0;
+    std::atomic<int64_t> peakBytes = 0;
+    std::atomic<int64_t> liveAllocations = 0;
+    std::atomic<uint64_t> allocations = 0;
+
+    //main thread, updated by ImGuiAllocator::updateStats()
+    uint64_t lastAllocations = 0;
+    float allocationsPerSecond = 0.0f;
+  };
+
+  /**
+   * @brief Size class pool allocator installed with ImGui::SetAllocatorFunctions.
+   *
+   * Every block starts with a 16 byte header holding the owner and size class, so a block can be freed through any
+   * module's ImGui copy and still be accounted to whoever allocated it. The header carries c_headerMagic, free()
+   * refuses a pointer without it instead of handing a foreign or freed block to a pool. The user data handed to ImGui is the owner,
+   * the host and the plugin manager register a new owner for every plugin they create.
+   * Requests above the largest size class go straight to malloc.
+   */
+  class ImGuiAllocator : public HummingBird::Plugins::IAllocatorRegistry {
+public:
+    static ImGuiAllocator &get();
+
+    /**
+     * @brief Installs the allocator for the core ImGui copy, has to happen before the ImGui context is created.
+     */
+    static void install();
+
+    static void *allocate(size_t size, void *userData);
+    static void free(void *ptr, void *userData);
+
+    //IAllocatorRegistry
+    void *registerOwner(const char *name) override;
+
+    /**
+     * @brief Recomputes the allocation rates, called once per frame.
+     */
+    static void updateStats();
+
+    static size_t getOwnerCount() { return s_ownerCount.load(std::memory_order_acquire); }
+    static const AllocatorOwner &getOwner(size_t index) { return s_owners[index]; }
+    static size_t getPooledBytes() { return s_pooledBytes.load(std::memory_order_relaxed); }
+
+private:
+    struct Header {
+      uint16_t owner;
+      uint16_t sizeClass;
+      uint32_t magic;
+      uint64_t size;
+    };
+    static_assert(sizeof(Header) == 16, "ImGui allocator header has to keep 16 byte alignment");
+
+    static int getSizeClass(size_t size);
+    static void *allocateFromPool(int sizeClass);
+    static void freeToPool(void *block, int sizeClass);
+
+private:
+    static constexpr size_t c_maxOwners = 64;
+    static constexpr size_t c_chunkSize = 64 * 1024;
+    static constexpr uint16_t c_largeClass = 0xFFFF;
+    static constexpr uint32_t c_headerMagic = 0x48424947;
+    static constexpr std::array<size_t, 16> c_sizeClasses = {32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 8192};
+
+    inline static std::array<AllocatorOwner, c_maxOwners> s_owners = {};
+    //slots handed out, s_ownerCount only counts the ones that are filled in
+    inline static std::atomic<size_t> s_ownersReserved = 0;
+    inline static std::atomic<size_t> s_ownerCount = 0;
+    inline static std::atomic<size_t> s_pooledBytes = 0;
+
+    inline static std::chrono::steady_clock::time_point s_lastStatsUpdate = {};
+  };
+}// namespace HummingBirdCore::Memory
@@ -0,0 +1,192 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "MemoryPressureManager.h"
+
+#include "CacheBudget.h"
+
+#include "Metrics/StatsRegistry.h"
+#include "Rendering/FramePacer.h"
+
+#ifdef __APPLE__
+#include <dispatch/dispatch.h>
+#endif
+
+#include <unistd.h>
+
+namespace HummingBirdCore::Memory {
+  bool SpillFile::write(const std::vector<uint8_t> &data) {
+    static std::atomic<uint64_t> s_nextId = 0;
+
+    remove();
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::temp_directory_path(error);
+    if (error) {
+      CORE_ERROR("No temporary directory to spill to: " + error.message());
+      return false;
+    }
+    path /= "hummingbird-" + std::to_string(getpid()) + "-" + std::to_string(s_nextId.fetch_add(1)) + ".spill";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      CORE_ERROR("Unable to open spill file: " + path.string());
+      return false;
+    }
+    file.write((const char *) data.data(), (std::streamsize) data.size());
+    file.close();
+    if (!file) {
+      CORE_ERROR("Unable to write spill file: " + path.string());
+      std::filesystem::remove(path, error);
+      return false;
+    }
+
+    m_path = std::move(path);
+    return true;
+  }
+
+  void SpillFile::remove() {
+    if (m_path.empty())
+      return;
+    std::error_code error;
+    std::filesystem::remove(m_path, error);
+    m_path.clear();
+  }
+
+  namespace {
+#ifdef __APPLE__
+    void onMemoryPressure(void *context) {
+      auto *source = (dispatch_source_t) context;
+      const unsigned long flags = dispatch_source_get_data(source);
+      if (flags & DISPATCH_MEMORYPRESSURE_CRITICAL)
+        MemoryPressureManager::notifyPressure(MemoryPressureManager::PressureLevelCritical);
+      else if (flags & DISPATCH_MEMORYPRESSURE_WARN)
+        MemoryPressureManager::notifyPressure(MemoryPressureManager::PressureLevelWarning);
+    }
+#endif
+  }// namespace
+
+  void MemoryPressureManager::initialize() {
+    //opt-in override, the default leaves plenty of room on any machine this runs on
+    if (const char *budget = std::getenv("HUMMINGBIRD_MEMORY_BUDGET_MB"); budget != nullptr) {
+      const long megabytes = std::strtol(budget, nullptr, 10);
+      if (megabytes > 0)
+        setBudget((size_t) megabytes * 1024 * 1024);
+    }
+    CORE_INFO("Memory budget set to {0} MB", s_budget / (1024 * 1024));
+
+#ifdef __APPLE__
+    if (s_pressureSource == nullptr) {
+      dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                        DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                        dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+      if (source == nullptr) {
+        CORE_WARN("Unable to listen for memory pressure");
+        return;
+      }
+      dispatch_set_context(source, source);
+      dispatch_source_set_event_handler_f(source, onMemoryPressure);
+      dispatch_resume(source);
+      s_pressureSource = source;
+    }
+#endif
+  }
+
+  void MemoryPressureManager::shutdown() {
+#ifdef __APPLE__
+    if (s_pressureSource != nullptr) {
+      dispatch_source_cancel((dispatch_source_t) s_pressureSource);
+      dispatch_release((dispatch_source_t) s_pressureSource);
+      s_pressureSource = nullptr;
+    }
+#endif
+    s_tracked.clear();
+  }
+
+  void MemoryPressureManager::add(IReclaimable *reclaimable) {
+    s_tracked.push_back(Tracked{reclaimable, nowNs()});
+  }
+
+  void MemoryPressureManager::remove(IReclaimable *reclaimable) {
+    std::erase_if(s_tracked, [reclaimable](const Tracked &tracked) { return tracked.reclaimable == reclaimable; });
+  }
+
+  void MemoryPressureManager::touch(IReclaimable *reclaimable) {
+    for (Tracked &tracked: s_tracked) {
+      if (tracked.reclaimable == reclaimable) {
+        tracked.lastUseNs = nowNs();
+        return;
+      }
+    }
+  }
+
+  void MemoryPressureManager::notifyPressure(PressureLevel level) {
+    int current = s_pressure.load(std::memory_order_relaxed);
+    while (current < level && !s_pressure.compare_exchange_weak(current, level, std::memory_order_relaxed)) {
+    }
+    //an idle window would not get to update() until the next event
+    Rendering::FramePacer::requestFrame();
+  }
+
+  size_t MemoryPressureManager::getUsage() {
+    size_t usage = CacheBudget::getUsed();
+    for (const Tracked &tracked: s_tracked) {
+      usage += tracked.reclaimable->getReclaimableBytes();
+    }
+    return usage;
+  }
+
+  void MemoryPressureManager::update() {
+    const int pressure = s_pressure.exchange(PressureLevelNormal, std::memory_order_relaxed);
+    const int64_t now = nowNs();
+    if (pressure == PressureLevelNormal && now - s_lastCheckNs < (int64_t) (c_checkInterval * 1e9))
+      return;
+    s_lastCheckNs = now;
+
+    HB_PROFILE_SCOPE("MemoryPressureManager::update");
+    s_lastUsage = getUsage();
+    Metrics::StatsRegistry::gauge("memory.reclaimable_bytes").set((double) s_lastUsage);
+
+    if (pressure == PressureLevelCritical) {
+      CORE_WARN("Critical memory pressure, dropping caches and unloading every window that is not in use");
+      CacheBudget::clearAll();
+      trim(0, c_criticalIdleSeconds);
+    } else if (pressure == PressureLevelWarning) {
+      CORE_WARN("Memory pressure, trimming to half of the budget");
+      trim(s_budget / 2, c_minIdleSeconds);
+    } else if (s_lastUsage > s_budget) {
+      trim(s_budget - s_budget / c_trimHeadroom, c_minIdleSeconds);
+    }
+  }
+
+  size_t MemoryPressureManager::trim(size_t targetBytes, double minIdleSeconds) {
+    HB_PROFILE_SCOPE("MemoryPressureManager::trim");
+    size_t usage = getUsage();
+    if (usage <= targetBytes)
+      return 0;
+
+    //caches first, they are cheap to fill again and nobody is looking at them
+    const size_t windowBytes = usage - CacheBudget::getUsed();
+    size_t freed = CacheBudget::trim(targetBytes > windowBytes ? targetBytes - windowBytes : 0);
+    usage -= freed;
+
+    //least recently focused first
+    std::vector<Tracked> byLastUse = s_tracked;
+    std::ranges::sort(byLastUse, {}, &Tracked::lastUseNs);
+    const int64_t idleSince = nowNs() - (int64_t) (minIdleSeconds * 1e9);
+    for (const Tracked &tracked: byLastUse) {
+      if (usage <= targetBytes || tracked.lastUseNs > idleSince)
+        break;
+      if (tracked.reclaimable->getReclaimableBytes() == 0)
+        continue;
+      const size_t reclaimed = tracked.reclaimable->reclaim();
+      CORE_INFO("Reclaimed {0} KB from {1}", reclaimed / 1024, tracked.reclaimable->getReclaimName());
+      usage -= std::min(usage, reclaimed);
+      freed += reclaimed;
+    }
+
+    Metrics::StatsRegistry::counter("memory.reclaimed_bytes").add((int64_t) freed);
+    s_lastUsage = usage;
+    return freed;
+  }
+}// namespace HummingBirdCore::Memory
@@ -0,0 +1,134 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Utils/MappedFile.h"
+
+#include <atomic>
+
+namespace HummingBirdCore::Memory {
+  /**
+   * @brief State a window can give back and rebuild later, scrollback, table rows, parsed trees.
+   */
+  class IReclaimable {
+public:
+    virtual ~IReclaimable() = default;
+
+    /**
+     * @brief Estimate of what reclaim() would free right now. Main thread.
+     */
+    virtual size_t getReclaimableBytes() const = 0;
+
+    /**
+     * @brief Drops or spills the state, the window rebuilds it the next time it is focused. Main thread.
+     * @return The bytes that were freed
+     */
+    virtual size_t reclaim() = 0;
+
+    virtual const char *getReclaimName() const = 0;
+  };
+
+  /**
+   * @brief Temporary file for state that was moved out of memory, removed again on destruction.
+   */
+  class SpillFile {
+public:
+    SpillFile() = default;
+    ~SpillFile() { remove(); }
+
+    SpillFile(const SpillFile &) = delete;
+    SpillFile &operator=(const SpillFile &) = delete;
+
+    bool write(const std::vector<uint8_t> &data);
+    Utils::MappedFile map() const { return Utils::MappedFile(m_path); }
+    void remove();
+
+    bool isSpilled() const { return !m_path.empty(); }
+
+private:
+    std::filesystem::path m_path = {};
+  };
+
+  /**
+   * @brief Process wide memory budget over the caches and the reclaimable state of the open windows.
+   *
+   * Windows add themselves on construction, remove themselves on destruction and touch() while they are focused.
+   * Once a second, or right away when the OS reports memory pressure, the caches and the reclaimable window state
+   * are summed. Over the budget the caches are trimmed first, then the least recently focused windows are reclaimed
+   * until the total fits again. Windows focused in the last c_minIdleSeconds are left alone unless the pressure
+   * is critical. The budget can be set with HUMMINGBIRD_MEMORY_BUDGET_MB. Main thread only, except notifyPressure().
+   */
+  class MemoryPressureManager {
+public:
+    enum PressureLevel {
+      PressureLevelNormal,
+      PressureLevelWarning,
+      PressureLevelCritical
+    };
+
+    /**
+     * @brief Starts listening for OS memory pressure, macOS only.
+     */
+    static void initialize();
+    static void shutdown();
+
+    static void add(IReclaimable *reclaimable);
+    static void remove(IReclaimable *reclaimable);
+    static void touch(IReclaimable *reclaimable);
+
+    static void setBudget(size_t bytes) { s_budget = bytes; }
+    static size_t getBudget() { return s_budget; }
+
+    /**
+     * @brief Safe to call from any thread, handled on the next update().
+     */
+    static void notifyPressure(PressureLevel level);
+
+    /**
+     * @brief Called by the application once per frame.
+     */
+    static void update();
+
+    /**
+     * @brief Reclaims until caches and windows together use at most targetBytes.
+     * @param minIdleSeconds Windows focused more recently than this are skipped
+     * @return The bytes that were freed
+     */
+    static size_t trim(size_t targetBytes, double minIdleSeconds);
+
+    static size_t getLastUsage() { return s_lastUsage; }
+
+private:
+    struct Tracked {
+      IReclaimable *reclaimable;
+      int64_t lastUseNs;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    static int64_t nowNs() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    static size_t getUsage();
+
+private:
+    static constexpr size_t c_defaultBudget = 1024ull * 1024 * 1024;
+    static constexpr double c_checkInterval = 1.0;
+    static constexpr double c_minIdleSeconds = 30.0;
+    //the focused window touches every frame, this keeps it loaded even under critical pressure
+    static constexpr double c_criticalIdleSeconds = 1.0;
+    //trims a bit below the budget so the next check does not trim again right away
+    static constexpr size_t c_trimHeadroom = 16;
+
+    inline static std::vector<Tracked> s_tracked = {};
+    inline static size_t s_budget = c_defaultBudget;
+    inline static size_t s_lastUsage = 0;
+    inline static int64_t s_lastCheckNs = 0;
+    inline static std::atomic<int> s_pressure = PressureLevelNormal;
+    inline static void *s_pressureSource = nullptr;
+  };
+}// namespace HummingBirdCore::Memory
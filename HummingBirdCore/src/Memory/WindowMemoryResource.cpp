@@ -0,0 +1,72 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "WindowMemoryResource.h"
+
+namespace HummingBirdCore::Memory {
+  namespace {
+    std::pmr::pool_options getPoolOptions(size_t largestPooledBlock) {
+      std::pmr::pool_options options;
+      options.largest_required_pool_block = largestPooledBlock;
+      return options;
+    }
+  }// namespace
+
+  WindowMemoryResource::WindowMemoryResource(std::string windowName, const std::string &statPrefix)
+      : m_windowName(std::move(windowName)), m_gauge(Metrics::StatsRegistry::gauge(statPrefix + ".memory_bytes")),
+        m_upstream(*this), m_pool(getPoolOptions(c_largestPooledBlock), &m_upstream) {
+    s_resources.push_back(this);
+  }
+
+  WindowMemoryResource::~WindowMemoryResource() {
+    release();
+    std::erase(s_resources, this);
+  }
+
+  void WindowMemoryResource::release() {
+    HB_PROFILE_SCOPE("WindowMemoryResource::release");
+    m_pool.release();
+    m_liveBytes = 0;
+    updateGauges();
+  }
+
+  void *WindowMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    void *ptr = m_pool.allocate(bytes, alignment);
+    m_liveBytes += bytes;
+    m_peakBytes = std::max(m_peakBytes, m_liveBytes);
+    return ptr;
+  }
+
+  void WindowMemoryResource::do_deallocate(void *ptr, size_t bytes, size_t alignment) {
+    m_pool.deallocate(ptr, bytes, alignment);
+    m_liveBytes -= std::min(m_liveBytes, bytes);
+  }
+
+  void *WindowMemoryResource::Upstream::do_allocate(size_t bytes, size_t alignment) {
+    void *ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    reservedBytes += bytes;
+    owner.updateGauges();
+    return ptr;
+  }
+
+  void WindowMemoryResource::Upstream::do_deallocate(void *ptr, size_t bytes, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    reservedBytes -= std::min(reservedBytes, bytes);
+    owner.updateGauges();
+  }
+
+  void WindowMemoryResource::updateGauges() const {
+    static Metrics::Gauge &reserved = Metrics::StatsRegistry::gauge("window.memory_bytes");
+    size_t total = 0;
+    size_t kind = 0;
+    for (const WindowMemoryResource *resource: s_resources) {
+      total += resource->getReservedBytes();
+      //windows of one kind share the gauge
+      if (&resource->m_gauge == &m_gauge)
+        kind += resource->getReservedBytes();
+    }
+    reserved.set((double) total);
+    m_gauge.set((double) kind);
+  }
+}// namespace HummingBirdCore::Memory
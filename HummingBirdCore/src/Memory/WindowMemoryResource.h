@@ -0,0 +1,84 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Metrics/StatsRegistry.h"
+
+#include <memory_resource>
+
+namespace HummingBirdCore::Memory {
+  /**
+   * @brief Memory owned by a single window, handed to its containers as a std::pmr::memory_resource.
+   *
+   * Allocations are served by a size class pool that keeps freed blocks for reuse while the window is open, so a
+   * window that grows and shrinks its data reuses its own chunks instead of scattering small blocks over the global
+   * heap. Closing the window hands every chunk back at once. Main thread only, every live resource is listed in the
+   * Metrics window and the total is published as the window.memory_bytes gauge. The reserved bytes of every window
+   * of one kind are published next to its other stats as the <statPrefix>.memory_bytes gauge.
+   */
+  class WindowMemoryResource : public std::pmr::memory_resource {
+public:
+    /**
+     * @param statPrefix Prefix of the stats of the window, dataviewer for dataviewer.memory_bytes
+     */
+    WindowMemoryResource(std::string windowName, const std::string &statPrefix);
+    ~WindowMemoryResource() override;
+
+    WindowMemoryResource(const WindowMemoryResource &) = delete;
+    WindowMemoryResource &operator=(const WindowMemoryResource &) = delete;
+
+    /**
+     * @brief Returns every chunk to the heap, nothing allocated from this resource may be used afterwards.
+     */
+    void release();
+
+    const std::string &getWindowName() const { return m_windowName; }
+    //bytes handed out to the window's containers
+    size_t getLiveBytes() const { return m_liveBytes; }
+    size_t getPeakBytes() const { return m_peakBytes; }
+    //bytes taken from the heap, the live bytes plus what the pool keeps for reuse
+    size_t getReservedBytes() const { return m_upstream.reservedBytes; }
+
+    static const std::vector<WindowMemoryResource *> &getResources() { return s_resources; }
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    /**
+     * @brief Counts what the pool takes from the heap.
+     */
+    class Upstream : public std::pmr::memory_resource {
+public:
+      explicit Upstream(WindowMemoryResource &owner) : owner(owner) {}
+
+      WindowMemoryResource &owner;
+      size_t reservedBytes = 0;
+
+protected:
+      void *do_allocate(size_t bytes, size_t alignment) override;
+      void do_deallocate(void *ptr, size_t bytes, size_t alignment) override;
+      bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    };
+
+    void updateGauges() const;
+
+private:
+    //matches the largest ImGuiAllocator size class, bigger blocks go to the heap directly
+    static constexpr size_t c_largestPooledBlock = 8192;
+
+    std::string m_windowName;
+    Metrics::Gauge &m_gauge;
+    Upstream m_upstream;
+    std::pmr::unsynchronized_pool_resource m_pool;
+    size_t m_liveBytes = 0;
+    size_t m_peakBytes = 0;
+
+    inline static std::vector<WindowMemoryResource *> s_resources = {};
+  };
+}// namespace HummingBirdCore::Memory
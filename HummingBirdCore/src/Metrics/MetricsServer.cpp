@@ -0,0 +1,136 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "MetricsServer.h"
+
+#include "Profiling/Profiler.h"
+#include "StatsRegistry.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace HummingBirdCore::Metrics {
+  bool MetricsServer::start(uint16_t port) {
+    if (isRunning())
+      return true;
+
+    const int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd == -1) {
+      CORE_ERROR("Unable to create the metrics socket");
+      return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    //loopback only, the stats are not meant for the network
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd, (sockaddr *) &address, sizeof(address)) == -1 || listen(listenFd, 8) == -1) {
+      CORE_ERROR("Unable to listen for metrics on 127.0.0.1:{0}", port);
+      close(listenFd);
+      return false;
+    }
+
+    s_stopping = false;
+    s_thread = std::thread(run, listenFd);
+    CORE_INFO("Serving metrics on http://127.0.0.1:{0}/metrics", port);
+    return true;
+  }
+
+  void MetricsServer::stop() {
+    if (!isRunning())
+      return;
+    s_stopping = true;
+    s_thread.join();
+  }
+
+  void MetricsServer::run(int listenFd) {
+    Profiling::Profiler::setThreadName("Metrics");
+    pollfd listenPoll = {listenFd, POLLIN, 0};
+    while (!s_stopping.load(std::memory_order_relaxed)) {
+      //wake up now and then to notice stop()
+      if (poll(&listenPoll, 1, c_pollIntervalMs) <= 0)
+        continue;
+
+      const int clientFd = accept(listenFd, nullptr, nullptr);
+      if (clientFd == -1)
+        continue;
+      handleConnection(clientFd);
+      close(clientFd);
+    }
+    close(listenFd);
+  }
+
+  void MetricsServer::handleConnection(int clientFd) {
+    //a client that connects and never sends anything, or never reads the response, can not stall the listener
+    timeval timeout = {};
+    timeout.tv_sec = c_receiveTimeoutMs / 1000;
+    timeout.tv_usec = (c_receiveTimeoutMs % 1000) * 1000;
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    timeout.tv_sec = c_sendTimeoutMs / 1000;
+    timeout.tv_usec = (c_sendTimeoutMs % 1000) * 1000;
+    setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < c_maxRequestSize) {
+      const ssize_t received = recv(clientFd, buffer, sizeof(buffer), 0);
+      if (received <= 0)
+        return;
+      request.append(buffer, (size_t) received);
+    }
+
+    //only the request line matters, "GET /metrics HTTP/1.1"
+    const std::string_view requestLine = std::string_view(request).substr(0, request.find("\r\n"));
+    const size_t methodEnd = requestLine.find(' ');
+    const size_t pathEnd = requestLine.find(' ', methodEnd + 1);
+    if (methodEnd == std::string_view::npos || pathEnd == std::string_view::npos) {
+      sendResponse(clientFd, "400 Bad Request", "text/plain", "Bad request\n");
+      return;
+    }
+    const std::string_view method = requestLine.substr(0, methodEnd);
+    std::string_view path = requestLine.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    path = path.substr(0, path.find('?'));
+
+    if (method != "GET") {
+      sendResponse(clientFd, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+    } else if (path != "/metrics") {
+      sendResponse(clientFd, "404 Not Found", "text/plain", "Metrics are served on /metrics\n");
+    } else {
+      //looked up once, the export itself never takes the registry lock
+      static Counter &scrapes = StatsRegistry::counter("metrics.scrapes");
+      scrapes.add();
+      sendResponse(clientFd, "200 OK", "text/plain; version=0.0.4; charset=utf-8", StatsRegistry::exportPrometheus());
+    }
+  }
+
+  void MetricsServer::sendResponse(int clientFd, const char *status, const char *contentType, std::string_view body) {
+    std::string response = fmt::format("HTTP/1.1 {0}\r\nContent-Type: {1}\r\nContent-Length: {2}\r\nConnection: close\r\n\r\n", status,
+                                       contentType, body.size());
+    response += body;
+
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    size_t sent = 0;
+    while (sent < response.size()) {
+      const ssize_t written = send(clientFd, response.data() + sent, response.size() - sent, flags);
+      if (written <= 0)
+        return;
+      sent += (size_t) written;
+    }
+  }
+}// namespace HummingBirdCore::Metrics
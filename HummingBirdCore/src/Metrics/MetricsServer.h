@@ -0,0 +1,41 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <atomic>
+#include <thread>
+
+namespace HummingBirdCore::Metrics {
+  /**
+   * @brief Minimal HTTP listener on 127.0.0.1 that serves StatsRegistry::exportPrometheus() on GET /metrics.
+   *
+   * Runs on its own thread so a slow scraper never holds up a pool worker, requests are answered one at a time and
+   * the connection is closed after every response. Opt-in with HUMMINGBIRD_METRICS_PORT.
+   */
+  class MetricsServer {
+public:
+    /**
+     * @return false when the port could not be bound
+     */
+    static bool start(uint16_t port);
+    static void stop();
+    static bool isRunning() { return s_thread.joinable(); }
+
+private:
+    static void run(int listenFd);
+    static void handleConnection(int clientFd);
+    static void sendResponse(int clientFd, const char *status, const char *contentType, std::string_view body);
+
+private:
+    static constexpr int c_pollIntervalMs = 250;
+    static constexpr int c_receiveTimeoutMs = 1000;
+    static constexpr int c_sendTimeoutMs = 1000;
+    static constexpr size_t c_maxRequestSize = 8 * 1024;
+
+    inline static std::thread s_thread;
+    inline static std::atomic<bool> s_stopping = false;
+  };
+}// namespace HummingBirdCore::Metrics
@@ -0,0 +1,25 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <IPlugin.h>
+#include "StatsRegistry.h"
+
+namespace HummingBirdCore::Metrics {
+  /**
+   * @brief Hands the stats registry to plugins, a timer handle is the registry histogram itself.
+   */
+  class PluginMetrics : public HummingBird::Plugins::IMetrics {
+public:
+    static PluginMetrics &get() {
+      static PluginMetrics s_instance;
+      return s_instance;
+    }
+
+    void *getTimer(const char *name) override { return &StatsRegistry::histogram(name); }
+    void recordTime(void *timer, uint64_t microseconds) override { ((Histogram *) timer)->record(microseconds); }
+  };
+}// namespace HummingBirdCore::Metrics
@@ -0,0 +1,317 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "StatsRegistry.h"
+
+#include <bit>
+
+namespace HummingBirdCore::Metrics {
+  namespace {
+    std::atomic<size_t> s_nextShard = 0;
+
+    std::string escape(std::string_view str) {
+      std::string escaped;
+      escaped.reserve(str.size());
+      for (char c: str) {
+        if (c == '"' || c == '\\')
+          escaped += '\\';
+        if ((unsigned char) c >= 0x20)
+          escaped += c;
+      }
+      return escaped;
+    }
+
+    //Prometheus names only allow [a-zA-Z0-9_:], the registry uses dotted paths
+    std::string sanitize(std::string_view name) {
+      std::string sanitized;
+      sanitized.reserve(name.size());
+      for (char c: name) {
+        sanitized += std::isalnum((unsigned char) c) ? c : '_';
+      }
+      return sanitized;
+    }
+
+    void writePrometheusValue(std::string &out, double value) {
+      if (std::isnan(value))
+        out += "NaN";
+      else if (std::isinf(value))
+        out += value > 0 ? "+Inf" : "-Inf";
+      else
+        fmt::format_to(std::back_inserter(out), "{:.9g}", value);
+    }
+  }// namespace
+
+  size_t getThreadShard() {
+    thread_local size_t shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % c_shardCount;
+    return shard;
+  }
+
+  //COUNTER
+  int64_t Counter::get() const {
+    int64_t value = 0;
+    for (const Shard &shard: m_shards) {
+      value += shard.value.load(std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  void Counter::reset() {
+    for (Shard &shard: m_shards) {
+      shard.value.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  //HISTOGRAM
+  size_t Histogram::getBucketIndex(uint64_t value) {
+    if (value < c_linearBuckets)
+      return (size_t) value;
+
+    //keep the top c_subBucketBits bits, the leading one selects the power of two, the rest the sub bucket
+    const int shift = (63 - std::countl_zero(value)) - (c_subBucketBits - 1);
+    const size_t subBucket = (size_t) (value >> shift) - c_subBuckets;
+    return c_linearBuckets + (size_t) (shift - 1) * c_subBuckets + subBucket;
+  }
+
+  uint64_t Histogram::getBucketLowerBound(size_t index) {
+    if (index < c_linearBuckets)
+      return index;
+
+    const int shift = (int) ((index - c_linearBuckets) / c_subBuckets) + 1;
+    const uint64_t subBucket = (index - c_linearBuckets) % c_subBuckets;
+    return (c_subBuckets + subBucket) << shift;
+  }
+
+  uint64_t Histogram::getBucketUpperBound(size_t index) {
+    if (index + 1 >= c_bucketCount)
+      return std::numeric_limits<uint64_t>::max();
+    return getBucketLowerBound(index + 1) - 1;
+  }
+
+  void Histogram::record(uint64_t value) {
+    Shard &shard = m_shards[getThreadShard()];
+    shard.buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = shard.min.load(std::memory_order_relaxed);
+    while (value < current && !shard.min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+    current = shard.max.load(std::memory_order_relaxed);
+    while (value > current && !shard.max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  HistogramSummary Histogram::getSummary() const {
+    HistogramSummary summary;
+    std::vector<uint64_t> buckets(c_bucketCount, 0);
+    uint64_t sum = 0;
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    for (const Shard &shard: m_shards) {
+      for (size_t i = 0; i < c_bucketCount; i++) {
+        buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+      }
+      sum += shard.sum.load(std::memory_order_relaxed);
+      min = std::min(min, shard.min.load(std::memory_order_relaxed));
+      summary.max = std::max(summary.max, shard.max.load(std::memory_order_relaxed));
+    }
+
+    //the bucket counts are the source of truth, the shard totals can be a record ahead while reading
+    for (uint64_t bucket: buckets) {
+      summary.count += bucket;
+    }
+    if (summary.count == 0)
+      return HistogramSummary();
+
+    summary.min = min;
+    summary.mean = (double) sum / (double) summary.count;
+
+    const std::array<double, 4> quantiles = {0.5, 0.9, 0.99, 0.999};
+    std::array<uint64_t *, 4> results = {&summary.p50, &summary.p90, &summary.p99, &summary.p999};
+    size_t quantile = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < c_bucketCount && quantile < quantiles.size(); i++) {
+      seen += buckets[i];
+      while (quantile < quantiles.size() && (double) seen >= quantiles[quantile] * (double) summary.count && buckets[i] > 0) {
+        //report the middle of the bucket, clamped to what was actually recorded
+        const uint64_t lower = getBucketLowerBound(i);
+        const uint64_t middle = lower + (getBucketUpperBound(i) - lower) / 2;
+        *results[quantile] = std::clamp(middle, summary.min, summary.max);
+        quantile++;
+      }
+    }
+    return summary;
+  }
+
+  void Histogram::reset() {
+    for (Shard &shard: m_shards) {
+      for (auto &bucket: shard.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+      shard.count.store(0, std::memory_order_relaxed);
+      shard.sum.store(0, std::memory_order_relaxed);
+      shard.min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+      shard.max.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  //REGISTRY
+  Counter &StatsRegistry::counter(const std::string &name) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto &counter = s_counters[name];
+    if (counter == nullptr) {
+      counter = std::make_unique<Counter>();
+      publish(name, StatTypeCounter, counter.get());
+    }
+    return *counter;
+  }
+
+  Gauge &StatsRegistry::gauge(const std::string &name) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto &gauge = s_gauges[name];
+    if (gauge == nullptr) {
+      gauge = std::make_unique<Gauge>();
+      publish(name, StatTypeGauge, gauge.get());
+    }
+    return *gauge;
+  }
+
+  Histogram &StatsRegistry::histogram(const std::string &name, const std::string &unit) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto &histogram = s_histograms[name];
+    if (histogram == nullptr) {
+      histogram = std::make_unique<Histogram>(unit);
+      publish(name, StatTypeHistogram, histogram.get());
+    }
+    return *histogram;
+  }
+
+  bool StatsRegistry::exportJson(const std::filesystem::path &path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      CORE_ERROR("Unable to write stats: " + path.string());
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    out << "{\n  \"counters\": {";
+    const char *separator = "\n";
+    for (const auto &[name, counter]: s_counters) {
+      out << separator << "    \"" << escape(name) << "\": " << counter->get();
+      separator = ",\n";
+    }
+
+    out << "\n  },\n  \"gauges\": {";
+    separator = "\n";
+    for (const auto &[name, gauge]: s_gauges) {
+      out << separator << "    \"" << escape(name) << "\": " << fmt::format("{:.4f}", gauge->get());
+      separator = ",\n";
+    }
+
+    out << "\n  },\n  \"histograms\": {";
+    separator = "\n";
+    for (const auto &[name, histogram]: s_histograms) {
+      const HistogramSummary summary = histogram->getSummary();
+      out << separator << "    \"" << escape(name) << "\": "
+          << fmt::format("{{\"unit\": \"{}\", \"count\": {}, \"min\": {}, \"max\": {}, \"mean\": {:.2f}, \"p50\": {}, \"p90\": {}, \"p99\": {}, \"p999\": {}}}",
+                         escape(histogram->getUnit()), summary.count, summary.min, summary.max, summary.mean, summary.p50, summary.p90, summary.p99,
+                         summary.p999);
+      separator = ",\n";
+    }
+    out << "\n  }\n}\n";
+    out.close();
+
+    CORE_INFO("Wrote {0} stats to {1}", s_counters.size() + s_gauges.size() + s_histograms.size(), path.string());
+    return true;
+  }
+
+  std::string StatsRegistry::exportPrometheus() {
+    std::vector<const PublishedStat *> stats;
+    for (const PublishedStat *stat = s_published.load(std::memory_order_acquire); stat != nullptr; stat = stat->next) {
+      stats.push_back(stat);
+    }
+    std::ranges::sort(stats, {}, &PublishedStat::name);
+
+    std::string out;
+    for (const PublishedStat *stat: stats) {
+      std::string name = "hummingbird_" + sanitize(stat->name);
+      switch (stat->type) {
+        case StatTypeCounter: {
+          name += "_total";
+          fmt::format_to(std::back_inserter(out), "# TYPE {0} counter\n{0} {1}\n", name, ((const Counter *) stat->stat)->get());
+          break;
+        }
+        case StatTypeGauge: {
+          fmt::format_to(std::back_inserter(out), "# TYPE {0} gauge\n{0} ", name);
+          writePrometheusValue(out, ((const Gauge *) stat->stat)->get());
+          out += '\n';
+          break;
+        }
+        case StatTypeHistogram: {
+          const auto *histogram = (const Histogram *) stat->stat;
+          //Prometheus wants base units, the registry records times in whatever unit the caller picked
+          double scale = 1.0;
+          if (histogram->getUnit() == "us") {
+            scale = 1e-6;
+            name += "_seconds";
+          } else if (histogram->getUnit() == "ms") {
+            scale = 1e-3;
+            name += "_seconds";
+          } else if (!histogram->getUnit().empty()) {
+            name += "_" + sanitize(histogram->getUnit());
+          }
+
+          const HistogramSummary summary = histogram->getSummary();
+          fmt::format_to(std::back_inserter(out), "# TYPE {0} summary\n", name);
+          const std::array<std::pair<const char *, uint64_t>, 4> quantiles = {{{"0.5", summary.p50}, {"0.9", summary.p90}, {"0.99", summary.p99}, {"0.999", summary.p999}}};
+          for (const auto &[quantile, value]: quantiles) {
+            fmt::format_to(std::back_inserter(out), "{0}{{quantile=\"{1}\"}} ", name, quantile);
+            writePrometheusValue(out, (double) value * scale);
+            out += '\n';
+          }
+          fmt::format_to(std::back_inserter(out), "{0}_sum ", name);
+          writePrometheusValue(out, summary.mean * (double) summary.count * scale);
+          fmt::format_to(std::back_inserter(out), "\n{0}_count {1}\n", name, summary.count);
+          break;
+        }
+      }
+    }
+    return out;
+  }
+
+  void StatsRegistry::publish(const std::string &name, StatType type, const void *stat) {
+    const PublishedStat &published = s_publishedStats.emplace_back(PublishedStat{name, type, stat, s_published.load(std::memory_order_relaxed)});
+    s_published.store(&published, std::memory_order_release);
+  }
+
+  void StatsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (auto &[name, counter]: s_counters) {
+      counter->reset();
+    }
+    for (auto &[name, histogram]: s_histograms) {
+      histogram->reset();
+    }
+  }
+
+  void StatsRegistry::forEachCounter(const std::function<void(const std::string &, const Counter &)> &fn) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (const auto &[name, counter]: s_counters) {
+      fn(name, *counter);
+    }
+  }
+
+  void StatsRegistry::forEachGauge(const std::function<void(const std::string &, const Gauge &)> &fn) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (const auto &[name, gauge]: s_gauges) {
+      fn(name, *gauge);
+    }
+  }
+
+  void StatsRegistry::forEachHistogram(const std::function<void(const std::string &, const Histogram &)> &fn) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (const auto &[name, histogram]: s_histograms) {
+      fn(name, *histogram);
+    }
+  }
+}// namespace HummingBirdCore::Metrics
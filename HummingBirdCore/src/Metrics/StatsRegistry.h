@@ -0,0 +1,185 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <map>
+
+namespace HummingBirdCore::Metrics {
+  static constexpr size_t c_shardCount = 8;
+
+  /**
+   * @brief Spreads threads over the shards so concurrent updates do not fight over one cache line.
+   */
+  size_t getThreadShard();
+
+  /**
+   * @brief Monotonic count, every thread adds to its own shard and readers sum them.
+   */
+  class Counter {
+public:
+    void add(int64_t value = 1) { m_shards[getThreadShard()].value.fetch_add(value, std::memory_order_relaxed); }
+    int64_t get() const;
+    void reset();
+
+private:
+    struct alignas(64) Shard {
+      std::atomic<int64_t> value = 0;
+    };
+    std::array<Shard, c_shardCount> m_shards = {};
+  };
+
+  /**
+   * @brief Last written value wins.
+   */
+  class Gauge {
+public:
+    void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    double get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value = 0.0;
+  };
+
+  struct HistogramSummary {
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+  };
+
+  /**
+   * @brief Log-linear histogram in the style of HdrHistogram.
+   *
+   * Values below 32 get their own bucket, above that every power of two is split into 16 buckets, so any recorded
+   * value is reported within about 6% while the whole 64 bit range fits in under a thousand buckets. Recording is
+   * a couple of relaxed atomics on the calling thread's shard, percentiles are computed when reading.
+   */
+  class Histogram {
+public:
+    explicit Histogram(std::string unit) : m_unit(std::move(unit)) {}
+
+    void record(uint64_t value);
+    HistogramSummary getSummary() const;
+    void reset();
+
+    const std::string &getUnit() const { return m_unit; }
+
+    static size_t getBucketIndex(uint64_t value);
+    static uint64_t getBucketLowerBound(size_t index);
+    static uint64_t getBucketUpperBound(size_t index);
+
+public:
+    static constexpr int c_subBucketBits = 5;
+    static constexpr size_t c_linearBuckets = 1 << c_subBucketBits;
+    static constexpr size_t c_subBuckets = c_linearBuckets / 2;
+    static constexpr size_t c_bucketCount = c_linearBuckets + (64 - c_subBucketBits) * c_subBuckets;
+
+private:
+    struct alignas(64) Shard {
+      std::array<std::atomic<uint64_t>, c_bucketCount> buckets = {};
+      std::atomic<uint64_t> count = 0;
+      std::atomic<uint64_t> sum = 0;
+      std::atomic<uint64_t> min = std::numeric_limits<uint64_t>::max();
+      std::atomic<uint64_t> max = 0;
+    };
+
+    std::string m_unit;
+    std::array<Shard, c_shardCount> m_shards = {};
+  };
+
+  /**
+   * @brief Records the lifetime of the scope in microseconds.
+   */
+  class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram &histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+      m_histogram.record((uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    Histogram &m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  /**
+   * @brief Named counters, gauges and histograms shared by the whole process.
+   *
+   * Looking a stat up takes a lock, hot paths look it up once and keep the reference, stats are never removed.
+   * Names are dotted paths like "threadpool.tasks", the export sorts on them so two runs diff cleanly.
+   */
+  class StatsRegistry {
+public:
+    static Counter &counter(const std::string &name);
+    static Gauge &gauge(const std::string &name);
+    static Histogram &histogram(const std::string &name, const std::string &unit = "us");
+
+    /**
+     * @brief Writes every stat to a json file:
+     * {"counters":{name:value}, "gauges":{name:value}, "histograms":{name:{"unit","count","min","max","mean","p50","p90","p99","p999"}}}
+     * @return true when the file was written
+     */
+    static bool exportJson(const std::filesystem::path &path);
+
+    /**
+     * @brief Every stat in the Prometheus text exposition format, names prefixed with "hummingbird_" and dots
+     * replaced by underscores. Histograms are written as summaries in seconds when their unit is a time.
+     * Does not take the registry lock, safe to call from any thread while the UI keeps registering stats.
+     */
+    static std::string exportPrometheus();
+
+    /**
+     * @brief Zeroes counters and histograms, gauges keep their value.
+     */
+    static void reset();
+
+    /**
+     * @brief Calls fn for every stat in name order, for the metrics window.
+     */
+    static void forEachCounter(const std::function<void(const std::string &, const Counter &)> &fn);
+    static void forEachGauge(const std::function<void(const std::string &, const Gauge &)> &fn);
+    static void forEachHistogram(const std::function<void(const std::string &, const Histogram &)> &fn);
+
+private:
+    enum StatType {
+      StatTypeCounter,
+      StatTypeGauge,
+      StatTypeHistogram
+    };
+
+    /**
+     * @brief Append only list of every stat, readers walk it from s_published without the lock.
+     */
+    struct PublishedStat {
+      std::string name;
+      StatType type;
+      const void *stat;
+      const PublishedStat *next;
+    };
+
+    //called with s_mutex held when a stat is created
+    static void publish(const std::string &name, StatType type, const void *stat);
+
+private:
+    inline static std::mutex s_mutex;
+    inline static std::map<std::string, std::unique_ptr<Counter>> s_counters = {};
+    inline static std::map<std::string, std::unique_ptr<Gauge>> s_gauges = {};
+    inline static std::map<std::string, std::unique_ptr<Histogram>> s_histograms = {};
+    //a deque never moves its elements, the next pointers stay valid
+    inline static std::deque<PublishedStat> s_publishedStats = {};
+    inline static std::atomic<const PublishedStat *> s_published = nullptr;
+  };
+}// namespace HummingBirdCore::Metrics
@@ -64,11 +64,11 @@
 /////HUMMINGBIRD CORE/////
 //main
 #include "Log.h"
+#include "Profiling/Profiler.h"
 
 //utils
 #include "Utils/Utils.h"
 #include "Utils/UUID.h"
-#include "Utils/Input.h"
 #include "Utils/UIUtils.h"
 
 //rendering
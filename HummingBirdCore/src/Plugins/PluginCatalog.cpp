@@ -0,0 +1,240 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "PluginCatalog.h"
+
+#include <dlfcn.h>
+
+namespace HummingBirdCore::Plugins {
+  namespace {
+    std::string trim(std::string_view value) {
+      const size_t first = value.find_first_not_of(" \t\r");
+      if (first == std::string_view::npos)
+        return "";
+      const size_t last = value.find_last_not_of(" \t\r");
+      return std::string(value.substr(first, last - first + 1));
+    }
+
+    std::vector<std::string> splitList(std::string_view value) {
+      std::vector<std::string> items;
+      size_t start = 0;
+      while (start <= value.size()) {
+        size_t end = value.find(',', start);
+        if (end == std::string_view::npos)
+          end = value.size();
+        std::string item = trim(value.substr(start, end - start));
+        if (!item.empty())
+          items.push_back(std::move(item));
+        start = end + 1;
+      }
+      return items;
+    }
+  }// namespace
+
+  void PluginCatalog::discover(const std::vector<std::filesystem::path> &libraries, const std::filesystem::path &directory) {
+    std::vector<std::filesystem::path> paths = libraries;
+    std::error_code ec;
+    if (std::filesystem::exists(directory, ec)) {
+      const size_t count = paths.size();
+      for (const auto &entry: std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".dylib")
+          paths.push_back(entry.path());
+      }
+      if (paths.size() == count)
+        CORE_ERROR("No plugins found in plugins directory");
+    }
+
+    for (const auto &path: paths) {
+      Manifest manifest;
+      std::filesystem::path manifestPath = path;
+      manifestPath.replace_extension(".manifest");
+      if (!readManifest(manifestPath, manifest))
+        manifest.name = path.stem().string();
+      manifest.library = path;
+
+      const auto duplicate = std::find_if(m_plugins.begin(), m_plugins.end(), [&](const Manifest &plugin) { return plugin.name == manifest.name; });
+      if (duplicate != m_plugins.end()) {
+        CORE_ERROR("Skipping plugin {0}, {1} already uses the name {2}", path.string(), duplicate->library.string(), manifest.name);
+        continue;
+      }
+      m_plugins.push_back(std::move(manifest));
+    }
+    sort();
+  }
+
+  bool PluginCatalog::readManifest(const std::filesystem::path &path, Manifest &manifest) {
+    std::ifstream file(path);
+    if (!file.is_open())
+      return false;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+      lineNumber++;
+      const std::string content = trim(line);
+      if (content.empty() || content.starts_with('#'))
+        continue;
+
+      const size_t separator = content.find('=');
+      if (separator == std::string::npos) {
+        CORE_WARN("Ignoring line {0} of {1}: expected key = value", lineNumber, path.string());
+        continue;
+      }
+      const std::string key = trim(std::string_view(content).substr(0, separator));
+      const std::string value = trim(std::string_view(content).substr(separator + 1));
+
+      if (key == "name") {
+        manifest.name = value;
+      } else if (key == "version") {
+        manifest.version = value;
+      } else if (key == "dependencies") {
+        manifest.dependencies = splitList(value);
+      } else if (key == "lazy") {
+        manifest.lazy = value == "true" || value == "1";
+      } else if (key == "command") {
+        const size_t slash = value.find('/');
+        if (slash == std::string::npos) {
+          CORE_WARN("Ignoring line {0} of {1}: expected command = category/name", lineNumber, path.string());
+          continue;
+        }
+        manifest.commands.push_back({trim(std::string_view(value).substr(0, slash)), trim(std::string_view(value).substr(slash + 1))});
+      } else if (key == "window") {
+        manifest.windows.push_back(value);
+      } else {
+        CORE_WARN("Ignoring unknown key {0} in {1}", key, path.string());
+      }
+    }
+
+    if (manifest.name.empty()) {
+      CORE_ERROR("Plugin manifest {0} has no name", path.string());
+      return false;
+    }
+    return true;
+  }
+
+  void PluginCatalog::sort() {
+    //Kahn's algorithm one level at a time, the discovery order is kept within a level
+    std::vector<std::vector<size_t>> dependents(m_plugins.size());
+    std::vector<std::vector<size_t>> dependencies(m_plugins.size());
+    std::vector<size_t> remaining(m_plugins.size(), 0);
+    std::vector<bool> dropped(m_plugins.size(), false);
+    for (size_t i = 0; i < m_plugins.size(); i++) {
+      for (const std::string &dependency: m_plugins[i].dependencies) {
+        const auto it = std::find_if(m_plugins.begin(), m_plugins.end(), [&](const Manifest &plugin) { return plugin.name == dependency; });
+        if (it == m_plugins.end()) {
+          CORE_ERROR("Skipping plugin {0}, it depends on {1} which is not installed", m_plugins[i].name, dependency);
+          dropped[i] = true;
+          continue;
+        }
+        dependents[(size_t) (it - m_plugins.begin())].push_back(i);
+        dependencies[i].push_back((size_t) (it - m_plugins.begin()));
+        remaining[i]++;
+      }
+    }
+
+    std::vector<size_t> level;
+    for (size_t i = 0; i < m_plugins.size(); i++) {
+      if (remaining[i] == 0)
+        level.push_back(i);
+    }
+
+    std::vector<size_t> order;
+    std::vector<std::vector<size_t>> levels;
+    while (!level.empty()) {
+      std::vector<size_t> next;
+      std::vector<size_t> kept;
+      for (size_t index: level) {
+        //a dropped plugin takes everything that depends on it along
+        for (size_t dependent: dependents[index]) {
+          if (dropped[index] && !dropped[dependent]) {
+            CORE_ERROR("Skipping plugin {0}, its dependency {1} is skipped", m_plugins[dependent].name, m_plugins[index].name);
+            dropped[dependent] = true;
+          }
+          if (--remaining[dependent] == 0)
+            next.push_back(dependent);
+        }
+        if (!dropped[index]) {
+          order.push_back(index);
+          kept.push_back(order.size() - 1);
+        }
+      }
+      std::sort(next.begin(), next.end());
+      if (!kept.empty())
+        levels.push_back(std::move(kept));
+      level = std::move(next);
+    }
+
+    //what is left is in a cycle, or depends on a plugin that is
+    for (size_t i = 0; i < m_plugins.size(); i++) {
+      if (remaining[i] == 0)
+        continue;
+      if (isInCycle(i, dependencies, remaining)) {
+        CORE_ERROR("Skipping plugin {0}, its dependencies form a cycle", m_plugins[i].name);
+        continue;
+      }
+      const auto skipped = std::find_if(dependencies[i].begin(), dependencies[i].end(), [&](size_t dependency) { return remaining[dependency] > 0; });
+      CORE_ERROR("Skipping plugin {0}, its dependency {1} is skipped", m_plugins[i].name, m_plugins[*skipped].name);
+    }
+
+    std::vector<Manifest> sorted;
+    sorted.reserve(order.size());
+    for (size_t index: order) {
+      sorted.push_back(std::move(m_plugins[index]));
+    }
+    m_plugins = std::move(sorted);
+    m_levels = std::move(levels);
+  }
+
+  bool PluginCatalog::isInCycle(size_t plugin, const std::vector<std::vector<size_t>> &dependencies, const std::vector<size_t> &remaining) {
+    //only the plugins Kahn's algorithm could not order can be part of a cycle
+    std::vector<bool> visited(dependencies.size(), false);
+    std::vector<size_t> stack = {plugin};
+    while (!stack.empty()) {
+      const size_t current = stack.back();
+      stack.pop_back();
+      for (size_t dependency: dependencies[current]) {
+        if (remaining[dependency] == 0)
+          continue;
+        if (dependency == plugin)
+          return true;
+        if (!visited[dependency]) {
+          visited[dependency] = true;
+          stack.push_back(dependency);
+        }
+      }
+    }
+    return false;
+  }
+
+  void PluginCatalog::preload(Threading::ThreadPool &pool, const std::vector<std::filesystem::path> &hostLibraries) {
+    //the host libraries go with the first level, also when there are no plugins
+    for (size_t level = 0; level < std::max<size_t>(m_levels.size(), 1); level++) {
+      std::vector<std::filesystem::path> libraries = level == 0 ? hostLibraries : std::vector<std::filesystem::path>();
+      if (level < m_levels.size()) {
+        for (size_t index: m_levels[level]) {
+          if (!m_plugins[index].lazy)
+            libraries.push_back(m_plugins[index].library);
+        }
+      }
+
+      std::vector<Threading::TaskHandle<void *>> tasks;
+      tasks.reserve(libraries.size());
+      for (const auto &library: libraries) {
+        tasks.push_back(pool.submit([library] { return dlopen(library.string().c_str(), RTLD_LAZY); }));
+      }
+      //the next level may need symbols from this one
+      for (const auto &task: tasks) {
+        if (void *handle = task.get(); handle != nullptr)
+          m_handles.push_back(handle);
+      }
+    }
+  }
+
+  void PluginCatalog::release() {
+    for (void *handle: m_handles) {
+      dlclose(handle);
+    }
+    m_handles.clear();
+  }
+}// namespace HummingBirdCore::Plugins
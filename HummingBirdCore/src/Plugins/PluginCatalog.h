@@ -0,0 +1,73 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <IPlugin.h>
+#include "Threading/ThreadPool.h"
+
+namespace HummingBirdCore::Plugins {
+  using Manifest = HummingBird::Plugins::PluginManifest;
+
+  /**
+   * @brief The plugins to load and the order to load them in.
+   *
+   * Every library can have a manifest next to it with the same name and a .manifest extension:
+   *
+   *   # comments start with a #
+   *   name = Example
+   *   version = 1.0.0
+   *   dependencies = Core Tools, Other
+   *   lazy = true
+   *   command = Example/Open Example
+   *   window = Example Window
+   *
+   * command and window can be repeated. A library without a manifest is loaded at startup under its file name.
+   * Plugins are ordered so dependencies come first, a plugin with a missing dependency or in a cycle is left out.
+   */
+  class PluginCatalog {
+public:
+    /**
+     * @brief Reads the manifest of every library, the .dylib files in directory come after libraries.
+     */
+    void discover(const std::vector<std::filesystem::path> &libraries, const std::filesystem::path &directory);
+
+    /**
+     * @brief dlopens every plugin that is not lazy, the plugins of one dependency level at the same time.
+     * The dlopen on the main thread later on only bumps the reference count. Waits on the pool, call it from a worker.
+     * Static constructors of the plugins run on the workers, see the load contract on IPlugin.
+     * @param hostLibraries Libraries the host loads itself, preloaded with the first level
+     */
+    void preload(Threading::ThreadPool &pool, const std::vector<std::filesystem::path> &hostLibraries = {});
+
+    /**
+     * @brief Drops the references preload() took, once the plugins are loaded for real.
+     */
+    void release();
+
+    /**
+     * @brief Dependencies come before the plugins that need them.
+     */
+    const std::vector<Manifest> &getPlugins() const { return m_plugins; }
+
+    /**
+     * @return false when the manifest is missing or can not be read
+     */
+    static bool readManifest(const std::filesystem::path &path, Manifest &manifest);
+
+private:
+    void sort();
+    /**
+     * @return true when plugin can reach itself through dependencies that could not be ordered
+     */
+    static bool isInCycle(size_t plugin, const std::vector<std::vector<size_t>> &dependencies, const std::vector<size_t> &remaining);
+
+private:
+    std::vector<Manifest> m_plugins;
+    //indices into m_plugins, a plugin only depends on plugins in earlier levels
+    std::vector<std::vector<size_t>> m_levels;
+    std::vector<void *> m_handles;
+  };
+}// namespace HummingBirdCore::Plugins
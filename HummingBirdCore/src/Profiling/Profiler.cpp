@@ -0,0 +1,186 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "Profiler.h"
+
+#include <bit>
+
+namespace HummingBirdCore::Profiling {
+  namespace {
+    constexpr float c_averageWeight = 0.05f;
+
+    void writeEscaped(std::ofstream &out, std::string_view str) {
+      for (char c: str) {
+        switch (c) {
+          case '"':
+            out << "\\\"";
+            break;
+          case '\\':
+            out << "\\\\";
+            break;
+          default:
+            if ((unsigned char) c >= 0x20)
+              out << c;
+            break;
+        }
+      }
+    }
+  }// namespace
+
+  namespace {
+    //set before the thread has a ring, picked up once it records its first zone
+    thread_local std::string t_threadName;
+    thread_local ThreadBuffer *t_buffer = nullptr;
+  }// namespace
+
+  void ThreadBuffer::copyCommitted(uint64_t first, std::vector<ZoneEvent> &out) const {
+    const uint64_t end = head.load(std::memory_order_acquire);
+    const size_t offset = out.size();
+    const uint64_t start = std::max(first, end > capacity ? end - capacity : 0);
+    for (uint64_t i = start; i < end; i++) {
+      const ZoneSlot &slot = events[i & mask];
+      out.push_back({slot.name.load(std::memory_order_relaxed), slot.startNs.load(std::memory_order_relaxed),
+                     slot.endNs.load(std::memory_order_relaxed), slot.depth.load(std::memory_order_relaxed)});
+    }
+
+    //a slot the owner started to overwrite while it was copied may be torn, drop those from the front
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t overwritten = reserved.load(std::memory_order_relaxed);
+    if (overwritten > capacity && overwritten - capacity > start) {
+      const uint64_t torn = std::min(overwritten - capacity, end) - start;
+      out.erase(out.begin() + (ptrdiff_t) offset, out.begin() + (ptrdiff_t) (offset + torn));
+    }
+  }
+
+  ThreadBuffer &Profiler::getThreadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+      auto newBuffer = std::make_shared<ThreadBuffer>(s_ringCapacity.load(std::memory_order_relaxed));
+      newBuffer->threadId = s_nextThreadId++;
+      if (!t_threadName.empty())
+        newBuffer->threadName = t_threadName;
+      else
+        newBuffer->threadName = newBuffer->threadId == 0 ? "Main" : "Thread " + std::to_string(newBuffer->threadId);
+
+      std::lock_guard<std::mutex> lock(s_buffersMutex);
+      s_buffers.push_back(newBuffer);
+      t_buffer = newBuffer.get();
+      return newBuffer;
+    }();
+    return *buffer;
+  }
+
+  void Profiler::setThreadName(const std::string &name) {
+    t_threadName = name;
+    if (t_buffer == nullptr)
+      return;
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    t_buffer->threadName = name;
+  }
+
+  void Profiler::setRingCapacity(uint64_t zones) {
+    s_ringCapacity = std::bit_ceil(std::max<uint64_t>(zones, 1));
+  }
+
+  void Profiler::beginFrame() {
+    s_frameStartNs = nowNs();
+    s_frameStartHead = getThreadBuffer().head.load(std::memory_order_relaxed);
+  }
+
+  void Profiler::endFrame() {
+    const ThreadBuffer &buffer = getThreadBuffer();
+
+    static std::vector<float> frameSums;
+    frameSums.assign(s_zoneStats.size(), 0.0f);
+    for (auto &stats: s_zoneStats) {
+      stats.calls = 0;
+    }
+
+    //zones finish inner first, sort on start time so new zones show up under their parent
+    static std::vector<ZoneEvent> frameEvents;
+    frameEvents.clear();
+    buffer.copyCommitted(s_frameStartHead, frameEvents);
+    std::sort(frameEvents.begin(), frameEvents.end(), [](const ZoneEvent &a, const ZoneEvent &b) { return a.startNs < b.startNs; });
+
+    for (const ZoneEvent &event: frameEvents) {
+      const std::string_view name(event.name);
+
+      auto it = s_zoneIndices.find(name);
+      if (it == s_zoneIndices.end()) {
+        it = s_zoneIndices.emplace(name, s_zoneStats.size()).first;
+        s_zoneStats.push_back(ZoneStats{std::string(name)});
+        frameSums.push_back(0.0f);
+      }
+
+      ZoneStats &stats = s_zoneStats[it->second];
+      stats.calls++;
+      stats.depth = event.depth;
+      frameSums[it->second] += (float) (event.endNs - event.startNs) / 1e6f;
+    }
+
+    for (size_t i = 0; i < s_zoneStats.size(); i++) {
+      ZoneStats &stats = s_zoneStats[i];
+      stats.lastMs = frameSums[i];
+      stats.avgMs = stats.avgMs == 0.0f ? stats.lastMs : stats.avgMs + (stats.lastMs - stats.avgMs) * c_averageWeight;
+      stats.maxMs = std::max(stats.maxMs, stats.lastMs);
+    }
+
+    s_lastFrameMs = (float) (nowNs() - s_frameStartNs) / 1e6f;
+    s_frameTimes[s_frameTimesOffset] = s_lastFrameMs;
+    s_frameTimesOffset = (s_frameTimesOffset + 1) % c_frameHistorySize;
+  }
+
+  void Profiler::resetStats() {
+    s_zoneStats.clear();
+    s_zoneIndices.clear();
+    s_frameTimes.fill(0.0f);
+    s_frameTimesOffset = 0;
+  }
+
+  bool Profiler::dumpChromeTrace(const std::filesystem::path &path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+      CORE_ERROR("Unable to open trace file: " + path.string());
+      return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+      std::lock_guard<std::mutex> lock(s_buffersMutex);
+      buffers = s_buffers;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    size_t eventCount = 0;
+    std::vector<ZoneEvent> events;
+    for (const auto &buffer: buffers) {
+      if (!first)
+        out << ",";
+      first = false;
+      out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"";
+      writeEscaped(out, buffer->threadName);
+      out << "\"}}";
+
+      //the other threads keep recording, only the zones they committed and did not overwrite meanwhile are written
+      events.clear();
+      buffer->copyCommitted(0, events);
+      for (const ZoneEvent &event: events) {
+        if (event.name == nullptr)
+          continue;
+
+        out << ",{\"name\":\"";
+        writeEscaped(out, event.name);
+        out << "\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"ts\":" << fmt::format("{:.3f}", (double) event.startNs / 1e3)
+            << ",\"dur\":" << fmt::format("{:.3f}", (double) (event.endNs - event.startNs) / 1e3) << "}";
+        eventCount++;
+      }
+    }
+    out << "]}\n";
+    out.close();
+
+    CORE_INFO("Wrote {0} zones to trace {1}", eventCount, path.string());
+    return true;
+  }
+}// namespace HummingBirdCore::Profiling
@@ -0,0 +1,173 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <array>
+#include <atomic>
+#include <string_view>
+
+namespace HummingBirdCore::Profiling {
+  struct ZoneEvent {
+    const char *name = nullptr;
+    int64_t startNs = 0;
+    int64_t endNs = 0;
+    uint32_t depth = 0;
+  };
+
+  /**
+   * @brief One ring slot, atomic so a reader on another thread never races the owner that overwrites it.
+   * Relaxed loads and stores, they compile to plain moves.
+   */
+  struct ZoneSlot {
+    std::atomic<const char *> name = nullptr;
+    std::atomic<int64_t> startNs = 0;
+    std::atomic<int64_t> endNs = 0;
+    std::atomic<uint32_t> depth = 0;
+  };
+
+  /**
+   * @brief Ring buffer of finished zones, one per thread, allocated when the thread records its first zone.
+   *
+   * Only the owning thread writes. It bumps reserved before it overwrites a slot and head once the slot is written,
+   * a reader copies up to head and then drops whatever reserved says was overwritten while it was copying.
+   */
+  struct ThreadBuffer {
+    explicit ThreadBuffer(uint64_t capacity) : capacity(capacity), mask(capacity - 1), events(std::make_unique<ZoneSlot[]>(capacity)) {}
+
+    void push(const char *name, int64_t startNs, int64_t endNs, uint32_t zoneDepth) {
+      const uint64_t index = head.load(std::memory_order_relaxed);
+      reserved.store(index + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      ZoneSlot &slot = events[index & mask];
+      slot.name.store(name, std::memory_order_relaxed);
+      slot.startNs.store(startNs, std::memory_order_relaxed);
+      slot.endNs.store(endNs, std::memory_order_relaxed);
+      slot.depth.store(zoneDepth, std::memory_order_relaxed);
+      head.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Appends the zones from index first on that are still in the ring, oldest first. Safe from any thread.
+     */
+    void copyCommitted(uint64_t first, std::vector<ZoneEvent> &out) const;
+
+    const uint64_t capacity;
+    const uint64_t mask;
+    std::unique_ptr<ZoneSlot[]> events;
+    std::atomic<uint64_t> reserved = 0;
+    std::atomic<uint64_t> head = 0;
+    uint32_t depth = 0;
+    uint32_t threadId = 0;
+    std::string threadName;
+  };
+
+  struct ZoneStats {
+    std::string name;
+    float lastMs = 0.0f;
+    float avgMs = 0.0f;
+    float maxMs = 0.0f;
+    uint32_t calls = 0;
+    uint32_t depth = 0;
+  };
+
+  class Profiler {
+public:
+    static constexpr int c_frameHistorySize = 240;
+    //4096 zones of 32 bytes, 128 KB for every thread that records zones
+    static constexpr uint64_t c_defaultRingCapacity = 1 << 12;
+
+    /**
+     * @brief Marks the start of a frame on the main thread.
+     */
+    static void beginFrame();
+
+    /**
+     * @brief Collects the zones the main thread recorded since beginFrame() and updates the frame time history.
+     */
+    static void endFrame();
+
+    /**
+     * @brief Writes every zone still in the ring buffers of all threads to a Chrome/Perfetto trace file.
+     * @param path The json file to write
+     * @return true when the file was written
+     */
+    static bool dumpChromeTrace(const std::filesystem::path &path);
+
+    /**
+     * @brief Names the calling thread in trace captures, without allocating its ring.
+     */
+    static void setThreadName(const std::string &name);
+
+    /**
+     * @brief Zones every thread keeps for dumpChromeTrace(), rounded up to a power of two.
+     * Applies to the threads that record their first zone afterwards, call it at startup.
+     */
+    static void setRingCapacity(uint64_t zones);
+
+    static void resetStats();
+
+    static const std::vector<ZoneStats> &getZoneStats() { return s_zoneStats; }
+    static const std::array<float, c_frameHistorySize> &getFrameTimes() { return s_frameTimes; }
+    static int getFrameTimesOffset() { return s_frameTimesOffset; }
+    static float getLastFrameTime() { return s_lastFrameMs; }
+
+    static ThreadBuffer &getThreadBuffer();
+
+    static int64_t nowNs() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    inline static std::mutex s_buffersMutex;
+    inline static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers = {};
+    inline static std::atomic<uint32_t> s_nextThreadId = 0;
+    inline static std::atomic<uint64_t> s_ringCapacity = c_defaultRingCapacity;
+
+    //main thread only
+    inline static int64_t s_frameStartNs = 0;
+    inline static uint64_t s_frameStartHead = 0;
+    inline static std::vector<ZoneStats> s_zoneStats = {};
+    inline static std::unordered_map<std::string_view, size_t> s_zoneIndices = {};
+    inline static std::array<float, c_frameHistorySize> s_frameTimes = {};
+    inline static int s_frameTimesOffset = 0;
+    inline static float s_lastFrameMs = 0.0f;
+  };
+
+  class ScopedZone {
+public:
+    explicit ScopedZone(const char *name) : m_name(name), m_buffer(Profiler::getThreadBuffer()) {
+      m_depth = m_buffer.depth++;
+      m_startNs = Profiler::nowNs();
+    }
+
+    ~ScopedZone() {
+      const int64_t end = Profiler::nowNs();
+      m_buffer.depth--;
+      m_buffer.push(m_name, m_startNs, end, m_depth);
+    }
+
+    ScopedZone(const ScopedZone &) = delete;
+    ScopedZone &operator=(const ScopedZone &) = delete;
+
+private:
+    const char *m_name;
+    ThreadBuffer &m_buffer;
+    int64_t m_startNs = 0;
+    uint32_t m_depth = 0;
+  };
+}// namespace HummingBirdCore::Profiling
+
+#define HB_PROFILE_CONCAT_INNER(a, b) a##b
+#define HB_PROFILE_CONCAT(a, b) HB_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef HUMMINGBIRD_PROFILE
+#define HB_PROFILE_SCOPE(name) ::HummingBirdCore::Profiling::ScopedZone HB_PROFILE_CONCAT(hbProfileZone, __LINE__)(name)
+#define HB_PROFILE_FUNCTION() HB_PROFILE_SCOPE(__PRETTY_FUNCTION__)
+#else
+#define HB_PROFILE_SCOPE(name)
+#define HB_PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,231 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "SamplingProfiler.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+namespace HummingBirdCore::Profiling {
+  namespace {
+    //a frame pointer further than this above the stack pointer is not on this stack
+    constexpr uintptr_t c_maxStackSpan = 8 * 1024 * 1024;
+
+    struct Registers {
+      uintptr_t pc = 0;
+      uintptr_t fp = 0;
+      uintptr_t sp = 0;
+    };
+
+    Registers getRegisters(void *context) {
+      const auto *ucontext = static_cast<const ucontext_t *>(context);
+      Registers registers;
+#if defined(__APPLE__) && defined(__aarch64__)
+      registers = {(uintptr_t) ucontext->uc_mcontext->__ss.__pc, (uintptr_t) ucontext->uc_mcontext->__ss.__fp, (uintptr_t) ucontext->uc_mcontext->__ss.__sp};
+#elif defined(__APPLE__) && defined(__x86_64__)
+      registers = {(uintptr_t) ucontext->uc_mcontext->__ss.__rip, (uintptr_t) ucontext->uc_mcontext->__ss.__rbp, (uintptr_t) ucontext->uc_mcontext->__ss.__rsp};
+#elif defined(__linux__) && defined(__x86_64__)
+      registers = {(uintptr_t) ucontext->uc_mcontext.gregs[REG_RIP], (uintptr_t) ucontext->uc_mcontext.gregs[REG_RBP], (uintptr_t) ucontext->uc_mcontext.gregs[REG_RSP]};
+#elif defined(__linux__) && defined(__aarch64__)
+      registers = {(uintptr_t) ucontext->uc_mcontext.pc, (uintptr_t) ucontext->uc_mcontext.regs[29], (uintptr_t) ucontext->uc_mcontext.sp};
+#else
+      (void) ucontext;
+#endif
+      return registers;
+    }
+
+    /**
+     * @brief Walks the frame pointer chain of the interrupted thread, only reads memory, so it is async-signal-safe.
+     * Every frame record is the caller's frame pointer followed by the return address. A record has to be aligned and
+     * lie between the stack pointer and c_maxStackSpan above it, and callers sit at higher addresses than their callees.
+     * Code built without frame pointers ends the walk early instead of sending it off the stack.
+     */
+    uint32_t walkFramePointers(void *context, void **frames, uint32_t maxDepth) {
+      const Registers registers = getRegisters(context);
+      if (registers.pc == 0)
+        return 0;
+
+      uint32_t depth = 0;
+      frames[depth++] = (void *) registers.pc;
+      uintptr_t fp = registers.fp;
+      const uintptr_t stackEnd = registers.sp + c_maxStackSpan;
+      while (depth < maxDepth && fp >= registers.sp && fp < stackEnd && fp % sizeof(uintptr_t) == 0) {
+        const auto *record = reinterpret_cast<const uintptr_t *>(fp);
+        const uintptr_t returnAddress = record[1];
+        if (returnAddress == 0)
+          break;
+        frames[depth++] = (void *) returnAddress;
+        if (record[0] <= fp)
+          break;
+        fp = record[0];
+      }
+      return depth;
+    }
+
+    /**
+     * @brief The function address belongs to, and its name. The image and offset when the function is not exported.
+     */
+    std::pair<void *, std::string> symbolize(void *address) {
+      Dl_info info = {};
+      if (dladdr(address, &info) == 0)
+        return {address, fmt::format("{0}", address)};
+
+      const std::string image = info.dli_fname != nullptr ? std::filesystem::path(info.dli_fname).filename().string() : "?";
+      //not exported, the image and offset are still enough to look it up with atos or addr2line
+      if (info.dli_sname == nullptr || info.dli_saddr == nullptr)
+        return {address, fmt::format("{0}+0x{1:x}", image, (uintptr_t) address - (uintptr_t) info.dli_fbase)};
+
+      int status = 0;
+      char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      std::string name = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+      free(demangled);
+      return {info.dli_saddr, name + " (" + image + ")"};
+    }
+  }// namespace
+
+  bool SamplingProfiler::start(int frequencyHz) {
+    if (isRunning())
+      return true;
+
+    struct sigaction action = {};
+    action.sa_sigaction = onSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &s_previousAction) == -1) {
+      CORE_ERROR("Unable to install the SIGPROF handler");
+      return false;
+    }
+
+    s_frequency = std::clamp(frequencyHz, 1, 10000);
+    itimerval timer = {};
+    //tv_usec has to stay below a second, 1 Hz is a whole second
+    const int period = 1000000 / s_frequency;
+    timer.it_interval.tv_sec = period / 1000000;
+    timer.it_interval.tv_usec = period % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) == -1) {
+      CORE_ERROR("Unable to start the profiling timer");
+      sigaction(SIGPROF, &s_previousAction, nullptr);
+      return false;
+    }
+
+    s_running = true;
+    CORE_INFO("Sampling profiler started at {0} Hz", s_frequency);
+    return true;
+  }
+
+  void SamplingProfiler::stop() {
+    if (!isRunning())
+      return;
+
+    itimerval timer = {};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    //a signal that is already pending would kill the process with the default action
+    struct sigaction ignore = {};
+    ignore.sa_handler = SIG_IGN;
+    sigaction(SIGPROF, s_previousAction.sa_handler == SIG_DFL ? &ignore : &s_previousAction, nullptr);
+
+    s_running = false;
+    CORE_INFO("Sampling profiler stopped");
+  }
+
+  void SamplingProfiler::onSignal(int, siginfo_t *, void *context) {
+    const int savedErrno = errno;
+    const uint64_t index = s_writeIndex.fetch_add(1, std::memory_order_relaxed);
+    StackSample &sample = s_samples[index % c_capacity];
+    sample.sequence.store(0, std::memory_order_relaxed);
+    //backtrace() may take the loader lock or allocate, the frame pointers of the interrupted context are just memory
+    sample.depth = walkFramePointers(context, sample.frames.data(), StackSample::c_maxDepth);
+    sample.sequence.store(index + 1, std::memory_order_release);
+    errno = savedErrno;
+  }
+
+  void SamplingProfiler::collect() {
+    HB_PROFILE_SCOPE("SamplingProfiler::collect");
+    if (s_nodes.empty())
+      clear();
+
+    const uint64_t writeIndex = s_writeIndex.load(std::memory_order_acquire);
+    //the handlers went around the ring since the last collect
+    if (writeIndex - s_readIndex > c_capacity) {
+      s_dropped += writeIndex - s_readIndex - c_capacity;
+      s_readIndex = writeIndex - c_capacity;
+    }
+
+    std::array<void *, StackSample::c_maxDepth> frames;
+    for (; s_readIndex < writeIndex; s_readIndex++) {
+      const StackSample &sample = s_samples[s_readIndex % c_capacity];
+      const uint64_t sequence = sample.sequence.load(std::memory_order_acquire);
+      //still being written, pick it up next time
+      if (sequence < s_readIndex + 1)
+        break;
+      if (sequence != s_readIndex + 1) {
+        s_dropped++;
+        continue;
+      }
+
+      const uint32_t depth = std::min(sample.depth, StackSample::c_maxDepth);
+      std::copy_n(sample.frames.begin(), depth, frames.begin());
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sample.sequence.load(std::memory_order_relaxed) != sequence) {
+        s_dropped++;
+        continue;
+      }
+      if (depth == 0)
+        continue;
+
+      //outermost frame first, the first frame is the interrupted pc, return addresses point after the call so step back into it
+      uint32_t node = c_rootNode;
+      s_nodes[node].samples++;
+      for (uint32_t i = depth; i-- > 0;) {
+        void *address = i == 0 ? frames[i] : (void *) ((uintptr_t) frames[i] - 1);
+        node = getChild(node, getSymbol(address));
+        s_nodes[node].samples++;
+      }
+      s_nodes[node].selfSamples++;
+    }
+  }
+
+  void SamplingProfiler::clear() {
+    s_nodes.clear();
+    s_symbolNames.clear();
+    s_symbolsByFunction.clear();
+    s_symbolsByAddress.clear();
+    s_dropped = 0;
+    s_readIndex = s_writeIndex.load(std::memory_order_acquire);
+
+    s_symbolNames.emplace_back("all");
+    s_nodes.emplace_back();
+  }
+
+  uint32_t SamplingProfiler::getSymbol(void *address) {
+    if (auto it = s_symbolsByAddress.find(address); it != s_symbolsByAddress.end())
+      return it->second;
+
+    //every address inside a function resolves to the function's start, so all of its samples end up in one node
+    auto [function, name] = symbolize(address);
+    auto [it, inserted] = s_symbolsByFunction.try_emplace(function, (uint32_t) s_symbolNames.size());
+    if (inserted)
+      s_symbolNames.push_back(std::move(name));
+    s_symbolsByAddress.emplace(address, it->second);
+    return it->second;
+  }
+
+  uint32_t SamplingProfiler::getChild(uint32_t node, uint32_t symbol) {
+    for (uint32_t child: s_nodes[node].children) {
+      if (s_nodes[child].symbol == symbol)
+        return child;
+    }
+
+    const uint32_t child = (uint32_t) s_nodes.size();
+    FlameNode &created = s_nodes.emplace_back();
+    created.symbol = symbol;
+    created.parent = node;
+    created.depth = s_nodes[node].depth + 1;
+    s_nodes[node].children.push_back(child);
+    return child;
+  }
+}// namespace HummingBirdCore::Profiling
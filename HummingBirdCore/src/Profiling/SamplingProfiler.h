@@ -0,0 +1,107 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <array>
+#include <atomic>
+#include <csignal>
+
+namespace HummingBirdCore::Profiling {
+  /**
+   * @brief One function in the merged call tree, children are indices into the same node list.
+   */
+  struct FlameNode {
+    uint32_t symbol = 0;
+    uint32_t parent = 0;
+    uint32_t depth = 0;
+    //samples in this function and everything it called
+    uint64_t samples = 0;
+    //samples where this function was on top of the stack
+    uint64_t selfSamples = 0;
+    std::vector<uint32_t> children;
+  };
+
+  /**
+   * @brief Slot in the ring the SIGPROF handler writes to.
+   */
+  struct StackSample {
+    static constexpr uint32_t c_maxDepth = 64;
+
+    //index + 1 once the slot is written, a reader that sees another value lost the slot to a newer sample
+    std::atomic<uint64_t> sequence = 0;
+    uint32_t depth = 0;
+    std::array<void *, c_maxDepth> frames = {};
+  };
+
+  /**
+   * @brief Statistical profiler driven by SIGPROF, sees every function including plugins without instrumentation.
+   *
+   * While running, the kernel interrupts whichever thread is burning CPU every 1/frequency seconds of process CPU
+   * time. The signal handler walks the frame pointers of the interrupted thread into a lock-free ring of raw return
+   * addresses, collect() drains that ring on the main thread, resolves every address to the function it is in with
+   * dladdr() against the executable and every loaded library, dlopen()ed plugins included, and merges the stacks by
+   * function into one call tree for the flame graph.
+   *
+   * Stacks need frame pointers and names need exported symbols, the CMake target adds -fno-omit-frame-pointer,
+   * -mno-omit-leaf-frame-pointer and -rdynamic. Code without frame pointers cuts its stacks short, a leaf function
+   * that still got no frame (GCC on x86) hides its caller, functions that are not exported show up as image+offset,
+   * one node per address.
+   */
+  class SamplingProfiler {
+public:
+    static constexpr uint32_t c_rootNode = 0;
+
+    /**
+     * @brief Installs the SIGPROF handler and starts the interval timer.
+     * @return false when the handler or timer could not be installed
+     */
+    static bool start(int frequencyHz = c_defaultFrequency);
+    static void stop();
+    static bool isRunning() { return s_running.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Merges the samples taken since the last call into the call tree. Main thread only.
+     */
+    static void collect();
+
+    /**
+     * @brief Drops the call tree and the symbol names, keeps sampling when running.
+     */
+    static void clear();
+
+    static const std::vector<FlameNode> &getNodes() { return s_nodes; }
+    static const std::string &getSymbolName(uint32_t symbol) { return s_symbolNames[symbol]; }
+    static uint64_t getSampleCount() { return s_nodes.empty() ? 0 : s_nodes[c_rootNode].samples; }
+    static uint64_t getDroppedCount() { return s_dropped; }
+    static int getFrequency() { return s_frequency; }
+
+private:
+    static constexpr int c_defaultFrequency = 1000;
+    static constexpr uint64_t c_capacity = 1 << 12;
+
+    static void onSignal(int signal, siginfo_t *info, void *context);
+
+    static uint32_t getSymbol(void *address);
+    static uint32_t getChild(uint32_t node, uint32_t symbol);
+
+private:
+    inline static std::atomic<bool> s_running = false;
+    inline static int s_frequency = c_defaultFrequency;
+    inline static struct sigaction s_previousAction = {};
+
+    //written by the signal handler on any thread
+    inline static std::array<StackSample, c_capacity> s_samples = {};
+    inline static std::atomic<uint64_t> s_writeIndex = 0;
+
+    //main thread only
+    inline static uint64_t s_readIndex = 0;
+    inline static uint64_t s_dropped = 0;
+    inline static std::vector<FlameNode> s_nodes = {};
+    inline static std::vector<std::string> s_symbolNames = {};
+    inline static std::unordered_map<void *, uint32_t> s_symbolsByFunction = {};
+    inline static std::unordered_map<void *, uint32_t> s_symbolsByAddress = {};
+  };
+}// namespace HummingBirdCore::Profiling
@@ -0,0 +1,333 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "AgentClient.h"
+
+#include "Metrics/StatsRegistry.h"
+#include "Profiling/Profiler.h"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace HummingBirdCore::Remote {
+  namespace {
+#ifdef MSG_NOSIGNAL
+    constexpr int c_sendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int c_sendFlags = 0;
+#endif
+
+    void setNonBlocking(int fd) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    Frame makeError(uint32_t requestId, std::string_view message) {
+      Workspace::SnapshotWriter writer;
+      writer.writeString(message);
+      return Frame{requestId, MessageError, writer.getBuffer()};
+    }
+  }// namespace
+
+  AgentClient::AgentClient(std::string host, uint16_t port, std::string token)
+      : m_host(std::move(host)), m_port(port), m_token(std::move(token)), m_address(fmt::format("{0}:{1}", m_host, m_port)) {
+    if (pipe(m_wakeFds) == 0) {
+      setNonBlocking(m_wakeFds[0]);
+      setNonBlocking(m_wakeFds[1]);
+    }
+  }
+
+  AgentClient::~AgentClient() {
+    m_stopping = true;
+    wake();
+    if (m_thread.joinable())
+      m_thread.join();
+    close(m_wakeFds[0]);
+    close(m_wakeFds[1]);
+  }
+
+  void AgentClient::connect() {
+    if (m_thread.joinable()) {
+      if (getState() != StateFailed)
+        return;
+      m_thread.join();
+    }
+
+    {
+      std::lock_guard lock(m_mutex);
+      m_error.clear();
+      m_outgoing.clear();
+      Workspace::SnapshotWriter writer;
+      writer.writeString(m_token);
+      writer.writeU32(c_protocolVersion);
+      appendFrame(m_outgoing, c_helloRequestId, MessageHello, writer.getBuffer());
+      m_state = StateConnecting;
+    }
+    m_thread = std::thread(&AgentClient::run, this);
+  }
+
+  std::future<Frame> AgentClient::request(MessageType type, const std::vector<uint8_t> &payload) {
+    auto promise = std::make_shared<std::promise<Frame>>();
+    std::future<Frame> future = promise->get_future();
+    send(type, payload, [promise](const Frame &frame) {
+      if (frame.type == MessageResult || frame.type == MessageError)
+        promise->set_value(frame);
+    });
+    return future;
+  }
+
+  uint32_t AgentClient::stream(MessageType type, const std::vector<uint8_t> &payload, Callback callback) {
+    return send(type, payload, std::move(callback));
+  }
+
+  void AgentClient::cancel(uint32_t requestId) {
+    {
+      std::lock_guard lock(m_mutex);
+      if (m_callbacks.erase(requestId) == 0 || getState() == StateFailed)
+        return;
+      appendFrame(m_outgoing, requestId, MessageCancel, {});
+    }
+    wake();
+  }
+
+  const char *AgentClient::getStateName() const {
+    switch (getState()) {
+      case StateConnecting:
+        return "Connecting";
+      case StateConnected:
+        return "Connected";
+      case StateFailed:
+        return "Failed";
+    }
+    return "Unknown";
+  }
+
+  std::string AgentClient::getHostname() const {
+    std::lock_guard lock(m_mutex);
+    return m_hostname;
+  }
+
+  std::string AgentClient::getError() const {
+    std::lock_guard lock(m_mutex);
+    return m_error;
+  }
+
+  size_t AgentClient::getPendingCount() const {
+    std::lock_guard lock(m_mutex);
+    return m_callbacks.size();
+  }
+
+  Workspace::SnapshotReader AgentClient::checkResult(const Frame &frame) {
+    Workspace::SnapshotReader reader = frame.getReader();
+    if (frame.type == MessageError)
+      throw std::runtime_error(std::string(reader.readString()));
+    return reader;
+  }
+
+  uint32_t AgentClient::send(MessageType type, const std::vector<uint8_t> &payload, Callback callback) {
+    uint32_t requestId;
+    {
+      std::lock_guard lock(m_mutex);
+      requestId = m_nextRequestId++;
+      if (m_nextRequestId == c_helloRequestId)
+        m_nextRequestId++;
+      if (getState() != StateFailed) {
+        m_callbacks[requestId] = std::make_shared<Callback>(std::move(callback));
+        appendFrame(m_outgoing, requestId, type, payload);
+        callback = nullptr;
+      }
+    }
+    //nothing to send it over, answer it right away
+    if (callback) {
+      callback(makeError(requestId, "Not connected to " + m_address));
+      return requestId;
+    }
+
+    static Metrics::Counter &requests = Metrics::StatsRegistry::counter("agent_client.requests");
+    requests.add();
+    wake();
+    return requestId;
+  }
+
+  void AgentClient::run() {
+    Profiling::Profiler::setThreadName("Agent " + m_address);
+    std::string error;
+    if (!open(error)) {
+      fail(error);
+      return;
+    }
+
+    FrameReader reader;
+    std::vector<uint8_t> buffer(c_receiveBufferSize);
+    std::vector<uint8_t> sending;
+    while (!m_stopping.load(std::memory_order_relaxed) && getState() != StateFailed) {
+      //written outside the lock, requests keep queueing up while a large write is in progress
+      if (sending.empty()) {
+        std::lock_guard lock(m_mutex);
+        sending.swap(m_outgoing);
+      }
+
+      pollfd polls[2] = {{m_fd, POLLIN, 0}, {m_wakeFds[0], POLLIN, 0}};
+      if (!sending.empty())
+        polls[0].events |= POLLOUT;
+      if (poll(polls, 2, -1) < 0 && errno != EINTR) {
+        fail("Polling the connection failed");
+        break;
+      }
+
+      if (polls[1].revents & POLLIN) {
+        char drain[64];
+        while (read(m_wakeFds[0], drain, sizeof(drain)) > 0) {
+        }
+      }
+      if (polls[0].revents & (POLLERR | POLLNVAL)) {
+        fail("Connection to " + m_address + " lost");
+        break;
+      }
+
+      if (polls[0].revents & POLLOUT) {
+        const ssize_t written = ::send(m_fd, sending.data(), sending.size(), c_sendFlags);
+        if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+          fail("Connection to " + m_address + " lost");
+          break;
+        }
+        if (written > 0)
+          sending.erase(sending.begin(), sending.begin() + written);
+      }
+
+      if (polls[0].revents & (POLLIN | POLLHUP)) {
+        bool open = true;
+        while (true) {
+          const ssize_t received = recv(m_fd, buffer.data(), buffer.size(), 0);
+          if (received > 0) {
+            reader.append(buffer.data(), (size_t) received);
+            continue;
+          }
+          if (received < 0 && errno == EINTR)
+            continue;
+          open = received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+          break;
+        }
+
+        Frame frame;
+        while (reader.next(frame)) {
+          dispatch(std::move(frame));
+        }
+        //the agent turned the Hello down
+        if (getState() == StateFailed)
+          break;
+        if (!reader.isValid()) {
+          fail("The agent at " + m_address + " sent a broken frame");
+          break;
+        }
+        if (!open) {
+          fail("Connection to " + m_address + " closed");
+          break;
+        }
+      }
+    }
+
+    close(m_fd);
+    m_fd = -1;
+  }
+
+  bool AgentClient::open(std::string &error) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    const std::string port = std::to_string(m_port);
+    if (const int result = getaddrinfo(m_host.c_str(), port.c_str(), &hints, &addresses); result != 0) {
+      error = fmt::format("Unable to resolve {0}: {1}", m_host, gai_strerror(result));
+      return false;
+    }
+
+    error = "Unable to connect to " + m_address;
+    for (addrinfo *address = addresses; address != nullptr && m_fd == -1; address = address->ai_next) {
+      const int fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+      if (fd == -1)
+        continue;
+      //connect without blocking so a dead host times out instead of hanging the client for minutes
+      setNonBlocking(fd);
+      bool connected = ::connect(fd, address->ai_addr, address->ai_addrlen) == 0;
+      if (!connected && errno == EINPROGRESS) {
+        pollfd connecting = {fd, POLLOUT, 0};
+        int socketError = 0;
+        socklen_t length = sizeof(socketError);
+        connected = poll(&connecting, 1, c_connectTimeoutMs) == 1 && getsockopt(fd, SOL_SOCKET, SO_ERROR, &socketError, &length) == 0 && socketError == 0;
+      }
+      if (!connected) {
+        close(fd);
+        continue;
+      }
+
+      int noDelay = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+#ifdef SO_NOSIGPIPE
+      int noSigPipe = 1;
+      setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+      m_fd = fd;
+    }
+    freeaddrinfo(addresses);
+    return m_fd != -1;
+  }
+
+  void AgentClient::fail(const std::string &error) {
+    CORE_WARN("Agent {0}: {1}", m_address, error);
+    std::unordered_map<uint32_t, std::shared_ptr<Callback>> callbacks;
+    {
+      std::lock_guard lock(m_mutex);
+      m_error = error;
+      m_outgoing.clear();
+      callbacks.swap(m_callbacks);
+      m_state = StateFailed;
+    }
+    //everything still waiting for an answer gets one, no future is left hanging
+    for (const auto &[requestId, callback]: callbacks) {
+      (*callback)(makeError(requestId, error));
+    }
+  }
+
+  void AgentClient::dispatch(Frame frame) {
+    if (frame.requestId == c_helloRequestId) {
+      Workspace::SnapshotReader reader = frame.getReader();
+      if (frame.type != MessageResult) {
+        fail(std::string(reader.readString()));
+        return;
+      }
+      std::string hostname(reader.readString());
+      {
+        std::lock_guard lock(m_mutex);
+        m_hostname = std::move(hostname);
+      }
+      m_state = StateConnected;
+      CORE_INFO("Connected to agent {0} ({1})", m_address, getHostname());
+      return;
+    }
+
+    std::shared_ptr<Callback> callback;
+    {
+      std::lock_guard lock(m_mutex);
+      auto found = m_callbacks.find(frame.requestId);
+      //answers to a request that was cancelled in the meantime
+      if (found == m_callbacks.end())
+        return;
+      callback = found->second;
+      if (frame.type == MessageResult || frame.type == MessageError)
+        m_callbacks.erase(found);
+    }
+    (*callback)(frame);
+  }
+
+  void AgentClient::wake() {
+    const char byte = 1;
+    //a full pipe already wakes the thread up
+    [[maybe_unused]] ssize_t written = write(m_wakeFds[1], &byte, 1);
+  }
+}// namespace HummingBirdCore::Remote
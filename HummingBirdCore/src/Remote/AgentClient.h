@@ -0,0 +1,106 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Protocol.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace HummingBirdCore::Remote {
+  /**
+   * @brief Connection from the UI to one HummingBirdAgent.
+   *
+   * Requests are queued right away and written by the client thread in one go, nothing waits for an answer before
+   * the next request goes out. Requests made while it is still connecting go out right after the Hello. Callbacks
+   * run on the client thread, windows post what they need to the main thread themselves.
+   */
+  class AgentClient {
+public:
+    enum State {
+      StateConnecting,
+      StateConnected,
+      StateFailed
+    };
+
+    using Callback = std::function<void(const Frame &)>;
+
+    AgentClient(std::string host, uint16_t port, std::string token);
+    ~AgentClient();
+
+    AgentClient(const AgentClient &) = delete;
+    AgentClient &operator=(const AgentClient &) = delete;
+
+    /**
+     * @brief Connects on the client thread, does nothing while a connection is up or being made.
+     */
+    void connect();
+
+    /**
+     * @brief Sends a request that is answered once, with a Result or an Error frame.
+     */
+    std::future<Frame> request(MessageType type, const std::vector<uint8_t> &payload);
+
+    /**
+     * @brief Sends a request that is answered with any number of frames, callback gets every one of them.
+     * The last one is a Result or an Error, a lost connection ends the stream with an Error.
+     * @return The id to cancel() the request with
+     */
+    uint32_t stream(MessageType type, const std::vector<uint8_t> &payload, Callback callback);
+
+    /**
+     * @brief Stops a stream or a subscription, its callback is not called any more.
+     */
+    void cancel(uint32_t requestId);
+
+    State getState() const { return m_state.load(std::memory_order_acquire); }
+    const char *getStateName() const;
+    //host:port as it was added
+    const std::string &getAddress() const { return m_address; }
+    std::string getHostname() const;
+    std::string getError() const;
+    size_t getPendingCount() const;
+
+    /**
+     * @brief Turns an Error frame into an exception, for callers that load a model with the result.
+     * The reader points into frame, keep it around while reading.
+     */
+    static Workspace::SnapshotReader checkResult(const Frame &frame);
+
+private:
+    void run();
+    bool open(std::string &error);
+    void fail(const std::string &error);
+    void dispatch(Frame frame);
+    uint32_t send(MessageType type, const std::vector<uint8_t> &payload, Callback callback);
+    void wake();
+
+private:
+    static constexpr int c_connectTimeoutMs = 5000;
+    static constexpr size_t c_receiveBufferSize = 64 * 1024;
+    //the Hello is always the first request, the agent answers it before anything else
+    static constexpr uint32_t c_helloRequestId = 0;
+
+    const std::string m_host;
+    const uint16_t m_port;
+    const std::string m_token;
+    const std::string m_address;
+
+    std::thread m_thread;
+    std::atomic<State> m_state = StateFailed;
+    std::atomic<bool> m_stopping = false;
+    int m_fd = -1;
+    int m_wakeFds[2] = {-1, -1};
+
+    mutable std::mutex m_mutex;
+    std::vector<uint8_t> m_outgoing;
+    std::unordered_map<uint32_t, std::shared_ptr<Callback>> m_callbacks;
+    uint32_t m_nextRequestId = 1;
+    std::string m_hostname;
+    std::string m_error;
+  };
+}// namespace HummingBirdCore::Remote
@@ -0,0 +1,85 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include <Log.h>
+#include <Remote/AgentServer.h>
+
+#include <csignal>
+
+namespace {
+  volatile std::sig_atomic_t s_stop = 0;
+
+  void onSignal(int) {
+    s_stop = 1;
+  }
+
+  void printUsage() {
+    std::cout << "Usage: HummingBirdAgent [options]\n"
+                 "  --port n          Port to listen on (default: "
+              << HummingBirdCore::Remote::c_defaultPort << ")\n"
+                 "  --bind address    Loopback address to listen on (default: 127.0.0.1)\n"
+                 "  --token token     Token UIs have to send, HUMMINGBIRD_AGENT_TOKEN when not given\n"
+                 "Start several on different ports to try one UI against many hosts.\n"
+                 "The protocol is not encrypted, reach an agent on another machine through an SSH tunnel:\n"
+                 "  ssh -N -L 7421:127.0.0.1:7421 user@host"
+              << std::endl;
+  }
+}// namespace
+
+int main(int argc, char **argv) {
+  HummingBirdCore::Log::Init();
+
+  HummingBirdCore::Remote::AgentServer::Options options;
+  if (const char *token = std::getenv("HUMMINGBIRD_AGENT_TOKEN"); token != nullptr)
+    options.token = token;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      printUsage();
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      printUsage();
+      return 1;
+    }
+
+    const std::string value = argv[++i];
+    try {
+      if (arg == "--port") {
+        const int port = std::stoi(value);
+        if (port <= 0 || port > 65535)
+          throw std::out_of_range(value);
+        options.port = (uint16_t) port;
+      } else if (arg == "--bind") {
+        options.bindAddress = value;
+      } else if (arg == "--token") {
+        options.token = value;
+      } else {
+        std::cerr << "Unknown option " << arg << std::endl;
+        printUsage();
+        return 1;
+      }
+    } catch (const std::exception &e) {
+      std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+      return 1;
+    }
+  }
+
+  //a UI that goes away mid write must not take the agent with it
+  std::signal(SIGPIPE, SIG_IGN);
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+
+  HummingBirdCore::Remote::AgentServer server(options);
+  if (!server.start())
+    return 1;
+  while (s_stop == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  CORE_INFO("Stopping agent");
+  server.stop();
+  return 0;
+}
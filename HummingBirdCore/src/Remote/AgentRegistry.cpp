@@ -0,0 +1,92 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "AgentRegistry.h"
+
+#include <imgui.h>
+
+namespace HummingBirdCore::Remote {
+  void AgentRegistry::initialize() {
+    if (const char *token = std::getenv("HUMMINGBIRD_AGENT_TOKEN"); token != nullptr)
+      s_token = token;
+
+    const char *agents = std::getenv("HUMMINGBIRD_AGENTS");
+    if (agents == nullptr)
+      return;
+    std::string_view list = agents;
+    while (!list.empty()) {
+      const size_t comma = list.find(',');
+      const std::string_view address = list.substr(0, comma);
+      if (!address.empty() && add(std::string(address)) == nullptr)
+        CORE_WARN("Ignoring invalid agent address in HUMMINGBIRD_AGENTS: {0}", address);
+      list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+    }
+  }
+
+  void AgentRegistry::shutdown() {
+    //windows can still hold on to an agent, they are destroyed before the registry goes away
+    s_agents.clear();
+  }
+
+  std::shared_ptr<AgentClient> AgentRegistry::add(const std::string &address) {
+    if (std::shared_ptr<AgentClient> agent = get(address))
+      return agent;
+
+    std::string host = address;
+    uint16_t port = c_defaultPort;
+    if (const size_t colon = address.rfind(':'); colon != std::string::npos) {
+      host = address.substr(0, colon);
+      const long parsed = std::strtol(address.c_str() + colon + 1, nullptr, 10);
+      if (parsed <= 0 || parsed > 65535)
+        return nullptr;
+      port = (uint16_t) parsed;
+    }
+    if (host.empty())
+      return nullptr;
+
+    auto agent = std::make_shared<AgentClient>(host, port, s_token);
+    agent->connect();
+    s_agents.push_back(agent);
+    return agent;
+  }
+
+  void AgentRegistry::remove(const std::string &address) {
+    std::erase_if(s_agents, [&address](const std::shared_ptr<AgentClient> &agent) { return agent->getAddress() == address; });
+  }
+
+  std::shared_ptr<AgentClient> AgentRegistry::get(const std::string &address) {
+    if (address.empty())
+      return nullptr;
+    for (const auto &agent: s_agents) {
+      //added as host or as host:port, both find it
+      if (agent->getAddress() == address || agent->getAddress() == address + ":" + std::to_string(c_defaultPort))
+        return agent;
+    }
+    return nullptr;
+  }
+
+  bool AgentRegistry::renderTargetSelector(const char *label, std::string &target) {
+    bool changed = false;
+    const char *preview = target.empty() ? "This machine" : target.c_str();
+    if (ImGui::BeginCombo(label, preview)) {
+      if (ImGui::Selectable("This machine", target.empty())) {
+        changed = !target.empty();
+        target.clear();
+      }
+      for (const auto &agent: s_agents) {
+        const std::string &address = agent->getAddress();
+        ImGui::BeginDisabled(agent->getState() == AgentClient::StateFailed);
+        if (ImGui::Selectable(address.c_str(), target == address)) {
+          changed = target != address;
+          target = address;
+        }
+        ImGui::EndDisabled();
+      }
+      if (s_agents.empty())
+        ImGui::TextDisabled("Add agents in Developer Tools -> Fleet");
+      ImGui::EndCombo();
+    }
+    return changed;
+  }
+}// namespace HummingBirdCore::Remote
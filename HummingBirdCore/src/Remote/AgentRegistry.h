@@ -0,0 +1,50 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "AgentClient.h"
+
+namespace HummingBirdCore::Remote {
+  /**
+   * @brief The agents this UI talks to, shared by every window that points at one.
+   *
+   * Windows keep the address of their target, an empty address is this machine. HUMMINGBIRD_AGENTS adds agents on
+   * start as "host:port,host:port", they all use HUMMINGBIRD_AGENT_TOKEN. Main thread only.
+   */
+  //Class is fully static
+  class AgentRegistry {
+public:
+    static void initialize();
+    static void shutdown();
+
+    /**
+     * @brief Connects to host:port, or returns the agent that was added with that address before.
+     * @return nullptr when the address can not be parsed
+     */
+    static std::shared_ptr<AgentClient> add(const std::string &address);
+    static void remove(const std::string &address);
+
+    /**
+     * @return nullptr for this machine and for agents that were removed
+     */
+    static std::shared_ptr<AgentClient> get(const std::string &address);
+
+    static const std::vector<std::shared_ptr<AgentClient>> &getAgents() { return s_agents; }
+
+    static void setToken(std::string token) { s_token = std::move(token); }
+    static const std::string &getToken() { return s_token; }
+
+    /**
+     * @brief Combo to pick this machine or one of the agents.
+     * @return true when target changed
+     */
+    static bool renderTargetSelector(const char *label, std::string &target);
+
+private:
+    inline static std::vector<std::shared_ptr<AgentClient>> s_agents = {};
+    inline static std::string s_token = {};
+  };
+}// namespace HummingBirdCore::Remote
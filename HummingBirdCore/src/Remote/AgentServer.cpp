@@ -0,0 +1,512 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "AgentServer.h"
+
+#include "Async/Process.h"
+#include "Metrics/StatsRegistry.h"
+#include "Profiling/Profiler.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace HummingBirdCore::Remote {
+  namespace {
+#ifdef MSG_NOSIGNAL
+    constexpr int c_sendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int c_sendFlags = 0;
+#endif
+
+    void setNonBlocking(int fd) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    std::string getHostname() {
+      char hostname[256] = {};
+      if (gethostname(hostname, sizeof(hostname) - 1) != 0)
+        return "unknown";
+      return hostname;
+    }
+  }// namespace
+
+  bool AgentServer::start() {
+    if (isRunning())
+      return true;
+    if (m_options.token.empty()) {
+      CORE_ERROR("The agent needs a token, set HUMMINGBIRD_AGENT_TOKEN or pass --token");
+      return false;
+    }
+
+    m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listenFd == -1) {
+      CORE_ERROR("Unable to create the agent socket");
+      return false;
+    }
+
+    int reuse = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_options.port);
+    if (inet_pton(AF_INET, m_options.bindAddress.c_str(), &address.sin_addr) != 1) {
+      CORE_ERROR("Invalid agent bind address {0}", m_options.bindAddress);
+      close(m_listenFd);
+      m_listenFd = -1;
+      return false;
+    }
+    if (!isLoopback(address.sin_addr)) {
+      CORE_ERROR("Refusing to listen on {0}, the agent protocol is not encrypted. Listen on 127.0.0.1 and connect through an SSH "
+                 "tunnel: ssh -N -L {1}:127.0.0.1:{1} user@host",
+                 m_options.bindAddress, m_options.port);
+      close(m_listenFd);
+      m_listenFd = -1;
+      return false;
+    }
+    if (bind(m_listenFd, (sockaddr *) &address, sizeof(address)) == -1 || listen(m_listenFd, 64) == -1 || pipe(m_wakeFds) == -1) {
+      CORE_ERROR("Unable to listen for UIs on {0}:{1}", m_options.bindAddress, m_options.port);
+      close(m_listenFd);
+      m_listenFd = -1;
+      return false;
+    }
+    setNonBlocking(m_listenFd);
+    setNonBlocking(m_wakeFds[0]);
+    setNonBlocking(m_wakeFds[1]);
+
+    m_stopping = false;
+    m_thread = std::thread(&AgentServer::run, this);
+    CORE_INFO("Agent listening on {0}:{1}", m_options.bindAddress, m_options.port);
+    return true;
+  }
+
+  void AgentServer::stop() {
+    if (!isRunning())
+      return;
+    m_stopping = true;
+    wake();
+    m_thread.join();
+
+    for (const auto &connection: m_connections) {
+      markClosed(*connection);
+    }
+    //the cancelled commands stop their process within Process::c_killGraceMs, the jobs still hold this
+    for (const auto &command: m_commands) {
+      command->thread.join();
+    }
+    m_commands.clear();
+    m_jobs.wait();
+    for (const auto &connection: m_connections) {
+      close(connection->fd);
+    }
+    m_connections.clear();
+
+    close(m_listenFd);
+    close(m_wakeFds[0]);
+    close(m_wakeFds[1]);
+    m_listenFd = m_wakeFds[0] = m_wakeFds[1] = -1;
+  }
+
+  void AgentServer::run() {
+    Profiling::Profiler::setThreadName("Agent");
+    std::vector<pollfd> polls;
+    auto nextPublish = std::chrono::steady_clock::now();
+    while (!m_stopping.load(std::memory_order_relaxed)) {
+      polls.clear();
+      polls.push_back({m_listenFd, POLLIN, 0});
+      polls.push_back({m_wakeFds[0], POLLIN, 0});
+      for (const auto &connection: m_connections) {
+        std::lock_guard lock(connection->mutex);
+        //a client that does not read its responses gets no new requests served until it caught up
+        short events = connection->getPending() < c_maxOutgoingBytes ? POLLIN : 0;
+        if (connection->getPending() > 0)
+          events |= POLLOUT;
+        polls.push_back({connection->fd, events, 0});
+      }
+
+      const auto now = std::chrono::steady_clock::now();
+      const int timeout = (int) std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(nextPublish - now).count());
+      if (poll(polls.data(), (nfds_t) polls.size(), timeout) < 0 && errno != EINTR)
+        break;
+
+      if (polls[1].revents & POLLIN) {
+        char drain[64];
+        while (read(m_wakeFds[0], drain, sizeof(drain)) > 0) {
+        }
+      }
+      if (polls[0].revents & POLLIN)
+        accept();
+
+      //the connections accepted above were not polled yet, only walk the ones that were
+      const size_t polled = polls.size() - 2;
+      for (size_t i = 0; i < polled; i++) {
+        const std::shared_ptr<Connection> &connection = m_connections[i];
+        const short revents = polls[i + 2].revents;
+        bool open = !(revents & (POLLERR | POLLNVAL));
+        if (open && (revents & (POLLIN | POLLHUP)))
+          open = receive(connection);
+        if (open && (revents & POLLOUT))
+          open = flush(*connection);
+        if (!open)
+          connection->closed = true;
+      }
+
+      if (std::chrono::steady_clock::now() >= nextPublish) {
+        publish();
+        nextPublish = std::chrono::steady_clock::now() + std::chrono::milliseconds(c_publishIntervalMs);
+      }
+
+      //closing a connection ends the commands it started
+      std::erase_if(m_connections, [](const std::shared_ptr<Connection> &connection) {
+        if (!connection->closed)
+          return false;
+        markClosed(*connection);
+        close(connection->fd);
+        return true;
+      });
+      std::erase_if(m_commands, [](const std::unique_ptr<Command> &command) {
+        if (!command->finished)
+          return false;
+        command->thread.join();
+        return true;
+      });
+      static Metrics::Gauge &connections = Metrics::StatsRegistry::gauge("agent.connections");
+      connections.set((double) m_connections.size());
+    }
+  }
+
+  void AgentServer::accept() {
+    while (true) {
+      const int clientFd = ::accept(m_listenFd, nullptr, nullptr);
+      if (clientFd == -1)
+        return;
+      setNonBlocking(clientFd);
+      //requests are small and pipelined, do not hold them back for coalescing
+      int noDelay = 1;
+      setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+#ifdef SO_NOSIGPIPE
+      int noSigPipe = 1;
+      setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+      auto connection = std::make_shared<Connection>();
+      connection->fd = clientFd;
+      connection->reader.setMaxFrameSize(c_maxHelloFrameSize);
+      m_connections.push_back(std::move(connection));
+    }
+  }
+
+  bool AgentServer::receive(const std::shared_ptr<Connection> &connection) {
+    static thread_local std::vector<uint8_t> buffer(c_receiveBufferSize);
+    while (true) {
+      const ssize_t received = recv(connection->fd, buffer.data(), buffer.size(), 0);
+      if (received == 0)
+        return false;
+      if (received < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+          break;
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      //cut the frames off right away, an oversized frame fails before the rest of it is buffered
+      connection->reader.append(buffer.data(), (size_t) received);
+      Frame frame;
+      while (connection->reader.next(frame)) {
+        handleFrame(connection, std::move(frame));
+        if (connection->closed)
+          return false;
+      }
+      if (!connection->reader.isValid())
+        return false;
+    }
+    return true;
+  }
+
+  bool AgentServer::flush(Connection &connection) {
+    std::lock_guard lock(connection.mutex);
+    std::vector<uint8_t> &outgoing = connection.outgoing;
+    while (connection.outgoingOffset < outgoing.size()) {
+      const ssize_t written = ::send(connection.fd, outgoing.data() + connection.outgoingOffset, outgoing.size() - connection.outgoingOffset, c_sendFlags);
+      if (written < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+          break;
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      connection.outgoingOffset += (size_t) written;
+    }
+
+    //drop the sent front once it makes up most of the queue, instead of shifting after every send
+    if (connection.outgoingOffset == outgoing.size()) {
+      outgoing.clear();
+      connection.outgoingOffset = 0;
+    } else if (connection.outgoingOffset > outgoing.size() / 2) {
+      outgoing.erase(outgoing.begin(), outgoing.begin() + (ptrdiff_t) connection.outgoingOffset);
+      connection.outgoingOffset = 0;
+    }
+    if (connection.getPending() < c_maxOutgoingBytes)
+      connection.writable.notify_all();
+    return true;
+  }
+
+  void AgentServer::handleFrame(const std::shared_ptr<Connection> &connection, Frame frame) {
+    static Metrics::Counter &requests = Metrics::StatsRegistry::counter("agent.requests");
+    requests.add();
+    Workspace::SnapshotReader reader = frame.getReader();
+
+    if (!connection->authenticated) {
+      const std::string_view token = reader.readString();
+      const uint32_t version = reader.readU32();
+      if (frame.type != MessageHello || !reader.isValid() || !isTokenValid(m_options.token, token)) {
+        CORE_WARN("Rejected an agent connection with a missing or wrong token");
+        sendError(*connection, frame.requestId, "Not authorized");
+        flush(*connection);
+        connection->closed = true;
+        return;
+      }
+      if (version != c_protocolVersion) {
+        sendError(*connection, frame.requestId, fmt::format("Protocol version {0} is not supported, the agent speaks {1}", version, c_protocolVersion));
+        flush(*connection);
+        connection->closed = true;
+        return;
+      }
+      connection->authenticated = true;
+      connection->reader.setMaxFrameSize(c_maxFrameSize);
+      Workspace::SnapshotWriter writer;
+      writer.writeString(getHostname());
+      writer.writeU32(c_protocolVersion);
+      send(*connection, frame.requestId, MessageResult, writer.getBuffer());
+      return;
+    }
+
+    switch (frame.type) {
+      case MessageReadFile: {
+        std::string path(reader.readString());
+        m_jobs.add();
+        Threading::ThreadPool::get().post([this, connection, id = frame.requestId, path = std::move(path)]() mutable {
+          readFile(connection, id, std::move(path));
+          m_jobs.done();
+        });
+        break;
+      }
+      case MessageListDirectory: {
+        std::string path(reader.readString());
+        std::string extension(reader.readString());
+        m_jobs.add();
+        Threading::ThreadPool::get().post([this, connection, id = frame.requestId, path = std::move(path), extension = std::move(extension)]() mutable {
+          listDirectory(connection, id, std::move(path), std::move(extension));
+          m_jobs.done();
+        });
+        break;
+      }
+      case MessageRunCommand: {
+        std::string command(reader.readString());
+        std::string location(reader.readString());
+        //finished commands are joined at the end of every poll, the ones left are running
+        if (m_commands.size() >= c_maxCommands) {
+          sendError(*connection, frame.requestId, fmt::format("The agent runs {0} commands already, cancel one first", c_maxCommands));
+          break;
+        }
+        Threading::CancellationToken token;
+        {
+          std::lock_guard lock(connection->mutex);
+          connection->streams[frame.requestId] = token;
+        }
+        Command &started = *m_commands.emplace_back(std::make_unique<Command>());
+        started.thread = std::thread([this, connection, id = frame.requestId, command = std::move(command), location = std::move(location), token, &started]() mutable {
+          runCommand(connection, id, std::move(command), std::move(location), token);
+          started.finished = true;
+        });
+        break;
+      }
+      case MessageSubscribe: {
+        std::string topic(reader.readString());
+        if (topic != c_topicStats) {
+          sendError(*connection, frame.requestId, "Unknown topic " + topic);
+          break;
+        }
+        connection->subscriptions[frame.requestId] = Subscription{std::move(topic), DeltaEncoder()};
+        //the first delta carries the whole state, do not make a new subscriber wait for the next publish
+        Workspace::SnapshotWriter writer;
+        if (connection->subscriptions[frame.requestId].encoder.encode(collectStats(), writer))
+          send(*connection, frame.requestId, MessageDelta, writer.getBuffer());
+        break;
+      }
+      case MessageCancel: {
+        connection->subscriptions.erase(frame.requestId);
+        std::lock_guard lock(connection->mutex);
+        if (auto stream = connection->streams.find(frame.requestId); stream != connection->streams.end()) {
+          stream->second.cancel();
+          connection->writable.notify_all();
+        }
+        break;
+      }
+      default:
+        sendError(*connection, frame.requestId, fmt::format("Unknown request {0}", (int) frame.type));
+        break;
+    }
+  }
+
+  void AgentServer::publish() {
+    HB_PROFILE_SCOPE("AgentServer::publish");
+    bool subscribed = false;
+    for (const auto &connection: m_connections) {
+      subscribed |= !connection->subscriptions.empty();
+    }
+    if (!subscribed)
+      return;
+
+    //built once and diffed against what every subscriber was sent last
+    const KeyValues stats = collectStats();
+    for (const auto &connection: m_connections) {
+      //the encoders remember what was sent, the first delta after the client caught up carries what it skipped
+      bool backedUp = false;
+      {
+        std::lock_guard lock(connection->mutex);
+        backedUp = connection->getPending() >= c_maxOutgoingBytes;
+      }
+      if (backedUp)
+        continue;
+      for (auto &[id, subscription]: connection->subscriptions) {
+        Workspace::SnapshotWriter writer;
+        if (subscription.encoder.encode(stats, writer))
+          send(*connection, id, MessageDelta, writer.getBuffer());
+      }
+    }
+  }
+
+  void AgentServer::send(Connection &connection, uint32_t requestId, MessageType type, const std::vector<uint8_t> &payload) {
+    if (connection.closed)
+      return;
+    {
+      std::lock_guard lock(connection.mutex);
+      appendFrame(connection.outgoing, requestId, type, payload);
+    }
+    static Metrics::Counter &bytesSent = Metrics::StatsRegistry::counter("agent.bytes_sent");
+    bytesSent.add((int64_t) (c_frameHeaderSize + payload.size()));
+    wake();
+  }
+
+  void AgentServer::sendError(Connection &connection, uint32_t requestId, std::string_view message) {
+    Workspace::SnapshotWriter writer;
+    writer.writeString(message);
+    send(connection, requestId, MessageError, writer.getBuffer());
+  }
+
+  bool AgentServer::waitUntilWritable(Connection &connection, const Threading::CancellationToken &token) {
+    std::unique_lock lock(connection.mutex);
+    connection.writable.wait(lock, [&] { return connection.closed || token.isCancelled() || connection.getPending() < c_maxOutgoingBytes; });
+    return !connection.closed && !token.isCancelled();
+  }
+
+  void AgentServer::markClosed(Connection &connection) {
+    connection.closed = true;
+    std::lock_guard lock(connection.mutex);
+    for (auto &[id, token]: connection.streams) {
+      token.cancel();
+    }
+    connection.writable.notify_all();
+  }
+
+  void AgentServer::wake() {
+    const char byte = 1;
+    //a full pipe already wakes the thread up
+    [[maybe_unused]] ssize_t written = write(m_wakeFds[1], &byte, 1);
+  }
+
+  void AgentServer::readFile(const std::shared_ptr<Connection> &connection, uint32_t requestId, std::string path) {
+    HB_PROFILE_SCOPE("AgentServer::readFile");
+    if (path.starts_with("~"))
+      path = Utils::FolderUtils::getHomeDirectory().string() + path.substr(1);
+    std::vector<uint8_t> contents;
+    if (!Utils::FileUtils::readFromFile(path, &contents)) {
+      sendError(*connection, requestId, "Unable to read " + path);
+      return;
+    }
+    Workspace::SnapshotWriter writer;
+    writer.writeBytes(contents.data(), contents.size());
+    send(*connection, requestId, MessageResult, writer.getBuffer());
+  }
+
+  void AgentServer::listDirectory(const std::shared_ptr<Connection> &connection, uint32_t requestId, std::string path, std::string extension) {
+    HB_PROFILE_SCOPE("AgentServer::listDirectory");
+    const std::vector<Utils::File> files = Utils::FolderUtils::getFilesInFolder(path, extension);
+    Workspace::SnapshotWriter writer;
+    writer.writeU32((uint32_t) files.size());
+    for (const auto &file: files) {
+      writer.writeString(file.getFullPath());
+    }
+    send(*connection, requestId, MessageResult, writer.getBuffer());
+  }
+
+  void AgentServer::runCommand(const std::shared_ptr<Connection> &connection, uint32_t requestId, std::string command, std::string location,
+                               const Threading::CancellationToken &token) {
+    Async::Process process;
+    if (!process.start(command, location)) {
+      sendError(*connection, requestId, "Failed to run command: " + command);
+    } else {
+      //closing the connection cancels the token too, either one ends this loop
+      while (std::optional<std::string> line = process.readLineBlocking(token)) {
+        //while the client is behind this thread stops reading, the command blocks on its full pipe
+        if (!waitUntilWritable(*connection, token))
+          break;
+        Workspace::SnapshotWriter writer;
+        writer.writeString(*line);
+        send(*connection, requestId, MessageOutput, writer.getBuffer());
+      }
+      //SIGTERM, and SIGKILL when the command is still there after the grace period
+      const int exitCode = token.isCancelled() ? process.stop() : process.wait();
+      Workspace::SnapshotWriter writer;
+      writer.writeI32(exitCode);
+      send(*connection, requestId, MessageResult, writer.getBuffer());
+    }
+
+    std::lock_guard lock(connection->mutex);
+    connection->streams.erase(requestId);
+  }
+
+  KeyValues AgentServer::collectStats() {
+    double load[3] = {};
+    if (getloadavg(load, 3) == 3) {
+      static Metrics::Gauge &load1 = Metrics::StatsRegistry::gauge("system.load1");
+      static Metrics::Gauge &load5 = Metrics::StatsRegistry::gauge("system.load5");
+      static Metrics::Gauge &load15 = Metrics::StatsRegistry::gauge("system.load15");
+      load1.set(load[0]);
+      load5.set(load[1]);
+      load15.set(load[2]);
+    }
+
+    KeyValues stats;
+    Metrics::StatsRegistry::forEachCounter([&stats](const std::string &name, const Metrics::Counter &counter) {
+      stats.emplace_back(name, std::to_string(counter.get()));
+    });
+    Metrics::StatsRegistry::forEachGauge([&stats](const std::string &name, const Metrics::Gauge &gauge) {
+      stats.emplace_back(name, fmt::format("{:.2f}", gauge.get()));
+    });
+    Metrics::StatsRegistry::forEachHistogram([&stats](const std::string &name, const Metrics::Histogram &histogram) {
+      const Metrics::HistogramSummary summary = histogram.getSummary();
+      stats.emplace_back(name, fmt::format("n={0} p50={1}{3} p99={2}{3}", summary.count, summary.p50, summary.p99, histogram.getUnit()));
+    });
+    return stats;
+  }
+
+  bool AgentServer::isTokenValid(std::string_view expected, std::string_view token) {
+    //compares every byte, the time taken does not tell how much of the token was right
+    uint8_t difference = expected.size() == token.size() ? 0 : 1;
+    for (size_t i = 0; i < expected.size(); i++) {
+      difference |= (uint8_t) (expected[i] ^ (i < token.size() ? token[i] : 0));
+    }
+    return difference == 0;
+  }
+
+  bool AgentServer::isLoopback(const in_addr &address) {
+    return (ntohl(address.s_addr) >> 24) == 127;
+  }
+}// namespace HummingBirdCore::Remote
@@ -0,0 +1,140 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Protocol.h"
+#include "Threading/ThreadPool.h"
+
+#include <atomic>
+#include <netinet/in.h>
+#include <thread>
+
+namespace HummingBirdCore::Remote {
+  /**
+   * @brief Serves the hosts file, launch agents, commands and stats of this machine to HummingBird UIs.
+   *
+   * One thread polls the listening socket and every connection, requests are handed to the thread pool as soon as
+   * their frame is complete, so a client that pipelines a slow directory listing and a quick file read gets the file
+   * first. Commands run on threads of their own, at most c_maxCommands at a time.
+   * Subscriptions are published from the polling thread every c_publishIntervalMs, only what changed since the last
+   * publish goes out. Every connection has to open with a Hello that carries the agent token.
+   *
+   * A connection queues at most c_maxOutgoingBytes for a slow client. Past that the agent stops reading its requests,
+   * skips its publishes and its commands stop reading their output, so the commands block on their pipe.
+   *
+   * The protocol is plaintext, so the agent only binds to loopback. UIs on other machines go through an SSH tunnel:
+   *   ssh -N -L 7421:127.0.0.1:7421 user@host
+   * and connect to 127.0.0.1:7421 on their side, the tunnel encrypts the token and everything after it.
+   */
+  class AgentServer {
+public:
+    struct Options {
+      //has to be a loopback address, the agent runs shell commands for whoever holds the token
+      std::string bindAddress = "127.0.0.1";
+      uint16_t port = c_defaultPort;
+      std::string token;
+    };
+
+    explicit AgentServer(Options options) : m_options(std::move(options)) {}
+    ~AgentServer() { stop(); }
+
+    AgentServer(const AgentServer &) = delete;
+    AgentServer &operator=(const AgentServer &) = delete;
+
+    /**
+     * @return false when the address is not a loopback address or could not be bound
+     */
+    bool start();
+    void stop();
+    bool isRunning() const { return m_thread.joinable(); }
+
+private:
+    struct Connection;
+
+    struct Subscription {
+      std::string topic;
+      DeltaEncoder encoder;
+    };
+
+    /**
+     * @brief A command thread, joined by the polling thread once it finished.
+     */
+    struct Command {
+      std::thread thread;
+      std::atomic<bool> finished = false;
+    };
+
+    struct Connection {
+      int fd = -1;
+      FrameReader reader;
+      bool authenticated = false;
+      //the polling thread only touches these
+      std::unordered_map<uint32_t, Subscription> subscriptions;
+
+      //written to by pool workers, flushed by the polling thread from outgoingOffset on
+      std::mutex mutex;
+      std::vector<uint8_t> outgoing;
+      size_t outgoingOffset = 0;
+      //signalled when the queue drained below c_maxOutgoingBytes or the connection closed
+      std::condition_variable writable;
+      //cancelling a command ends its process group
+      std::unordered_map<uint32_t, Threading::CancellationToken> streams;
+      std::atomic<bool> closed = false;
+
+      size_t getPending() const { return outgoing.size() - outgoingOffset; }
+    };
+
+    void run();
+    void accept();
+    bool receive(const std::shared_ptr<Connection> &connection);
+    bool flush(Connection &connection);
+    void handleFrame(const std::shared_ptr<Connection> &connection, Frame frame);
+    void publish();
+
+    /**
+     * @brief Queues a frame for the polling thread, safe from any thread.
+     */
+    void send(Connection &connection, uint32_t requestId, MessageType type, const std::vector<uint8_t> &payload);
+    void sendError(Connection &connection, uint32_t requestId, std::string_view message);
+    /**
+     * @brief Blocks until the connection queued less than c_maxOutgoingBytes, never call it from the polling thread.
+     * @return false when the connection closed or the token got cancelled instead
+     */
+    static bool waitUntilWritable(Connection &connection, const Threading::CancellationToken &token);
+    //closes the connection for every thread, its commands get cancelled
+    static void markClosed(Connection &connection);
+    void wake();
+
+    //run on the pool
+    void readFile(const std::shared_ptr<Connection> &connection, uint32_t requestId, std::string path);
+    void listDirectory(const std::shared_ptr<Connection> &connection, uint32_t requestId, std::string path, std::string extension);
+    //every command waits for its output on a thread of its own, a UI tailing a log must not take a pool worker
+    void runCommand(const std::shared_ptr<Connection> &connection, uint32_t requestId, std::string command, std::string location,
+                    const Threading::CancellationToken &token);
+
+    static KeyValues collectStats();
+    static bool isTokenValid(std::string_view expected, std::string_view token);
+    static bool isLoopback(const in_addr &address);
+
+private:
+    static constexpr int c_publishIntervalMs = 500;
+    static constexpr size_t c_receiveBufferSize = 64 * 1024;
+    static constexpr size_t c_maxOutgoingBytes = 4 * 1024 * 1024;
+    static constexpr size_t c_maxCommands = 16;
+
+    Options m_options;
+    std::thread m_thread;
+    std::atomic<bool> m_stopping = false;
+    int m_listenFd = -1;
+    //written to by workers to wake the polling thread when they queued a response
+    int m_wakeFds[2] = {-1, -1};
+    std::vector<std::shared_ptr<Connection>> m_connections;
+    //only touched by the polling thread, and by stop() once it is joined
+    std::vector<std::unique_ptr<Command>> m_commands;
+    //ReadFile and ListDirectory jobs on the pool, they hold this
+    Threading::WaitGroup m_jobs;
+  };
+}// namespace HummingBirdCore::Remote
@@ -0,0 +1,108 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "Protocol.h"
+
+#include <unordered_set>
+
+namespace HummingBirdCore::Remote {
+  void appendFrame(std::vector<uint8_t> &out, uint32_t requestId, MessageType type, const std::vector<uint8_t> &payload) {
+    const uint32_t size = Workspace::toLittleEndian((uint32_t) payload.size());
+    requestId = Workspace::toLittleEndian(requestId);
+    const size_t offset = out.size();
+    out.resize(offset + c_frameHeaderSize + payload.size());
+    std::memcpy(out.data() + offset, &size, sizeof(size));
+    std::memcpy(out.data() + offset + sizeof(size), &requestId, sizeof(requestId));
+    out[offset + 2 * sizeof(uint32_t)] = type;
+    if (!payload.empty())
+      std::memcpy(out.data() + offset + c_frameHeaderSize, payload.data(), payload.size());
+  }
+
+  bool FrameReader::next(Frame &frame) {
+    if (m_failed || m_buffer.size() - m_offset < c_frameHeaderSize)
+      return false;
+
+    uint32_t size = 0;
+    std::memcpy(&size, m_buffer.data() + m_offset, sizeof(size));
+    size = Workspace::toLittleEndian(size);
+    if (size > m_maxFrameSize) {
+      m_failed = true;
+      return false;
+    }
+    if (m_buffer.size() - m_offset < c_frameHeaderSize + size)
+      return false;
+
+    const uint8_t *header = m_buffer.data() + m_offset;
+    std::memcpy(&frame.requestId, header + sizeof(uint32_t), sizeof(frame.requestId));
+    frame.requestId = Workspace::toLittleEndian(frame.requestId);
+    frame.type = (MessageType) header[2 * sizeof(uint32_t)];
+    frame.payload.assign(header + c_frameHeaderSize, header + c_frameHeaderSize + size);
+    m_offset += c_frameHeaderSize + size;
+
+    //drop the consumed frames once they make up most of the buffer, instead of shifting after every frame
+    if (m_offset == m_buffer.size()) {
+      m_buffer.clear();
+      m_offset = 0;
+    } else if (m_offset > m_buffer.size() / 2) {
+      m_buffer.erase(m_buffer.begin(), m_buffer.begin() + (ptrdiff_t) m_offset);
+      m_offset = 0;
+    }
+    return true;
+  }
+
+  bool DeltaEncoder::encode(const KeyValues &state, Workspace::SnapshotWriter &writer) {
+    std::vector<const std::pair<std::string, std::string> *> changed;
+    size_t known = 0;
+    for (const auto &entry: state) {
+      auto sent = m_sent.find(entry.first);
+      if (sent != m_sent.end())
+        known++;
+      if (sent == m_sent.end() || sent->second != entry.second)
+        changed.push_back(&entry);
+    }
+
+    //only look for removed keys when some of the sent ones are missing from the state
+    std::vector<std::string> removed;
+    if (known < m_sent.size()) {
+      std::unordered_set<std::string_view> keys;
+      keys.reserve(state.size());
+      for (const auto &entry: state) {
+        keys.insert(entry.first);
+      }
+      for (const auto &[key, value]: m_sent) {
+        if (!keys.contains(key))
+          removed.push_back(key);
+      }
+    }
+
+    if (changed.empty() && removed.empty())
+      return false;
+
+    writer.writeU32((uint32_t) changed.size());
+    for (const auto *entry: changed) {
+      writer.writeString(entry->first);
+      writer.writeString(entry->second);
+      m_sent[entry->first] = entry->second;
+    }
+    writer.writeU32((uint32_t) removed.size());
+    for (const auto &key: removed) {
+      writer.writeString(key);
+      m_sent.erase(key);
+    }
+    return true;
+  }
+
+  bool applyDelta(Workspace::SnapshotReader &reader, std::map<std::string, std::string> &state) {
+    const uint32_t changedCount = reader.readCount(2 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < changedCount; i++) {
+      std::string key(reader.readString());
+      state[std::move(key)] = reader.readString();
+    }
+    const uint32_t removedCount = reader.readCount(sizeof(uint32_t));
+    for (uint32_t i = 0; i < removedCount; i++) {
+      state.erase(std::string(reader.readString()));
+    }
+    return reader.isValid();
+  }
+}// namespace HummingBirdCore::Remote
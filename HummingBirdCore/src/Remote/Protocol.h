@@ -0,0 +1,116 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Workspace/Snapshot.h"
+
+namespace HummingBirdCore::Remote {
+  /**
+   * @brief Wire format between the UI and HummingBirdAgent.
+   *
+   * Every message is one frame: u32 payload size, u32 request id, u8 message type, payload. Payloads are written
+   * with Workspace::SnapshotWriter, so strings are a u32 length and the bytes and everything is little endian.
+   * A client does not wait for a response before it sends the next request, the agent answers in whatever order the
+   * requests finish and the request id pairs them up again.
+   *
+   * Requests and their answers:
+   *   Hello          string token, u32 version           -> Result string hostname, u32 version
+   *   ReadFile       string path                         -> Result bytes
+   *   ListDirectory  string path, string extension       -> Result u32 count, count x string path
+   *   RunCommand     string command, string location     -> Output string line, ..., then Result i32 exit code
+   *   Subscribe      string topic                        -> Delta, ... until the request is cancelled
+   *   Cancel         (the id of the request to cancel)   -> nothing
+   * Any request can be answered with Error string message instead. Hello has to be the first request.
+   */
+  enum MessageType : uint8_t {
+    MessageHello = 1,
+    MessageReadFile,
+    MessageListDirectory,
+    MessageRunCommand,
+    MessageSubscribe,
+    MessageCancel,
+
+    MessageResult = 64,
+    MessageError,
+    MessageOutput,
+    MessageDelta
+  };
+
+  static constexpr uint32_t c_protocolVersion = 1;
+  static constexpr uint16_t c_defaultPort = 7421;
+  static constexpr size_t c_frameHeaderSize = 2 * sizeof(uint32_t) + sizeof(uint8_t);
+  //a frame announcing more than this is treated as a broken stream
+  static constexpr uint32_t c_maxFrameSize = 64 * 1024 * 1024;
+  //the limit until the Hello was accepted, whoever does not know the token can not make the agent buffer 64 MB
+  static constexpr uint32_t c_maxHelloFrameSize = 4 * 1024;
+
+  //the agent serves the stats registry and its system load under this topic
+  inline constexpr const char *c_topicStats = "stats";
+
+  struct Frame {
+    uint32_t requestId = 0;
+    MessageType type = MessageError;
+    std::vector<uint8_t> payload;
+
+    Workspace::SnapshotReader getReader() const { return Workspace::SnapshotReader(payload.data(), payload.size()); }
+  };
+
+  /**
+   * @brief Appends one frame to out.
+   */
+  void appendFrame(std::vector<uint8_t> &out, uint32_t requestId, MessageType type, const std::vector<uint8_t> &payload);
+
+  /**
+   * @brief Cuts complete frames off the bytes received so far.
+   */
+  class FrameReader {
+public:
+    void append(const uint8_t *data, size_t size) { m_buffer.insert(m_buffer.end(), data, data + size); }
+
+    /**
+     * @return false until a whole frame arrived, or once the stream is broken
+     */
+    bool next(Frame &frame);
+
+    bool isValid() const { return !m_failed; }
+
+    /**
+     * @brief Frames announcing more than maxFrameSize break the stream from the next frame on.
+     */
+    void setMaxFrameSize(uint32_t maxFrameSize) { m_maxFrameSize = maxFrameSize; }
+
+private:
+    std::vector<uint8_t> m_buffer;
+    size_t m_offset = 0;
+    uint32_t m_maxFrameSize = c_maxFrameSize;
+    bool m_failed = false;
+  };
+
+  using KeyValues = std::vector<std::pair<std::string, std::string>>;
+
+  /**
+   * @brief Remembers what a subscriber was sent last and writes only what changed since.
+   *
+   * Delta payload: u32 changed count, changed x (string key, string value), u32 removed count, removed x string key.
+   * The first delta of a subscription holds the whole state.
+   */
+  class DeltaEncoder {
+public:
+    /**
+     * @return false when nothing changed, there is nothing to send then
+     */
+    bool encode(const KeyValues &state, Workspace::SnapshotWriter &writer);
+
+private:
+    std::unordered_map<std::string, std::string> m_sent;
+  };
+
+  /**
+   * @brief Applies a delta payload to the state the subscriber keeps.
+   * @return false when the payload is corrupt
+   */
+  bool applyDelta(Workspace::SnapshotReader &reader, std::map<std::string, std::string> &state);
+}// namespace HummingBirdCore::Remote
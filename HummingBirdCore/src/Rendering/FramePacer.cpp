@@ -0,0 +1,106 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "FramePacer.h"
+
+#include <HBUI/HBUI.h>
+#include <GLFW/glfw3.h>
+
+namespace HummingBirdCore::Rendering {
+  void FramePacer::setIdleMode(bool enabled) {
+    if (s_idleMode.exchange(enabled) == enabled)
+      return;
+
+    CORE_INFO("Idle rendering {0}", enabled ? "enabled" : "disabled");
+    requestFrame();
+  }
+
+  void FramePacer::requestFrame() {
+    int requested = s_requestedFrames.load();
+    while (requested < 1 && !s_requestedFrames.compare_exchange_weak(requested, 1)) {
+    }
+
+    if (s_idleMode.load())
+      glfwPostEmptyEvent();
+  }
+
+  void FramePacer::requestFrameIn(double seconds) {
+    if (seconds <= 0.0) {
+      requestFrame();
+      return;
+    }
+
+    const int64_t deadline = nowNs() + (int64_t) (seconds * 1e9);
+    int64_t current = s_nextDeadlineNs.load();
+    while (deadline < current && !s_nextDeadlineNs.compare_exchange_weak(current, deadline)) {
+    }
+
+    //A sleeping loop has to recompute its timeout
+    if (s_idleMode.load() && deadline < current)
+      glfwPostEmptyEvent();
+  }
+
+  void FramePacer::waitForNextFrame() {
+    if (!s_idleMode.load())
+      return;
+
+    int requested = s_requestedFrames.load();
+    while (requested > 0) {
+      if (s_requestedFrames.compare_exchange_weak(requested, requested - 1))
+        return;
+    }
+
+    const int64_t start = nowNs();
+    int64_t deadline = s_nextDeadlineNs.load();
+    if (deadline <= start) {
+      s_nextDeadlineNs.compare_exchange_strong(deadline, c_noDeadline);
+      return;
+    }
+
+    if (deadline == c_noDeadline) {
+      glfwWaitEvents();
+    } else {
+      glfwWaitEventsTimeout((double) (deadline - start) / 1e9);
+    }
+
+    const int64_t end = nowNs();
+    s_idleNs += end - start;
+
+    deadline = s_nextDeadlineNs.load();
+    if (deadline <= end)
+      s_nextDeadlineNs.compare_exchange_strong(deadline, c_noDeadline);
+
+    //Whatever woke us up, give ImGui a few frames to process it
+    int current = s_requestedFrames.load();
+    while (current < c_settleFrames && !s_requestedFrames.compare_exchange_weak(current, c_settleFrames)) {
+    }
+  }
+
+  void FramePacer::endFrame() {
+    //Dragging, typing and open popups animate without telling us
+    if (s_idleMode.load()) {
+      const ImGuiIO &io = ImGui::GetIO();
+      if (ImGui::IsAnyItemActive() || io.WantTextInput || ImGui::IsAnyMouseDown())
+        requestFrame();
+    }
+
+    const int64_t now = nowNs();
+    if (s_statsStartNs == 0) {
+      s_statsStartNs = now;
+      return;
+    }
+
+    s_frameCount++;
+    const double elapsed = (double) (now - s_statsStartNs) / 1e9;
+    if (elapsed < c_statsInterval)
+      return;
+
+    s_frameRate = (float) (s_frameCount / elapsed);
+    s_idlePercentage = (float) std::clamp((double) s_idleNs / 1e9 / elapsed * 100.0, 0.0, 100.0);
+
+    s_statsStartNs = now;
+    s_idleNs = 0;
+    s_frameCount = 0;
+  }
+}// namespace HummingBirdCore::Rendering
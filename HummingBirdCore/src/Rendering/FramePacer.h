@@ -0,0 +1,75 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <atomic>
+
+namespace HummingBirdCore::Rendering {
+  /**
+   * @brief Decides when the frame loop is allowed to sleep.
+   *
+   * With idle mode off every frame is rendered back to back like before.
+   * With idle mode on the loop blocks on input, timers or posted work until something
+   * asks for a new frame. Windows that animate (the terminal caret, a streaming command)
+   * call requestFrame() / requestFrameIn() to keep frames coming.
+   */
+  class FramePacer {
+public:
+    static void setIdleMode(bool enabled);
+    static bool isIdleMode() { return s_idleMode.load(); }
+
+    /**
+     * @brief Renders at least one more frame, wakes the loop when it is sleeping.
+     * Safe to call from any thread.
+     */
+    static void requestFrame();
+
+    /**
+     * @brief Renders a frame after the given amount of seconds.
+     * Safe to call from any thread, the earliest request wins.
+     * @param seconds Time from now until the frame is needed
+     */
+    static void requestFrameIn(double seconds);
+
+    /**
+     * @brief Called by the application before every frame.
+     * Blocks when idle mode is on and nobody asked for a frame.
+     */
+    static void waitForNextFrame();
+
+    /**
+     * @brief Called by the application after every frame, keeps ImGui interactions smooth and updates the statistics.
+     */
+    static void endFrame();
+
+    static float getFrameRate() { return s_frameRate; }
+    static float getIdlePercentage() { return s_idlePercentage; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static int64_t nowNs() {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+private:
+    //ImGui needs a couple of frames after an event to settle hover states and popups
+    static constexpr int c_settleFrames = 3;
+    static constexpr int64_t c_noDeadline = std::numeric_limits<int64_t>::max();
+    static constexpr double c_statsInterval = 1.0;
+
+    inline static std::atomic<bool> s_idleMode = false;
+    inline static std::atomic<int> s_requestedFrames = 0;
+    inline static std::atomic<int64_t> s_nextDeadlineNs = c_noDeadline;
+
+    //stats, only touched on the main thread
+    inline static int64_t s_statsStartNs = 0;
+    inline static int64_t s_idleNs = 0;
+    inline static int s_frameCount = 0;
+    inline static float s_frameRate = 0.0f;
+    inline static float s_idlePercentage = 0.0f;
+  };
+}// namespace HummingBirdCore::Rendering
@@ -10,6 +10,9 @@ namespace HummingBirdCore::Security {
   }
 
   void HummingBirdCore::Security::LogInWindow::render() {
+    HB_PROFILE_SCOPE("LogInWindow::render");
+    if (!m_visibility.begin())
+      return;
 //    //Center the window
 //    Application *app = HummingBirdCore::Application::GetApplication();
 //
@@ -6,6 +6,8 @@
 #include <PCH/pch.h>
 #include <HBUI/HBUI.h>
 #include <HBUI/UIWindow.h>
+
+#include "UIWindows/WindowVisibility.h"
 namespace HummingBirdCore::Security {
 
   class LogInWindow : public UIWindow {
@@ -27,6 +29,7 @@ private:
     char m_password[32] = "admin";
     bool m_remember;
     bool m_failedLogin = false;
+    UI::WindowVisibility m_visibility;
   };
 
 }// namespace HummingBirdCore::Security
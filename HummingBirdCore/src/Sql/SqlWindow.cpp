@@ -6,10 +6,14 @@
 #include <Hummingbird_SQL/Structures.h>
 //#include <KDB_ImGui/Extension.h>
 #include <imgui.h>
+#include <Memory/FrameArena.h>
 
 namespace HummingBirdCore {
 
   void SqlWindow::render() {
+    HB_PROFILE_SCOPE("SqlWindow::render");
+    if (!m_visibility.begin())
+      return;
 
     if (!m_connection.isConnected()) {
       ImGui::InputText("Server Name", &m_inputServerName);
@@ -19,10 +23,11 @@ namespace HummingBirdCore {
         m_connection.connect(m_inputServerName, m_inputUserName, m_inputPassword, "", 33060);
       }
     } else {
-      const HummingBird::Sql::SchemaInfo currentSchema = m_connection.getCurrentSchema();
-      const HummingBird::Sql::TableInfo currentTable = currentSchema.getCurrentTable();
-      const std::vector<HummingBird::Sql::Row> currentTableRows = currentTable.getRows();
-      const auto schemas = m_connection.getSchemaNames();
+      //references, these used to copy the whole table every frame
+      const HummingBird::Sql::SchemaInfo &currentSchema = m_connection.getCurrentSchema();
+      const HummingBird::Sql::TableInfo &currentTable = currentSchema.getCurrentTable();
+      const std::vector<HummingBird::Sql::Row> &currentTableRows = currentTable.getRows();
+      const auto &schemas = m_connection.getSchemaNames();
 
       const int columnCount = currentTable.getColumnCount() - 1;
       const ImGuiWindowFlags c_topWindowFlags = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse;
@@ -59,8 +64,7 @@ namespace HummingBirdCore {
         {
           //HEADER That sticks on top
           {
-            std::string headerText = "Schemas for Server: " + m_connection.getHostname();
-            ImGui::Text(headerText.c_str());
+            ImGui::TextUnformatted(Memory::FrameArena::get().format("Schemas for Server: {}", m_connection.getHostname()));
           }
 
           ImGuiChildFlags leftSchemaChildFlags = ImGuiChildFlags_Border;
@@ -97,8 +101,7 @@ namespace HummingBirdCore {
 
         ImGui::BeginChild("##rightChild", ImVec2(0,0), true);
         {
-          const std::string headerText = "Table: " + currentTable.getName() + " in Schema: " + currentSchema.getName();
-          ImGui::Text(headerText.c_str());
+          ImGui::TextUnformatted(Memory::FrameArena::get().format("Table: {} in Schema: {}", currentTable.getName(), currentSchema.getName()));
           ImGui::BeginChild("##rightChildTable", {});
           {
             ImGui::Separator();
@@ -115,10 +118,18 @@ namespace HummingBirdCore {
                                              ImGuiTableFlags_Reorderable;
                 ImGuiTableColumnFlags columnFlags = ImGuiTableColumnFlags_NoClip;
 
+                const std::string_view shownTable = Memory::FrameArena::get().format("{}.{}", currentSchema.getName(), currentTable.getName());
+                if (m_columnsOf != shownTable) {
+                  m_columnsOf = shownTable;
+                  m_columnNames.clear();
+                  for (int i = 0; i < columnCount; i++) {
+                    m_columnNames.emplace_back(std::string_view(currentTableRows[0].getColumn(i).getName()));
+                  }
+                }
+
                 if (ImGui::BeginTable("##table", columnCount, tableFlags)) {
                   ImGui::TableSetupScrollFreeze(columnCount, 1);
-                  for (int i = 0; i < columnCount; i++) {
-                    const std::string columnName = currentTable.getRows()[0].getColumn(i).getName();
+                  for (const auto &columnName: m_columnNames) {
                     ImGui::TableSetupColumn(columnName.c_str());
                   }
                   ImGui::TableHeadersRow();
@@ -126,9 +137,9 @@ namespace HummingBirdCore {
                   for (const auto &row: currentTableRows) {
                     ImGui::TableNextRow();
                     for (int i = 0; i < columnCount; i++) {
-                      const std::string value = row.getColumn(i).getValueAsString();
+                      const auto &value = row.getColumn(i).getValueAsString();
                       ImGui::TableSetColumnIndex(i);
-                      ImGui::Text(value.c_str());
+                      ImGui::TextUnformatted(value.c_str());
                     }
                   }
 
@@ -10,10 +10,13 @@
 #include <Hummingbird_SQL/Connection.h>
 #include <HBUI/UIWindow.h>
 
+#include "Memory/WindowMemoryResource.h"
+#include "UIWindows/WindowVisibility.h"
+
 namespace HummingBirdCore {
   class SqlWindow : public UIWindow {
 public:
-    SqlWindow(std::string name) : UIWindow(name) {
+    SqlWindow(std::string name) : UIWindow(name), m_memory(name, "sql") {
     }
 
     void render() override;
@@ -25,6 +28,12 @@ private:
 
     HummingBird::Sql::Connection m_connection;
     ImVec2 m_initialSize = ImVec2(-1, 0);
+    UI::WindowVisibility m_visibility;
+
+    //the rows belong to the connection, the column names of the shown table are kept here instead of copied every frame
+    Memory::WindowMemoryResource m_memory;
+    std::pmr::string m_columnsOf{&m_memory};
+    std::pmr::vector<std::pmr::string> m_columnNames{&m_memory};
   };
 }// namespace HummingBirdCore
 
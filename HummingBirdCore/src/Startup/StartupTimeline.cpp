@@ -0,0 +1,60 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "StartupTimeline.h"
+
+namespace HummingBirdCore::Startup {
+  void StartupTimeline::begin() {
+    s_start = std::chrono::steady_clock::now();
+    s_firstFrameMs = -1.0;
+    s_interactiveMs = -1.0;
+
+    std::lock_guard<std::mutex> lock(s_stagesMutex);
+    s_stages.clear();
+  }
+
+  double StartupTimeline::now() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s_start).count();
+  }
+
+  void StartupTimeline::addStage(const std::string &name, double startMs, bool async) {
+    const double endMs = now();
+    {
+      std::lock_guard<std::mutex> lock(s_stagesMutex);
+      s_stages.push_back({name, startMs, endMs, async});
+    }
+    CORE_TRACE("Startup stage {0} took {1:.2f} ms", name, endMs - startMs);
+  }
+
+  void StartupTimeline::markFirstFrame() {
+    if (s_firstFrameMs >= 0.0)
+      return;
+
+    s_firstFrameMs = now();
+    CORE_INFO("Time to first frame: {0:.2f} ms", s_firstFrameMs);
+  }
+
+  void StartupTimeline::markInteractive() {
+    if (isInteractive())
+      return;
+
+    s_interactiveMs = now();
+    logReport();
+  }
+
+  void StartupTimeline::logReport() {
+    std::vector<StartupStage> stages;
+    {
+      std::lock_guard<std::mutex> lock(s_stagesMutex);
+      stages = s_stages;
+    }
+    std::sort(stages.begin(), stages.end(), [](const StartupStage &a, const StartupStage &b) { return a.startMs < b.startMs; });
+
+    CORE_INFO("Time to interactive: {0:.2f} ms (first frame at {1:.2f} ms)", s_interactiveMs, s_firstFrameMs);
+    for (const auto &stage: stages) {
+      CORE_INFO("  {0:<28} {1:>8.2f} ms  [{2:>8.2f} - {3:>8.2f}]{4}", stage.name, stage.endMs - stage.startMs, stage.startMs,
+                stage.endMs, stage.async ? " async" : "");
+    }
+  }
+}// namespace HummingBirdCore::Startup
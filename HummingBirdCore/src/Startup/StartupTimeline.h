@@ -0,0 +1,58 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+namespace HummingBirdCore::Startup {
+  struct StartupStage {
+    std::string name;
+    double startMs = 0.0;
+    double endMs = 0.0;
+    bool async = false;
+  };
+
+  /**
+   * @brief Records how long the startup stages take, measured from Application::init().
+   *
+   * Stages run on the main thread or on a worker (async). Time to first frame is the moment the first
+   * frame is presented, time to interactive is the moment every stage finished. Both are logged with a
+   * per stage breakdown so cold start cost can be tracked.
+   */
+  class StartupTimeline {
+public:
+    static void begin();
+
+    /**
+     * @brief Records a finished stage. Safe to call from any thread.
+     * @param name Stage name shown in the log
+     * @param startMs Start of the stage, from now()
+     * @param async True when the stage ran on a worker thread
+     */
+    static void addStage(const std::string &name, double startMs, bool async = false);
+
+    static void markFirstFrame();
+    static void markInteractive();
+
+    static bool isInteractive() { return s_interactiveMs >= 0.0; }
+    static double getTimeToFirstFrame() { return s_firstFrameMs; }
+    static double getTimeToInteractive() { return s_interactiveMs; }
+
+    /**
+     * @brief Milliseconds since begin().
+     */
+    static double now();
+
+private:
+    static void logReport();
+
+private:
+    inline static std::chrono::steady_clock::time_point s_start = std::chrono::steady_clock::now();
+    inline static std::mutex s_stagesMutex;
+    inline static std::vector<StartupStage> s_stages = {};
+
+    inline static double s_firstFrameMs = -1.0;
+    inline static double s_interactiveMs = -1.0;
+  };
+}// namespace HummingBirdCore::Startup
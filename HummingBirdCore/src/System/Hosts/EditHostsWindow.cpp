@@ -6,23 +6,43 @@
 #include "EditHostsWindow.h"
 
 void HummingBirdCore::System::EditHostsWindow::render() {
+  HB_PROFILE_SCOPE("EditHostsWindow::render");
+  if (!m_visibility.begin())
+    return;
+  ImGui::SetNextItemWidth(c_targetWidth);
+  if (Remote::AgentRegistry::renderTargetSelector("Target", m_target))
+    loadHostsFile();
+  if (m_remoteRequestId != 0 && std::chrono::steady_clock::now() > m_remoteDeadline) {
+    cancelRemoteRead();
+    m_hostsFileLines.load([](Threading::AsyncProgress &) -> HostsFileLines {
+      throw std::runtime_error("The agent did not answer in time");
+    });
+  }
+
+  if (!m_hostsFileLines.poll()) {
+    m_hostsFileLines.renderPlaceholder("Reading hosts file");
+    return;
+  }
+  HostsFileLines &hostsFileLines = m_hostsFileLines.get();
 
 #ifdef __APPLE__
-  if(ImGui::Button("Save")){
+  if (!m_target.empty()) {
+    ImGui::TextDisabled("Read only, the hosts file of an agent can not be saved from here");
+  } else if(ImGui::Button("Save")){
 
     std::string finalString;
 
-    for (int row = 0; row < m_hostsFileLines.size(); row++) {
-      if (m_hostsFileLines[row].isCommnent())
+    for (int row = 0; row < hostsFileLines.size(); row++) {
+      if (hostsFileLines[row].isCommnent())
       {
         continue;
       }
-      if(!m_hostsFileLines[row].enabled)
+      if(!hostsFileLines[row].enabled)
       {
         finalString += "#";
       }
 
-      finalString += m_hostsFileLines[row].getIP() + " " + m_hostsFileLines[row].getHostname() + "\n";
+      finalString += hostsFileLines[row].getIP() + " " + hostsFileLines[row].getHostname() + "\n";
     }
 
     // Set the SUDO_ASKPASS environment variable
@@ -62,57 +82,155 @@ void HummingBirdCore::System::EditHostsWindow::render() {
     ImGui::TableSetupColumn("Actions");
     ImGui::TableHeadersRow();
 
-    for (int row = 0; row < m_hostsFileLines.size(); row++) {
-      if (m_hostsFileLines[row].isCommnent())
+    for (int row = 0; row < hostsFileLines.size(); row++) {
+      if (hostsFileLines[row].isCommnent())
         continue;
 
       ImGui::TableNextRow();// Move to the next row
-
+      //the row index keeps the widget ids unique, no need to build strings for it
+      ImGui::PushID(row);
 
       int column = 0;
-      std::string uidIP = m_hostsFileLines[row].getOriginalIP() + std::to_string(row) + std::to_string(column);
-      
-
       ImGui::TableSetColumnIndex(column++);
-      std::string checkboxID = "##"+ uidIP + "-checkbox";
-      ImGui::Checkbox(checkboxID.c_str(), &m_hostsFileLines[row].enabled);
+      ImGui::Checkbox("##enabled", &hostsFileLines[row].enabled);
 
       ImGui::TableSetColumnIndex(column++);
       char ipBuffer[256];
-      strncpy(ipBuffer, m_hostsFileLines[row].getIP().c_str(), sizeof(ipBuffer));
+      strncpy(ipBuffer, hostsFileLines[row].getIP().c_str(), sizeof(ipBuffer));
       ipBuffer[sizeof(ipBuffer) - 1] = 0;// Ensure null termination
-      std::string labelip = "##" + uidIP;
-      if (ImGui::InputText(labelip.c_str(), ipBuffer, sizeof(ipBuffer))) {
-        m_hostsFileLines[row].setIP(ipBuffer);
+      if (ImGui::InputText("##ip", ipBuffer, sizeof(ipBuffer))) {
+        hostsFileLines[row].setIP(ipBuffer);
       }
 
       ImGui::TableSetColumnIndex(column++);
       char hostnameBuffer[256];
-      strncpy(hostnameBuffer, m_hostsFileLines[row].getHostname().c_str(), sizeof(hostnameBuffer));
+      strncpy(hostnameBuffer, hostsFileLines[row].getHostname().c_str(), sizeof(hostnameBuffer));
       hostnameBuffer[sizeof(hostnameBuffer) - 1] = 0;// Ensure null termination
-      std::string uidHostname = m_hostsFileLines[row].getOriginalHostname() + std::to_string(row) + std::to_string(column);
-      std::string labelhostname = "##" + uidHostname;
-      if (ImGui::InputText(labelhostname.c_str(), hostnameBuffer, sizeof(hostnameBuffer))) {
-        m_hostsFileLines[row].setHostname(hostnameBuffer);
+      if (ImGui::InputText("##hostname", hostnameBuffer, sizeof(hostnameBuffer))) {
+        hostsFileLines[row].setHostname(hostnameBuffer);
       }
 
       ImGui::TableSetColumnIndex(column++);
       if (ImGui::Button("Reset IP")) {
-        m_hostsFileLines[row].setIP(m_hostsFileLines[row].getOriginalIP().c_str());
+        hostsFileLines[row].setIP(hostsFileLines[row].getOriginalIP().c_str());
       }
 
       ImGui::TableSetColumnIndex(column++);
       if (ImGui::Button("Reset Hostname")) {
-        m_hostsFileLines[row].setHostname(m_hostsFileLines[row].getOriginalHostname().c_str());
+        hostsFileLines[row].setHostname(hostsFileLines[row].getOriginalHostname().c_str());
       }
 
       ImGui::TableSetColumnIndex(column++);
 
       if (ImGui::Button("Reset")) {
-        m_hostsFileLines[row].reset();
+        hostsFileLines[row].reset();
       }
+      ImGui::PopID();
     }
 
     ImGui::EndTable();
   }
 }
+
+//unsaved edits are part of the snapshot, the original values stay around so reset still works
+HummingBirdCore::System::EditHostsWindow::EditHostsWindow(const std::string &name, Workspace::SnapshotReader &reader) : UIWindow(name, ImGuiWindowFlags_None), m_memory(name, "hosts") {
+  //saved while the file was still being read, read it again
+  if (!reader.readBool()) {
+    loadHostsFile();
+    return;
+  }
+
+  const uint32_t lineCount = reader.readCount(4 * sizeof(uint32_t));
+  HostsFileLines hostsFileLines(&m_memory);
+  hostsFileLines.reserve(lineCount);
+  for (uint32_t i = 0; i < lineCount && reader.isValid(); i++) {
+    const uint8_t type = reader.readU8();
+    if (type > UNKNOWN) {
+      reader.fail();
+      break;
+    }
+    const std::string_view originalIP = reader.readString();
+    const std::string_view originalHostname = reader.readString();
+    const bool originalEnabled = reader.readBool();
+
+    HostsFileLine &line = hostsFileLines.emplace_back((TokenType) type, originalIP, originalHostname, originalEnabled, &m_memory);
+    line.setIP(std::string(reader.readString()).c_str());
+    line.setHostname(std::string(reader.readString()).c_str());
+    line.enabled = reader.readBool();
+  }
+  m_hostsFileLines.set(std::move(hostsFileLines));
+}
+
+void HummingBirdCore::System::EditHostsWindow::loadHostsFile() {
+  cancelRemoteRead();
+  //the regexes are slow enough to notice, parse on a worker
+  if (m_target.empty()) {
+    m_hostsFileLines.load([path = c_hostsPath](Threading::AsyncProgress &) { return parseHostsFile(path); },
+                          [this](HostsFileLines &&lines) { return adoptLines(std::move(lines)); });
+    return;
+  }
+
+  std::shared_ptr<Remote::AgentClient> agent = Remote::AgentRegistry::get(m_target);
+  if (agent == nullptr) {
+    m_hostsFileLines.load([target = m_target](Threading::AsyncProgress &) -> HostsFileLines {
+      throw std::runtime_error("Agent " + target + " was removed");
+    });
+    return;
+  }
+  //the lines of the previous target do not belong to this one, the placeholder shows until the answer is parsed
+  m_hostsFileLines.reset();
+  Workspace::SnapshotWriter writer;
+  writer.writeString(c_hostsPath);
+  //nothing waits for the agent, the answer starts the parse on a worker from the main thread. render() gives up at
+  //the deadline
+  auto onFrame = [this, lifetime = std::weak_ptr<bool>(m_lifetime)](const Remote::Frame &frame) {
+    Threading::MainThreadQueue::post(lifetime, [this, frame] {
+      if (frame.requestId != m_remoteRequestId)
+        return;
+      m_remoteAgent.reset();
+      m_remoteRequestId = 0;
+      m_hostsFileLines.load([frame](Threading::AsyncProgress &) {
+        Workspace::SnapshotReader reader = Remote::AgentClient::checkResult(frame);
+        std::istringstream hostsFile{std::string(reader.readString())};
+        return parseHostsFile(hostsFile);
+      }, [this](HostsFileLines &&lines) { return adoptLines(std::move(lines)); });
+    });
+  };
+  m_remoteRequestId = agent->stream(Remote::MessageReadFile, writer.getBuffer(), std::move(onFrame));
+  m_remoteAgent = agent;
+  m_remoteDeadline = std::chrono::steady_clock::now() + c_remoteTimeout;
+}
+
+void HummingBirdCore::System::EditHostsWindow::cancelRemoteRead() {
+  if (std::shared_ptr<Remote::AgentClient> agent = m_remoteAgent.lock())
+    agent->cancel(m_remoteRequestId);
+  m_remoteAgent.reset();
+  m_remoteRequestId = 0;
+}
+
+HummingBirdCore::System::EditHostsWindow::HostsFileLines HummingBirdCore::System::EditHostsWindow::adoptLines(HostsFileLines &&lines) {
+  //reserved up front, growing would copy the lines back into the default resource
+  HostsFileLines adopted(&m_memory);
+  adopted.reserve(lines.size());
+  for (const HostsFileLine &line: lines) {
+    adopted.emplace_back(line, &m_memory);
+  }
+  return adopted;
+}
+
+void HummingBirdCore::System::EditHostsWindow::writeSnapshot(Workspace::SnapshotWriter &writer) const {
+  writer.writeBool(m_hostsFileLines.isReady());
+  if (!m_hostsFileLines.isReady())
+    return;
+
+  writer.writeU32((uint32_t) m_hostsFileLines.get().size());
+  for (const auto &line: m_hostsFileLines.get()) {
+    writer.writeU8((uint8_t) line.getType());
+    writer.writeString(line.getOriginalIP());
+    writer.writeString(line.getOriginalHostname());
+    writer.writeBool(line.getOriginalEnabled());
+    writer.writeString(line.getIP());
+    writer.writeString(line.getHostname());
+    writer.writeBool(line.enabled);
+  }
+}
@@ -12,8 +12,15 @@
 
 #include <HBUI/UIWindow.h>
 
+#include "Memory/WindowMemoryResource.h"
+#include "Remote/AgentRegistry.h"
+#include "Threading/AsyncModel.h"
+#include "Threading/MainThreadQueue.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
+
 namespace HummingBirdCore::System {
-  class EditHostsWindow : public HummingBirdCore::UIWindow {
+  class EditHostsWindow : public HummingBirdCore::UIWindow, public Workspace::ISnapshotWindow {
 private:
     enum TokenType {
       IPV4_str,
@@ -26,11 +33,18 @@ private:
 
     struct HostsFileLine {
   public:
-      HostsFileLine(TokenType type, std::string ip, std::string hostname, bool enabled) : c_type(type), c_originalIP(ip),
-                                                                                          c_originalHostname(hostname),
-                                                                                          c_originalEnabled(enabled),
-                                                                                          m_ip(ip), m_hostname(hostname),
-                                                                                          enabled(enabled) {}
+      HostsFileLine(TokenType type, std::string_view ip, std::string_view hostname, bool enabled,
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+          : enabled(enabled), c_originalIP(ip, resource), c_originalHostname(hostname, resource), c_originalEnabled(enabled),
+            c_type(type), m_ip(ip, resource), m_hostname(hostname, resource) {}
+
+      /**
+       * @brief Copies a line, with its edits, into resource.
+       */
+      HostsFileLine(const HostsFileLine &other, std::pmr::memory_resource *resource)
+          : enabled(other.enabled), c_originalIP(other.c_originalIP, resource), c_originalHostname(other.c_originalHostname, resource),
+            c_originalEnabled(other.c_originalEnabled), c_type(other.c_type), m_ip(other.m_ip, resource),
+            m_hostname(other.m_hostname, resource) {}
 
       void setIP(const char string[256]) {
         m_ip = string;
@@ -40,18 +54,26 @@ private:
         m_hostname = string;
       }
 
-      std::string getOriginalIP() const {
+      const std::pmr::string &getOriginalIP() const {
         return c_originalIP;
       }
 
-      std::string getOriginalHostname() const {
+      const std::pmr::string &getOriginalHostname() const {
         return c_originalHostname;
       }
 
-      std::string getHostname() const {
+      bool getOriginalEnabled() const {
+        return c_originalEnabled;
+      }
+
+      TokenType getType() const {
+        return c_type;
+      }
+
+      const std::pmr::string &getHostname() const {
         return m_hostname;
       }
-      std::string getIP() const {
+      const std::pmr::string &getIP() const {
         return m_ip;
       }
 
@@ -89,51 +111,80 @@ private:
       bool enabled;
 
   private:
-      const std::string c_originalIP;
-      const std::string c_originalHostname;
+      const std::pmr::string c_originalIP;
+      const std::pmr::string c_originalHostname;
       const bool c_originalEnabled;
       const TokenType c_type;
 
-      std::string m_ip;
-      std::string m_hostname;
+      std::pmr::string m_ip;
+      std::pmr::string m_hostname;
     };
 
+    using HostsFileLines = std::pmr::vector<HostsFileLine>;
+
 public:
     EditHostsWindow(const std::string &name) : EditHostsWindow(ImGuiWindowFlags_None, name) {}
-    EditHostsWindow(const ImGuiWindowFlags flags, const std::string &name) : UIWindow(name, flags) {
-      parseHostsFile();
+    EditHostsWindow(const ImGuiWindowFlags flags, const std::string &name) : UIWindow(name, flags), m_memory(name, "hosts") {
+      loadHostsFile();
     }
+    EditHostsWindow(const std::string &name, Workspace::SnapshotReader &reader);
 
     void render() override;
 
+    const char *getSnapshotType() const override { return "EditHosts"; }
+    void writeSnapshot(Workspace::SnapshotWriter &writer) const override;
+
 private:
-    [[nodiscard]] const bool isIPv4str(const std::string &str) const {
-      return std::regex_match(str, c_ipv4_regex);
+    /**
+     * @brief Reads the hosts file of the target, the one of this machine when there is none.
+     */
+    void loadHostsFile();
+
+    /**
+     * @brief Stops waiting for the agent, an answer that still comes in is dropped.
+     */
+    void cancelRemoteRead();
+
+    /**
+     * @brief Moves lines parsed on a worker into the memory of this window.
+     */
+    HostsFileLines adoptLines(HostsFileLines &&lines);
+
+    [[nodiscard]] static bool isIPv4str(const std::string &str) {
+      return std::regex_match(str, getIPv4Regex());
     }
 
-    [[nodiscard]] const bool isIPv6str(const std::string &str) const {
-      return std::regex_match(str, c_ipv6_regex);
+    [[nodiscard]] static bool isIPv6str(const std::string &str) {
+      return std::regex_match(str, getIPv6Regex());
     }
 
-    [[nodiscard]] const bool isComment(const std::string &str) {
-      return std::regex_match(str, c_comment_regex);
+    [[nodiscard]] static bool isComment(const std::string &str) {
+      return std::regex_match(str, getCommentRegex());
     }
 
-    [[nodiscard]] const bool isHostname(const std::string &str) const {
-      return std::regex_match(str, c_hostname_regex);
+    [[nodiscard]] static bool isHostname(const std::string &str) {
+      return std::regex_match(str, getHostnameRegex());
     }
 
-    [[nodiscard]] const bool isUnknown(const std::string &str) const {
-      return std::regex_match(str, c_hostname_regex);
+    [[nodiscard]] static bool isUnknown(const std::string &str) {
+      return std::regex_match(str, getHostnameRegex());
     }
 
-    [[nodiscard]] const bool isNewline(const std::string &str) const {
-      return std::regex_match(str, c_hostname_regex);
+    [[nodiscard]] static bool isNewline(const std::string &str) {
+      return std::regex_match(str, getHostnameRegex());
     }
 
-    void parseHostsFile() {
+public:
+    //also run by HummingBirdBench on generated hosts files
+    static HostsFileLines parseHostsFile(const std::string &path) {
       //open /etc/hosts
-      std::ifstream hostsFile(c_hostsPath);
+      std::ifstream hostsFile(path);
+      return parseHostsFile(hostsFile);
+    }
+
+    //runs on a worker, only touches its arguments and the shared regexes
+    static HostsFileLines parseHostsFile(std::istream &hostsFile) {
+      HostsFileLines hostsFileLines;
       std::string line;
 
       while (std::getline(hostsFile, line)) {
@@ -148,7 +199,7 @@ private:
               std::string hostname;
               if (ss >> hostname) {
                 HostsFileLine hostsLine = {type, token, hostname, true};
-                m_hostsFileLines.push_back(hostsLine);
+                hostsFileLines.push_back(hostsLine);
               }
               break;
             }
@@ -157,7 +208,7 @@ private:
               std::string hostname;
               if (ss >> hostname) {
                 HostsFileLine hostsLine = {type, token, hostname, true};
-                m_hostsFileLines.push_back(hostsLine);
+                hostsFileLines.push_back(hostsLine);
               }
               break;
             }
@@ -171,17 +222,17 @@ private:
                 std::string hostname;
                 if (ss >> hostname) {
                   HostsFileLine hostsLine = {type, toCheck, hostname, false};
-                  m_hostsFileLines.push_back(hostsLine);
+                  hostsFileLines.push_back(hostsLine);
                 }
               } else if (type == IPV6_str) {
                 std::string hostname;
                 if (ss >> hostname) {
                   HostsFileLine hostsLine = {type, toCheck, hostname, false};
-                  m_hostsFileLines.push_back(hostsLine);
+                  hostsFileLines.push_back(hostsLine);
                 }
               } else {
                 HostsFileLine hostsLine = {TokenType::COMMENT, token, "", true};
-                m_hostsFileLines.push_back(hostsLine);
+                hostsFileLines.push_back(hostsLine);
               }
 
               break;
@@ -198,10 +249,11 @@ private:
         }
       }
 
-      hostsFile.close();
+      return hostsFileLines;
     }
 
-    TokenType getTokenType(const std::string &str) {
+private:
+    static TokenType getTokenType(const std::string &str) {
       if (isIPv6str(str)) {
         return IPV6_str;
       } else if (isIPv4str(str)) {
@@ -229,11 +281,37 @@ private:
     const std::string c_hostsPath = "C:\\Windows\\System32\\drivers\\etc\\hosts";
     const std::string c_tempFilePath = "C:\\AppData\\Local\\Temp\\hosts_temp";
 #endif
-    std::vector<HostsFileLine> m_hostsFileLines;
-
-    const std::regex c_ipv4_regex = std::regex(R"((\b25[0-5]|\b2[0-4][0-9]|\b[01]?[0-9][0-9]?)(\.(25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)){3})");
-    const std::regex c_ipv6_regex = std::regex(R"((([0-9a-fA-F]{1,4}:){7,7}[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,7}:|([0-9a-fA-F]{1,4}:){1,6}:[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,5}(:[0-9a-fA-F]{1,4}){1,2}|([0-9a-fA-F]{1,4}:){1,4}(:[0-9a-fA-F]{1,4}){1,3}|([0-9a-fA-F]{1,4}:){1,3}(:[0-9a-fA-F]{1,4}){1,4}|([0-9a-fA-F]{1,4}:){1,2}(:[0-9a-fA-F]{1,4}){1,5}|[0-9a-fA-F]{1,4}:((:[0-9a-fA-F]{1,4}){1,6})|:((:[0-9a-fA-F]{1,4}){1,7}|:)|fe80:(:[0-9a-fA-F]{0,4}){0,4}%[0-9a-zA-Z]{1,}|::(ffff(:0{1,4}){0,1}:){0,1}((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])|([0-9a-fA-F]{1,4}:){1,4}:((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])))");
-    const std::regex c_hostname_regex = std::regex(R"(([A-Za-z0-9]+[^#\n: \t]*))");
-    const std::regex c_comment_regex = std::regex(R"((#[^\n]*))");
+    //declared before the lines that live in it
+    Memory::WindowMemoryResource m_memory;
+    Threading::AsyncModel<HostsFileLines> m_hostsFileLines;
+    UI::WindowVisibility m_visibility;
+    //the agent to read the hosts file of, empty for this machine. Not part of the snapshot
+    std::string m_target;
+    //the read the agent still has to answer, 0 when there is none
+    std::weak_ptr<Remote::AgentClient> m_remoteAgent;
+    uint32_t m_remoteRequestId = 0;
+    std::chrono::steady_clock::time_point m_remoteDeadline = {};
+    //answers arrive on the agent thread, they are dropped once the window is gone
+    std::shared_ptr<bool> m_lifetime = std::make_shared<bool>(true);
+    static constexpr auto c_remoteTimeout = std::chrono::seconds(10);
+    static constexpr float c_targetWidth = 200.0f;
+
+    //compiled once on first use and shared, matching is safe from any thread
+    static const std::regex &getIPv4Regex() {
+      static const std::regex c_ipv4_regex = std::regex(R"((\b25[0-5]|\b2[0-4][0-9]|\b[01]?[0-9][0-9]?)(\.(25[0-5]|2[0-4][0-9]|[01]?[0-9][0-9]?)){3})");
+      return c_ipv4_regex;
+    }
+    static const std::regex &getIPv6Regex() {
+      static const std::regex c_ipv6_regex = std::regex(R"((([0-9a-fA-F]{1,4}:){7,7}[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,7}:|([0-9a-fA-F]{1,4}:){1,6}:[0-9a-fA-F]{1,4}|([0-9a-fA-F]{1,4}:){1,5}(:[0-9a-fA-F]{1,4}){1,2}|([0-9a-fA-F]{1,4}:){1,4}(:[0-9a-fA-F]{1,4}){1,3}|([0-9a-fA-F]{1,4}:){1,3}(:[0-9a-fA-F]{1,4}){1,4}|([0-9a-fA-F]{1,4}:){1,2}(:[0-9a-fA-F]{1,4}){1,5}|[0-9a-fA-F]{1,4}:((:[0-9a-fA-F]{1,4}){1,6})|:((:[0-9a-fA-F]{1,4}){1,7}|:)|fe80:(:[0-9a-fA-F]{0,4}){0,4}%[0-9a-zA-Z]{1,}|::(ffff(:0{1,4}){0,1}:){0,1}((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])|([0-9a-fA-F]{1,4}:){1,4}:((25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])\.){3,3}(25[0-5]|(2[0-4]|1{0,1}[0-9]){0,1}[0-9])))");
+      return c_ipv6_regex;
+    }
+    static const std::regex &getHostnameRegex() {
+      static const std::regex c_hostname_regex = std::regex(R"(([A-Za-z0-9]+[^#\n: \t]*))");
+      return c_hostname_regex;
+    }
+    static const std::regex &getCommentRegex() {
+      static const std::regex c_comment_regex = std::regex(R"((#[^\n]*))");
+      return c_comment_regex;
+    }
   };
 }// namespace HummingBirdCore::System
@@ -6,7 +6,132 @@
 
 namespace HummingBirdCore {
   namespace System {
+    namespace {
+      using PlistValue = std::variant<std::string, int, float, bool, Utils::PlistUtil::PlistNode::Date>;
+
+      void writeValue(Workspace::SnapshotWriter &writer, const PlistValue &value) {
+        writer.writeU8((uint8_t) value.index());
+        if (const auto *string = std::get_if<std::string>(&value)) {
+          writer.writeString(*string);
+        } else if (const auto *integer = std::get_if<int>(&value)) {
+          writer.writeI32(*integer);
+        } else if (const auto *real = std::get_if<float>(&value)) {
+          writer.writeF32(*real);
+        } else if (const auto *boolean = std::get_if<bool>(&value)) {
+          writer.writeBool(*boolean);
+        } else if (const auto *date = std::get_if<Utils::PlistUtil::PlistNode::Date>(&value)) {
+          writer.writeI32(date->month);
+          writer.writeI32(date->day);
+          writer.writeI32(date->hour);
+          writer.writeI32(date->minute);
+          writer.writeI32(date->weekday);
+        }
+      }
+
+      PlistValue readValue(Workspace::SnapshotReader &reader) {
+        switch (reader.readU8()) {
+          case 0:
+            return std::string(reader.readString());
+          case 1:
+            return reader.readI32();
+          case 2:
+            return reader.readF32();
+          case 3:
+            return reader.readBool();
+          case 4: {
+            Utils::PlistUtil::PlistNode::Date date = {};
+            date.month = reader.readI32();
+            date.day = reader.readI32();
+            date.hour = reader.readI32();
+            date.minute = reader.readI32();
+            date.weekday = reader.readI32();
+            return date;
+          }
+          default:
+            //an index this version does not know about, the payload can not be trusted any more
+            reader.fail();
+            return std::string();
+        }
+      }
+
+      void writeNode(Workspace::SnapshotWriter &writer, const Utils::PlistUtil::PlistNode &node) {
+        writer.writeString(node.key);
+        writer.writeU8((uint8_t) node.type);
+        writer.writeU8((uint8_t) node.parentType);
+        writer.writeBool(node.required);
+        writeValue(writer, node.placeholder);
+        writer.writeBool(node.value.has_value());
+        if (node.value.has_value())
+          writeValue(writer, node.value.value());
+
+        writer.writeU32((uint32_t) node.children.size());
+        for (const auto &[key, child]: node.children) {
+          writer.writeString(key);
+          writeNode(writer, child);
+        }
+      }
+
+      Utils::PlistUtil::PlistType readType(Workspace::SnapshotReader &reader) {
+        const uint8_t type = reader.readU8();
+        if (type > Utils::PlistUtil::PlistTypeNone) {
+          reader.fail();
+          return Utils::PlistUtil::PlistTypeNone;
+        }
+        return (Utils::PlistUtil::PlistType) type;
+      }
+
+      void readNode(Workspace::SnapshotReader &reader, Utils::PlistUtil::PlistNode &node) {
+        node.key = reader.readString();
+        node.type = readType(reader);
+        node.parentType = readType(reader);
+        node.required = reader.readBool();
+        node.placeholder = readValue(reader);
+        if (reader.readBool())
+          node.value = readValue(reader);
+
+        const uint32_t childCount = reader.readCount(2 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < childCount && reader.isValid(); i++) {
+          std::string key(reader.readString());
+          readNode(reader, node.children[key]);
+        }
+      }
+
+      void writeDaemon(Workspace::SnapshotWriter &writer, const LaunchDaemon &daemon) {
+        const Utils::File &file = daemon.getFile();
+        writer.writeString(file.getName());
+        writer.writeString(file.getPath());
+        writer.writeString(file.getExtension());
+        writer.writeString(file.content);
+        writer.writeBool(daemon.isSaved());
+
+        //daemons that failed to parse are written without a tree and parsed again on selection
+        const bool parsed = daemon.getPlist() != nullptr && daemon.getPlist()->getIsParsed();
+        writer.writeBool(parsed);
+        if (parsed)
+          writeNode(writer, daemon.getPlist()->getRootNode());
+      }
+
+      LaunchDaemon readDaemon(Workspace::SnapshotReader &reader) {
+        std::string name(reader.readString());
+        std::string path(reader.readString());
+        std::string extension(reader.readString());
+        std::string content(reader.readString());
+        const bool saved = reader.readBool();
+
+        auto plist = std::make_shared<Utils::PlistUtil::Plist>();
+        if (reader.readBool()) {
+          Utils::PlistUtil::PlistNode root;
+          readNode(reader, root);
+          plist->setRootNode(std::move(root));
+        }
+        return LaunchDaemon(Utils::File(name, path, extension, content), plist, saved);
+      }
+    }// namespace
+
     void LaunchDaemonsManager::render() {
+      HB_PROFILE_SCOPE("LaunchDaemonsManager::render");
+      if (!m_visibility.begin())
+        return;
       //      ImGui::BeginChild("LaunchDaemonsManager", ImVec2(0, 0), ImGuiChildFlags_AlwaysAutoResize | ImGuiChildFlags_AutoResizeX | ImGuiChildFlags_Border);
       //      //Left resizeable panel
       //      {
@@ -55,11 +180,44 @@ namespace HummingBirdCore {
       //      }
       //      ImGui::EndChild();
 
+      ImGui::SetNextItemWidth(c_targetWidth);
+      if (Remote::AgentRegistry::renderTargetSelector("Target", m_target)) {
+        //the selection belongs to the list of the previous target
+        m_selectedTab.clear();
+        m_selectedIdx = 0;
+        m_selectedDaemon = LaunchDaemon(Utils::File());
+        m_copyOfSelectedDaemonStart = LaunchDaemon(Utils::File());
+        m_reclaimed = false;
+        fetchAllDaemons();
+      }
+
+      if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows)) {
+        Memory::MemoryPressureManager::touch(this);
+        if (m_reclaimed && !m_userAgent.isReady() && !m_userAgent.isLoading())
+          fetchAllDaemons();
+      }
+
+      if (!m_userAgent.poll()) {
+        if (m_reclaimed && !m_userAgent.isLoading())
+          ImGui::TextDisabled("Unloaded to save memory, focus the window to load it again");
+        else
+          m_userAgent.renderPlaceholder("Loading launch agents");
+        return;
+      }
+
+      if (m_reclaimed) {
+        m_reclaimed = false;
+        //reclaim() only drops saved lists, the reloaded entry matches what the selection holds
+        LaunchDaemons &daemons = m_userAgent.get();
+        if (m_selectedIdx >= 0 && m_selectedIdx < (int) daemons.size() && daemons[m_selectedIdx].getFile().getFullPath() == m_selectedDaemon.getFile().getFullPath())
+          m_selectedDaemon = daemons[m_selectedIdx];
+      }
+
       ImGui::Columns(2, "mycolumns", true);
       ImGuiTabBarFlags tabBarFlags = ImGuiTabBarFlags_AutoSelectNewTabs | ImGuiTabBarFlags_Reorderable | ImGuiTabBarFlags_FittingPolicyScroll | ImGuiTabBarFlags_TabListPopupButton;
 
       if (ImGui::BeginTabBar("MyTabBar", tabBarFlags)) {
-        renderTab("User Agent", m_userAgent);
+        renderTab("User Agent", m_userAgent.get());
         ImGui::EndTabBar();
       }
 
@@ -76,9 +234,12 @@ namespace HummingBirdCore {
 
       if (plist != nullptr) {
         int index = 0;
+        //a remote daemon is a copy in a temporary folder, saving would only write the copy
+        ImGui::BeginDisabled(!m_target.empty());
         if (ImGui::Button("Save")) {
           daemon.save();
         }
+        ImGui::EndDisabled();
         ImGui::SameLine();
         if (ImGui::Button("Add calendar interval")) {
           plist->addCalendarIntervalToRootNode();
@@ -89,9 +250,15 @@ namespace HummingBirdCore {
         //compare nodes
         bool saved = true;
         //todo: make this in a function and make it recursive.
+        //find, operator[] would insert an empty node into the copy for every key that was added since
+        const auto &originalChildren = m_copyOfSelectedDaemonStart.getPlist()->getRootNode().children;
         for (auto &node: plist->getRootNode().children) {
-          std::string identifier = node.first;
-          Utils::PlistUtil::PlistNode originalNode = m_copyOfSelectedDaemonStart.getPlist()->getRootNode().children[identifier];
+          const auto original = originalChildren.find(node.first);
+          if (original == originalChildren.end()) {
+            saved = false;
+            continue;
+          }
+          const Utils::PlistUtil::PlistNode &originalNode = original->second;
           if (originalNode.value.has_value() && !node.second.value.has_value()) {
             saved = false;
           }
@@ -99,12 +266,12 @@ namespace HummingBirdCore {
             saved = false;
           }
           if (originalNode.value.has_value() && node.second.value.has_value()) {
-            std::variant<std::string, int, float, bool, Utils::PlistUtil::PlistNode::Date> foundValue = originalNode.getValue();
-            std::variant<std::string, int, float, bool, Utils::PlistUtil::PlistNode::Date> currentValue = node.second.getValue();
+            const std::variant<std::string, int, float, bool, Utils::PlistUtil::PlistNode::Date> &foundValue = *originalNode.value;
+            const std::variant<std::string, int, float, bool, Utils::PlistUtil::PlistNode::Date> &currentValue = node.second.getValue();
 
             if (Utils::PlistUtil::PlistType::PlistTypeString == originalNode.type) {
-              std::string originalValueStr = std::get<std::string>(foundValue);
-              std::string currentValueStr = std::get<std::string>(currentValue);
+              const std::string &originalValueStr = std::get<std::string>(foundValue);
+              const std::string &currentValueStr = std::get<std::string>(currentValue);
               if (originalValueStr != currentValueStr) {
                 saved = false;
               }
@@ -116,7 +283,7 @@ namespace HummingBirdCore {
         {
           ImGui::BeginChild("Daemon Left", ImVec2(ImGui::GetContentRegionAvail().x * 0.2f, 0), c_leftChildFlags, c_leftWindowFlags);
 
-          ImGui::Text(daemon.getFile().content.c_str());
+          ImGui::TextUnformatted(daemon.getFile().content.c_str());
 //          const char* label = "text";
 //          char *buf = new char[daemon.getFile().content.length() + 1];
 //          strcpy(buf, daemon.getFile().content.c_str());
@@ -140,17 +307,22 @@ namespace HummingBirdCore {
     }
 
     void LaunchDaemonsManager::renderNode(HummingBirdCore::Utils::PlistUtil::PlistNode &node, int index) {
-      std::string id = node.key + " - " + std::to_string(index);
+      const char *id = Memory::FrameArena::get().format("{} - {}", node.key, index);
       if (node.type == Utils::PlistUtil::PlistTypeString) {
-        std::string val = std::get<std::string>(node.getValue());
         int colorCount = 0;
         if (node.required && !node.value.has_value()) {
           ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
           colorCount++;
         }
 
-        if (ImGui::InputText(id.c_str(), &val)) {
-          node.setValue(val);
+        //a set value is edited in place, copying it every frame allocated for every string in the plist
+        if (node.value.has_value()) {
+          ImGui::InputText(id, &std::get<std::string>(*node.value));
+        } else {
+          m_placeholderBuffer.assign(std::get<std::string>(node.getValue()));
+          if (ImGui::InputText(id, &m_placeholderBuffer)) {
+            node.setValue(m_placeholderBuffer);
+          }
         }
 
         if (colorCount > 0) {
@@ -163,7 +335,7 @@ namespace HummingBirdCore {
           ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
           colorCount++;
         }
-        if (ImGui::InputInt(id.c_str(), &val)) {
+        if (ImGui::InputInt(id, &val)) {
           node.setValue(val);
         }
 
@@ -178,7 +350,7 @@ namespace HummingBirdCore {
           ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
           colorCount++;
         }
-        if (ImGui::Checkbox(id.c_str(), &val)) {
+        if (ImGui::Checkbox(id, &val)) {
           node.setValue(val);
         }
 
@@ -191,7 +363,7 @@ namespace HummingBirdCore {
           ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
           colorCount++;
         }
-        if (ImGui::TreeNode(id.c_str())) {
+        if (ImGui::TreeNode(id)) {
           int index = 0;
           for (auto &child: node.children) {
             renderNode(child.second, index);
@@ -209,7 +381,7 @@ namespace HummingBirdCore {
           ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
           colorCount++;
         }
-        if (ImGui::TreeNode(id.c_str())) {
+        if (ImGui::TreeNode(id)) {
           int index = 0;
           for (auto &child: node.children) {
             renderNode(child.second, index);
@@ -224,7 +396,7 @@ namespace HummingBirdCore {
           ImGui::PushStyleColor(ImGuiCol_Border, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
           colorCount++;
         }
-        if (ImGui::TreeNode(id.c_str())) {
+        if (ImGui::TreeNode(id)) {
           if (ImGui::InputInt("Weekday: ", &date.weekday)) {
             node.setValue(date);
           }
@@ -249,39 +421,122 @@ namespace HummingBirdCore {
       }
 
       if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip(node.getDescription().c_str());
+        ImGui::SetTooltip("Key: %s\nType: %d\nParentType: %d\nRequired: %d\nValue: %d\nChildren: %zu", node.key.c_str(), (int) node.type,
+                          (int) node.parentType, (int) node.required, (int) node.value.has_value(), node.children.size());
       }
     }
 
     void LaunchDaemonsManager::fetchAllDaemons() {
-      std::vector<HummingBirdCore::Utils::File> fileUserAgent = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_userAgentPath.string(), ".plist");
-      //TODO: REENABLE AND TEST
-      //      std::vector<HummingBirdCore::Utils::File> fileGlobalAgent = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_globalAgentPath.string(), ".plist");
-      //      std::vector<HummingBirdCore::Utils::File> fileGlobalDaemon = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_globalDaemonPath.string(), ".plist");
-      //      std::vector<HummingBirdCore::Utils::File> fileSystemAgent = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_SystemAgentPath.string(), ".plist");
-      //      std::vector<HummingBirdCore::Utils::File> fileSystemDaemon = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_SystemDaemonPath.string(), ".plist");
-
-      for (const auto &file: fileUserAgent) {
-        m_userAgent.emplace_back(std::move(file));
+      //reading and parsing every plist happens on a worker, render() shows a placeholder until the list is there.
+      //libxml2 has to be initialized once on the main thread before workers use it
+      xmlInitParser();
+      if (!m_target.empty()) {
+        fetchRemoteDaemons();
+        return;
       }
-      //      for (const auto &file: fileGlobalAgent) {
-      //        m_globalAgent.emplace_back(file);
-      //      }
-      //
-      //      for (const auto &file: fileGlobalDaemon) {
-      //        m_globalDaemon.emplace_back(file);
-      //      }
-      //
-      //      for (const auto &file: fileSystemAgent) {
-      //        m_systemAgent.emplace_back(file);
-      //      }
-      //
-      //      for (const auto &file: fileSystemDaemon) {
-      //        m_systemDaemon.emplace_back(file);
-      //      }
+      m_userAgent.load([path = c_userAgentPath](Threading::AsyncProgress &progress) {
+        std::vector<HummingBirdCore::Utils::File> fileUserAgent = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(path.string(), ".plist");
+        //TODO: REENABLE AND TEST
+        //      std::vector<HummingBirdCore::Utils::File> fileGlobalAgent = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_globalAgentPath.string(), ".plist");
+        //      std::vector<HummingBirdCore::Utils::File> fileGlobalDaemon = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_globalDaemonPath.string(), ".plist");
+        //      std::vector<HummingBirdCore::Utils::File> fileSystemAgent = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_SystemAgentPath.string(), ".plist");
+        //      std::vector<HummingBirdCore::Utils::File> fileSystemDaemon = HummingBirdCore::Utils::FolderUtils::getFilesInFolder(c_SystemDaemonPath.string(), ".plist");
+
+        LaunchDaemons userAgent;
+        userAgent.reserve(fileUserAgent.size());
+        for (auto &file: fileUserAgent) {
+          if (progress.isCancelled())
+            break;
+          userAgent.emplace_back(std::move(file));
+          progress.set((float) userAgent.size() / (float) fileUserAgent.size());
+        }
+        //      for (const auto &file: fileGlobalAgent) {
+        //        m_globalAgent.emplace_back(file);
+        //      }
+        //
+        //      for (const auto &file: fileGlobalDaemon) {
+        //        m_globalDaemon.emplace_back(file);
+        //      }
+        //
+        //      for (const auto &file: fileSystemAgent) {
+        //        m_systemAgent.emplace_back(file);
+        //      }
+        //
+        //      for (const auto &file: fileSystemDaemon) {
+        //        m_systemDaemon.emplace_back(file);
+        //      }
+        return userAgent;
+      }, [this](LaunchDaemons &&daemons) { return adoptDaemons(std::move(daemons)); });
+    }
+
+    void LaunchDaemonsManager::fetchRemoteDaemons() {
+      std::shared_ptr<Remote::AgentClient> agent = Remote::AgentRegistry::get(m_target);
+      if (agent == nullptr) {
+        m_userAgent.load([target = m_target](Threading::AsyncProgress &) -> LaunchDaemons {
+          throw std::runtime_error("Agent " + target + " was removed");
+        });
+        return;
+      }
+
+      Workspace::SnapshotWriter writer;
+      writer.writeString(c_userAgentPath.string());
+      writer.writeString(".plist");
+      auto listing = std::make_shared<std::future<Remote::Frame>>(agent->request(Remote::MessageListDirectory, writer.getBuffer()));
+      std::string folder = m_target;
+      std::replace(folder.begin(), folder.end(), ':', '_');
+      const std::filesystem::path mirror = std::filesystem::temp_directory_path() / "HummingBird" / "agents" / folder / "LaunchAgents";
+
+      m_userAgent.load([agent, listing, mirror](Threading::AsyncProgress &progress) {
+        if (listing->wait_for(c_remoteTimeout) != std::future_status::ready)
+          throw std::runtime_error("The agent did not answer in time");
+        const Remote::Frame listed = listing->get();
+        Workspace::SnapshotReader reader = Remote::AgentClient::checkResult(listed);
+
+        //every file is asked for before the first answer is read, the whole folder costs one round trip
+        const uint32_t fileCount = reader.readCount(sizeof(uint32_t));
+        std::vector<std::pair<std::filesystem::path, std::future<Remote::Frame>>> files;
+        files.reserve(fileCount);
+        for (uint32_t i = 0; i < fileCount; i++) {
+          std::filesystem::path path(reader.readString());
+          Workspace::SnapshotWriter request;
+          request.writeString(path.string());
+          files.emplace_back(mirror / path.filename(), agent->request(Remote::MessageReadFile, request.getBuffer()));
+        }
+
+        std::filesystem::create_directories(mirror);
+        LaunchDaemons userAgent;
+        userAgent.reserve(files.size());
+        for (auto &[path, answer]: files) {
+          if (progress.isCancelled())
+            break;
+          if (answer.wait_for(c_remoteTimeout) != std::future_status::ready)
+            throw std::runtime_error("The agent did not answer in time");
+          const Remote::Frame frame = answer.get();
+          Workspace::SnapshotReader contents = frame.getReader();
+          if (frame.type == Remote::MessageError) {
+            CORE_WARN("Skipping {0}: {1}", path.filename().string(), contents.readString());
+            continue;
+          }
+          const std::string_view bytes = contents.readString();
+          std::ofstream(path, std::ios::binary).write(bytes.data(), (std::streamsize) bytes.size());
+          userAgent.emplace_back(Utils::FileUtils::getFile(path));
+          progress.set((float) userAgent.size() / (float) files.size());
+        }
+        return userAgent;
+      }, [this](LaunchDaemons &&daemons) { return adoptDaemons(std::move(daemons)); });
+    }
+
+    LaunchDaemons LaunchDaemonsManager::adoptDaemons(LaunchDaemons &&daemons) {
+      //the plists stay where the worker parsed them, only the list itself moves
+      LaunchDaemons adopted(&m_memory);
+      adopted.reserve(daemons.size());
+      for (LaunchDaemon &daemon: daemons) {
+        adopted.push_back(std::move(daemon));
+      }
+      return adopted;
     }
 
-    bool LaunchDaemonsManager::selectDaemon(int idx, std::vector<LaunchDaemon> &daemons) {
+    bool LaunchDaemonsManager::selectDaemon(int idx, LaunchDaemons &daemons) {
       if (idx >= daemons.size()) {
         return false;
       }
@@ -301,7 +556,7 @@ namespace HummingBirdCore {
       return true;
     }
 
-    bool LaunchDaemonsManager::renderTab(const std::string &name, std::vector<LaunchDaemon> &daemons) {
+    bool LaunchDaemonsManager::renderTab(const std::string &name, LaunchDaemons &daemons) {
       bool tabOpen = true;
 
       if (ImGui::BeginTabItem(name.c_str(), &tabOpen, ImGuiTabItemFlags_None)) {
@@ -324,5 +579,82 @@ namespace HummingBirdCore {
       }
       return tabOpen;
     }
+
+    LaunchDaemonsManager::LaunchDaemonsManager(const std::string &name, Workspace::SnapshotReader &reader) : UIWindow(name, ImGuiWindowFlags_None), m_memory(name, "launch_daemons") {
+      Memory::MemoryPressureManager::add(this);
+      m_selectedTab = reader.readString();
+      m_selectedIdx = reader.readI32();
+      m_wrapText = reader.readBool();
+
+      //saved while the list was still loading, load it like a new window
+      if (!reader.readBool()) {
+        m_selectedTab.clear();
+        m_selectedIdx = 0;
+        fetchAllDaemons();
+        return;
+      }
+
+      const uint32_t daemonCount = reader.readCount(6 * sizeof(uint32_t));
+      LaunchDaemons userAgent(&m_memory);
+      userAgent.reserve(daemonCount);
+      for (uint32_t i = 0; i < daemonCount && reader.isValid(); i++) {
+        userAgent.push_back(readDaemon(reader));
+      }
+
+      //the selection shares its plist with the list entry like selectDaemon() does, the start copy is the tree on disk
+      LaunchDaemon original = readDaemon(reader);
+      if (m_selectedIdx >= 0 && m_selectedIdx < (int) userAgent.size()) {
+        m_selectedDaemon = userAgent[m_selectedIdx];
+        m_copyOfSelectedDaemonStart = std::move(original);
+      } else {
+        m_selectedIdx = 0;
+      }
+      m_userAgent.set(std::move(userAgent));
+    }
+
+    void LaunchDaemonsManager::writeSnapshot(Workspace::SnapshotWriter &writer) const {
+      writer.writeString(m_selectedTab);
+      writer.writeI32(m_selectedIdx);
+      writer.writeBool(m_wrapText);
+
+      writer.writeBool(m_userAgent.isReady());
+      if (!m_userAgent.isReady())
+        return;
+
+      writer.writeU32((uint32_t) m_userAgent.get().size());
+      for (const auto &daemon: m_userAgent.get()) {
+        writeDaemon(writer, daemon);
+      }
+      writeDaemon(writer, m_copyOfSelectedDaemonStart);
+    }
+
+    size_t LaunchDaemonsManager::getReclaimableBytes() const {
+      if (!m_userAgent.isReady())
+        return 0;
+
+      size_t bytes = 0;
+      for (const auto &daemon: m_userAgent.get()) {
+        //unsaved edits only live in the list
+        if (!daemon.isSaved())
+          return 0;
+        bytes += sizeof(LaunchDaemon) + daemon.getFile().content.capacity();
+        if (daemon.getPlist() != nullptr && daemon.getPlist()->getIsParsed())
+          bytes += Utils::PlistUtil::getNodeSize(daemon.getPlist()->getRootNode());
+      }
+      return bytes;
+    }
+
+    size_t LaunchDaemonsManager::reclaim() {
+      const size_t bytes = getReclaimableBytes();
+      if (bytes == 0 || !m_selectedDaemon.isSaved())
+        return 0;
+
+      m_userAgent.reset();
+      m_reclaimed = true;
+      //the pool keeps freed blocks around for the window, hand them back now that the list is gone
+      if (m_memory.getLiveBytes() == 0)
+        m_memory.release();
+      return bytes;
+    }
   }// namespace System
-}// namespace HummingBirdCore
\ No newline at end of file
+}// namespace HummingBirdCore
@@ -6,6 +6,13 @@
 
 #include <PCH/pch.h>
 #include "Utils/Plist/PlistUtil.h"
+#include "Memory/FrameArena.h"
+#include "Memory/MemoryPressureManager.h"
+#include "Memory/WindowMemoryResource.h"
+#include "Remote/AgentRegistry.h"
+#include "Threading/AsyncModel.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
 #include <HBUI/HBUI.h>
 #include <HBUI/UIWindow.h>
 
@@ -32,9 +39,14 @@ namespace HummingBirdCore {
         }
       }
 
+      LaunchDaemon(Utils::File file, std::shared_ptr<Utils::PlistUtil::Plist> plist, bool saved) : file(std::move(file)),
+                                                                                               plist(std::move(plist)),
+                                                                                               saved(saved) {
+      }
+
       bool init(){
         if (Utils::FileUtils::fileExists(file.getFullPath()) || file.getName().empty()) {
-          if(!plist->parsePlist(file.getFullPath()))
+          if(!plist->loadPlist(file.getFullPath()))
             return false;
 
         } else {
@@ -65,15 +77,23 @@ namespace HummingBirdCore {
         return plist.get();
       }
 
+      const Utils::PlistUtil::Plist *getPlist() const {
+        return plist.get();
+      }
+
       Utils::File &getFile() {
         return file;
       }
 
+      const Utils::File &getFile() const {
+        return file;
+      }
+
       const std::string getPath() const {
         return file.getPath();
       }
 
-      const std::string getFileName() const {
+      const std::string &getFileName() const {
         return file.getName();
       }
 
@@ -95,24 +115,47 @@ namespace HummingBirdCore {
       }
     };
 
-    class LaunchDaemonsManager : public UIWindow {
+    using LaunchDaemons = std::pmr::vector<LaunchDaemon>;
+
+    class LaunchDaemonsManager : public UIWindow, public Workspace::ISnapshotWindow, public Memory::IReclaimable {
   public:
-      explicit LaunchDaemonsManager(const std::string &name) : UIWindow(name, ImGuiWindowFlags_None), m_userAgent()
+      explicit LaunchDaemonsManager(const std::string &name) : UIWindow(name, ImGuiWindowFlags_None), m_memory(name, "launch_daemons")
       {
+        Memory::MemoryPressureManager::add(this);
         fetchAllDaemons();
       }
+      LaunchDaemonsManager(const std::string &name, Workspace::SnapshotReader &reader);
 
       ~LaunchDaemonsManager() {
+        Memory::MemoryPressureManager::remove(this);
       }
 
+      const char *getSnapshotType() const override { return "LaunchDaemons"; }
+      void writeSnapshot(Workspace::SnapshotWriter &writer) const override;
+
+      //the parsed list is dropped and read from disk again on focus, the selection is kept
+      size_t getReclaimableBytes() const override;
+      size_t reclaim() override;
+      const char *getReclaimName() const override { return "LaunchDaemons"; }
+
       void render() override;
       void renderDaemon(LaunchDaemon &daemon);
       void renderNode(Utils::PlistUtil::PlistNode &node, int index);
       void fetchAllDaemons();
-      bool selectDaemon(int idx,  std::vector<LaunchDaemon> &daemons);
-      bool renderTab(const std::string &name, std::vector<LaunchDaemon> &daemons);
+      bool selectDaemon(int idx,  LaunchDaemons &daemons);
+      bool renderTab(const std::string &name, LaunchDaemons &daemons);
 
   private:
+      /**
+       * @brief Lists the launch agents of an agent and copies them into a local folder, the plists are parsed from there.
+       */
+      void fetchRemoteDaemons();
+
+      /**
+       * @brief Moves a list read on a worker into the memory of this window.
+       */
+      LaunchDaemons adoptDaemons(LaunchDaemons &&daemons);
+
       int m_selectedIdx = 0;
 
       LaunchDaemon m_selectedDaemon = LaunchDaemon(Utils::File());
@@ -120,14 +163,25 @@ namespace HummingBirdCore {
 
       //TODO: Reenable
       std::string m_selectedTab = "";
-      std::vector<LaunchDaemon> m_userAgent = {};
+      //declared before the list that lives in it
+      Memory::WindowMemoryResource m_memory;
+      Threading::AsyncModel<LaunchDaemons> m_userAgent;
+      //the list was reclaimed, the selection is bound to the list again once it is reloaded
+      bool m_reclaimed = false;
+      UI::WindowVisibility m_visibility;
       const std::filesystem::path c_userAgentPath =    "~/Library/LaunchAgents";
+      //the agent the launch agents are read from, empty for this machine. Remote ones can not be saved, not part of the snapshot
+      std::string m_target;
+      static constexpr auto c_remoteTimeout = std::chrono::seconds(10);
+      static constexpr float c_targetWidth = 200.0f;
 
       //UI
       const ImGuiWindowFlags c_leftWindowFlags = ImGuiWindowFlags_NoScrollbar;
       const ImGuiChildFlags c_leftChildFlags = ImGuiChildFlags_Border | ImGuiChildFlags_ResizeX;
 
       bool m_wrapText = false;
+      //string values that are not set show their placeholder, the buffer keeps its capacity between frames
+      std::string m_placeholderBuffer;
     };
 
   }// namespace System
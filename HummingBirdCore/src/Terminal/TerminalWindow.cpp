@@ -5,12 +5,173 @@
 #include "TerminalWindow.h"
 
 namespace HummingBirdCore::Terminal {
+  namespace {
+    void writeLog(Workspace::SnapshotWriter &writer, const TerminalLog &log) {
+      writer.writeString(log.getTime());
+      writer.writeString(log.getLog());
+      writer.writeString(log.getCommand().getCommand());
+      writer.writeString(log.getCommand().getLocation());
+    }
+
+    size_t getLogSize(const TerminalLog &log) {
+      return sizeof(TerminalLog) + log.getTime().capacity() + log.getLog().capacity() +
+             log.getCommand().getCommand().capacity() + log.getCommand().getLocation().capacity();
+    }
+  }// namespace
+
   //TERMINAL
+  TerminalWindow::TerminalWindow(const std::string &name, Workspace::SnapshotReader &reader)
+      : UIWindow(name, ImGuiWindowFlags_None, false), m_memory(name, "terminal") {
+#ifdef __APPLE__
+    pws = getpwuid(geteuid());
+#endif
+    Memory::MemoryPressureManager::add(this);
+    std::filesystem::path path(reader.readString());
+    m_currentFolder = std::make_shared<Folder>(path, std::string(reader.readString()));
+
+    const uint32_t logCount = reader.readCount(4 * sizeof(uint32_t));
+    m_logs.reserve(logCount);
+    for (uint32_t i = 0; i < logCount; i++) {
+      pushLog(readLog(reader, &m_memory));
+    }
+  }
+
+  void TerminalWindow::writeSnapshot(Workspace::SnapshotWriter &writer) const {
+    writer.writeString(m_currentFolder->Path.native());
+    writer.writeString(m_currentFolder->Name);
+
+    //spilled lines go first, copied straight from the spill file
+    Utils::MappedFile spilled;
+    if (m_spill.isSpilled())
+      spilled = m_spill.map();
+    Workspace::SnapshotReader reader(spilled.data(), spilled.size());
+    const uint32_t spilledCount = spilled.isOpen() ? reader.readCount(4 * sizeof(uint32_t)) : 0;
+
+    writer.writeU32((uint32_t) (spilledCount + m_logs.size()));
+    for (uint32_t i = 0; i < spilledCount; i++) {
+      writeLog(writer, readLog(reader));
+    }
+    for (const auto &log: m_logs) {
+      writeLog(writer, log);
+    }
+  }
+
   TerminalWindow::~TerminalWindow() {
+    Memory::MemoryPressureManager::remove(this);
+    if (s_lastFocused == this)
+      s_lastFocused = nullptr;
+    //commands still reading output hold on to this window. Cancelling wakes their reads within a reactor tick and
+    //the process destructor kills a child that ignores SIGTERM, so this waits half a second at most
+    m_commands.cancel();
+    killCurrentCommand();
+    m_commands.wait();
+  }
+
+  size_t TerminalWindow::getReclaimableBytes() const {
+    if (m_logs.size() <= c_keptLogs)
+      return 0;
+    return m_logBytes / m_logs.size() * (m_logs.size() - c_keptLogs);
+  }
+
+  size_t TerminalWindow::reclaim() {
+    HB_PROFILE_SCOPE("TerminalWindow::reclaim");
+    if (m_logs.size() <= c_keptLogs)
+      return 0;
+    const size_t spillCount = m_logs.size() - c_keptLogs;
+
+    //a spill file can not be appended to while it is mapped, write the earlier spill and the new lines to a new one
+    Workspace::SnapshotWriter writer;
+    {
+      Utils::MappedFile spilled;
+      if (m_spill.isSpilled())
+        spilled = m_spill.map();
+      Workspace::SnapshotReader reader(spilled.data(), spilled.size());
+      const uint32_t spilledCount = spilled.isOpen() ? reader.readCount(4 * sizeof(uint32_t)) : 0;
+
+      writer.writeU32((uint32_t) (spilledCount + spillCount));
+      for (uint32_t i = 0; i < spilledCount; i++) {
+        writeLog(writer, readLog(reader));
+      }
+      for (size_t i = 0; i < spillCount; i++) {
+        writeLog(writer, m_logs[i]);
+      }
+    }
+    if (!m_spill.write(writer.getBuffer()))
+      return 0;
+
+    size_t freed = 0;
+    for (size_t i = 0; i < spillCount; i++) {
+      freed += getLogSize(m_logs[i]);
+    }
+    //the pool keeps freed blocks for the window, park the kept lines on the heap so every chunk can be handed back
+    //TerminalLog can not be assigned, so this also stands in for erasing the front
+    std::pmr::vector<TerminalLog> kept(std::make_move_iterator(m_logs.begin() + (ptrdiff_t) spillCount), std::make_move_iterator(m_logs.end()),
+                                       std::pmr::get_default_resource());
+    std::pmr::vector<TerminalLog>(&m_memory).swap(m_logs);
+    m_memory.release();
+    m_logs.reserve(kept.size());
+    std::move(kept.begin(), kept.end(), std::back_inserter(m_logs));
+    m_spilledCount += (uint32_t) spillCount;
+    m_logBytes -= std::min(m_logBytes, freed);
+    return freed;
+  }
+
+  void TerminalWindow::restoreLogs() {
+    HB_PROFILE_SCOPE("TerminalWindow::restoreLogs");
+    Utils::MappedFile spilled = m_spill.map();
+    Workspace::SnapshotReader reader(spilled.data(), spilled.size());
+    const uint32_t spilledCount = spilled.isOpen() ? reader.readCount(4 * sizeof(uint32_t)) : 0;
+
+    std::pmr::vector<TerminalLog> logs(&m_memory);
+    logs.reserve(spilledCount + m_logs.size());
+    for (uint32_t i = 0; i < spilledCount; i++) {
+      TerminalLog log = readLog(reader, &m_memory);
+      m_logBytes += getLogSize(log);
+      logs.push_back(std::move(log));
+    }
+    if (!reader.isValid())
+      CORE_ERROR("Unable to read back the spilled terminal output");
+    std::move(m_logs.begin(), m_logs.end(), std::back_inserter(logs));
+
+    //both live in the window memory, swapping hands over the buffer without assigning TerminalLog
+    m_logs.swap(logs);
+    m_spill.remove();
+    m_spilledCount = 0;
+  }
+
+  void TerminalWindow::pushLog(TerminalLog log) {
+    m_logBytes += getLogSize(log);
+    m_logs.push_back(std::move(log));
+  }
+
+  TerminalLog TerminalWindow::readLog(Workspace::SnapshotReader &reader, const TerminalLog::allocator_type &allocator) const {
+    std::string_view time = reader.readString();
+    std::string_view log = reader.readString();
+    std::string command(reader.readString());
+    std::string location(reader.readString());
+#ifdef __APPLE__
+    return TerminalLog(time, log, Command(command, location, pws), allocator);
+#else
+    return TerminalLog(time, log, Command(command, location), allocator);
+#endif
   }
 
   //PUBLIC
   void TerminalWindow::render() {
+    HB_PROFILE_SCOPE("TerminalWindow::render");
+    //output of a hidden terminal keeps arriving through the main thread queue, it is drawn once the tab is shown
+    if (!m_visibility.begin())
+      return;
+    if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows)) {
+      s_lastFocused = this;
+      Memory::MemoryPressureManager::touch(this);
+      if (m_spill.isSpilled())
+        restoreLogs();
+    }
+
+    ImGui::SetNextItemWidth(c_targetWidth);
+    Remote::AgentRegistry::renderTargetSelector("Target", m_target);
+
     // Set tm background color
     ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.12f, 0.12f, 0.12f, 1.00f));
 
@@ -19,28 +180,38 @@ namespace HummingBirdCore::Terminal {
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4, 1));
 
 
+    if (m_spill.isSpilled())
+      ImGui::TextDisabled("%u older lines unloaded to save memory, focus the window to load them again", m_spilledCount);
     //    ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Last login: %s", getTimestamp().c_str());
     for (int i = 0; i < m_logs.size(); i++) {
       ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", m_logs[i].getTime().c_str());
       ImGui::SameLine();
-      ImGui::TextWrapped("%s", std::string(m_logs[i].getCommand().getRanBy() + " " + m_logs[i].getLog()).c_str());
+      ImGui::TextWrapped("%s %s", m_logs[i].getCommand().getRanBy(), m_logs[i].getLog().c_str());
     }
     ImGui::PopStyleVar();
     ImGui::Separator();
 
+    if (!m_target.empty()) {
+      ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s %s", getTimestamp().c_str(), m_target.c_str());
+    } else {
 #ifdef __APPLE__
     // Command input
-    ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", std::string(getTimestamp() + " " + pws->pw_name).c_str());
+    ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s %s", getTimestamp().c_str(), pws->pw_name);
 #else
-    ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", std::string(getTimestamp() + " " + "Ran by not found").c_str());
+    ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s %s", getTimestamp().c_str(), "Ran by not found");
 #endif
+    }
 
     ImGui::SameLine();
     ImGui::TextWrapped("%s", m_input.c_str());
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 1));
-    if ((int) (ImGui::GetTime() / 0.4) % 2) {
-      ImGui::SameLine();
-      ImGui::Text("|");
+    //the caret only blinks while the input takes keys, an unfocused terminal does not keep idle rendering awake
+    if (ImGui::IsWindowFocused()) {
+      if ((int) (ImGui::GetTime() / c_caretBlinkInterval) % 2) {
+        ImGui::SameLine();
+        ImGui::Text("|");
+      }
+      Rendering::FramePacer::requestFrameIn(c_caretBlinkInterval - std::fmod(ImGui::GetTime(), c_caretBlinkInterval));
     }
     ImGui::PopStyleVar();
     ImGui::PopStyleColor();
@@ -64,13 +235,6 @@ namespace HummingBirdCore::Terminal {
     handleInput();
     ImGui::EndChild();
 
-    ImGui::End();
-
-//    if(Input::isLeftCtrlPressed() && Input::isKeyPressed(SDLK_c)){
-//      CORE_TRACE("Killing current command");
-//      killCurrentCommand();
-//    }
-
     //    for (int i = 0; i < m_logs.size(); i++) {
     //      ImGui::TextColored(ImVec4(0.5f, 1.0f, 0.5f, 1.0f), "%s", m_logs[i].time.c_str());
     //      ImGui::SameLine();
@@ -109,8 +273,29 @@ namespace HummingBirdCore::Terminal {
 
   //PRIVATE
   void TerminalWindow::executeCommand(const std::string &command) {
+    if (!command.empty()) {
+      //a repeated command moves to the end instead of showing up twice
+      std::erase(s_history, command);
+      s_history.push_back(command);
+      if (s_history.size() > c_maxHistory)
+        s_history.erase(s_history.begin());
+    }
     const std::vector<std::string> commandsToRun = splitCommand(command);
     for (const std::string &command: commandsToRun) {
+      if (!m_target.empty()) {
+        std::shared_ptr<Remote::AgentClient> agent = Remote::AgentRegistry::get(m_target);
+        if (agent == nullptr) {
+          errorLog("Agent " + m_target + " was removed");
+          return;
+        }
+        //runs in the working directory of the agent, this machine's folders mean nothing there
+        Command cmd(command, "");
+        addLog(command, cmd);
+        killCurrentCommand();
+        runRemoteCommand(agent, cmd);
+        continue;
+      }
+
       //create a command
 #ifdef __APPLE__
       const Command& cmd{command, m_currentFolder->Path, pws};
@@ -118,10 +303,7 @@ namespace HummingBirdCore::Terminal {
 
       killCurrentCommand();
 
-      //run the command threaded
-      commandThread = std::thread(&TerminalWindow::executeCommandThreaded, this, cmd);
-      commandThread.detach();
-      //wait till the command is done
+      m_commands.spawn(runCommand(cmd));
 #else
       errorLog("Command not supported on this platform");
 #endif
@@ -148,70 +330,50 @@ namespace HummingBirdCore::Terminal {
     return commands;
   }
 
-  void TerminalWindow::executeCommandThreaded(const Command& command) {
-    FILE *fp = popen(command.getCommand().c_str(), "r");
-    int pipeFd;
-
-    // Create a pipe and execute the command in a child process
-    if ((pipeFd = popenHumming(command.getCommand().c_str(), &fp)) == -1) {
-        addLog("Failed to run command: " + command.getCommand(), command);
-      return;
+  Async::Task<void> TerminalWindow::runCommand(Command command) {
+    Async::Process process;
+    if (!process.start(command.getCommand(), command.getLocation())) {
+      addLog("Failed to run command: " + command.getCommand(), command);
+      co_return;
     }
 
-    // Store the PID of the process
-    m_currentPid = pipeFd;
-
-    char buffer[128];
-    while (fgets(buffer, sizeof(buffer), fp) != nullptr) {
-      // Remove newline character if present
-      size_t len = strlen(buffer);
-      if (len > 0 && buffer[len - 1] == '\n') buffer[len - 1] = '\0';
-        addLog(buffer, command);
+    //killCurrentCommand() ends the output, the loop stops at the next read
+    const pid_t pid = process.getPid();
+    m_currentPid = pid;
+    while (std::optional<std::string> line = co_await process.readLine()) {
+      m_bytesRead.add((int64_t) line->size() + 1);
+      addLog(std::move(*line), command);
     }
 
-    // Reset the PID to -1 after the command has finished
-    m_currentPid = -1;
-    pclose(fp);
+    //a newer command might have replaced the pid already
+    pid_t expected = pid;
+    m_currentPid.compare_exchange_strong(expected, -1);
   }
 
-  int TerminalWindow::popenHumming(const char *command, FILE **fp){
-#ifdef __APPLE__
-    int pipeFd[2];
-    pid_t pid;
-
-    if (pipe(pipeFd) == -1) {
-      return -1;
-    }
-
-    if ((pid = fork()) == -1) {
-      close(pipeFd[0]);
-      close(pipeFd[1]);
-      return -1;
-    }
-
-    if (pid == 0) {// child process
-      close(pipeFd[0]);
-      if (pipeFd[1] != STDOUT_FILENO) {
-        dup2(pipeFd[1], STDOUT_FILENO);
-        close(pipeFd[1]);
-      }
-      if (pipeFd[1] != STDERR_FILENO) {
-        dup2(pipeFd[1], STDERR_FILENO);
-        close(pipeFd[1]);
+  void TerminalWindow::runRemoteCommand(const std::shared_ptr<Remote::AgentClient> &agent, Command command) {
+    Workspace::SnapshotWriter writer;
+    writer.writeString(command.getCommand());
+    writer.writeString(command.getLocation());
+    //runs on the agent thread and can outlive the window, the window is only touched from the main thread
+    auto onFrame = [this, lifetime = std::weak_ptr<bool>(m_lifetime), &bytesRead = m_bytesRead, command](const Remote::Frame &frame) {
+      Workspace::SnapshotReader reader = frame.getReader();
+      std::string log;
+      if (frame.type == Remote::MessageOutput) {
+        log = reader.readString();
+        bytesRead.add((int64_t) log.size() + 1);
+      } else if (frame.type == Remote::MessageError) {
+        log = reader.readString();
+      } else if (const int32_t exitCode = reader.readI32(); exitCode != 0) {
+        log = fmt::format("Exited with {0}", exitCode);
+      } else {
+        return;
       }
-      execl("/bin/sh", "sh", "-c", command, nullptr);
-      _exit(127);
-    }
-
-    *fp = fdopen(pipeFd[0], "r");
-    if (*fp == nullptr) {
-      close(pipeFd[0]);
-      return -1;
-    }
-
-    return pid;
-#endif
-    return -1;
+      Threading::MainThreadQueue::post(lifetime, [this, log = std::move(log), command] {
+        pushLog(TerminalLog(getTimestamp(), log, command, &m_memory));
+      });
+    };
+    m_remoteRequestId = agent->stream(Remote::MessageRunCommand, writer.getBuffer(), std::move(onFrame));
+    m_remoteAgent = agent;
   }
 
 }// namespace HummingBirdCore::Terminal
@@ -6,7 +6,18 @@
 
 #include <HBUI/UIWindow.h>
 
+#include "../Async/Process.h"
 #include "../Folder.h"
+#include "../Memory/MemoryPressureManager.h"
+#include "../Memory/WindowMemoryResource.h"
+#include "../Metrics/StatsRegistry.h"
+#include "../Rendering/FramePacer.h"
+#include "../Remote/AgentRegistry.h"
+#include "../Threading/MainThreadQueue.h"
+#include "../Threading/ThreadPool.h"
+#include "../UIWindows/WindowVisibility.h"
+#include "../Utils/Input.h"
+#include "../Workspace/Snapshot.h"
 
 #include <csignal>
 #include <mutex>
@@ -31,10 +42,10 @@ public:
     ~Command() {
     }
 
-    std::string getCommand() const { return command; }
-    std::string getLocation() const { return location; }
+    const std::string &getCommand() const { return command; }
+    const std::string &getLocation() const { return location; }
 
-    std::string getRanBy() const {
+    const char *getRanBy() const {
 #ifdef __APPLE__
       if (pws != nullptr) {
         return pws->pw_name;
@@ -54,61 +65,112 @@ private:
 
   struct TerminalLog {
 public:
-    TerminalLog(std::string time, std::string log, Command command) : time(std::move(time)), log(std::move(log)), command(std::move(command)) {
+    //the output lives in the memory of the terminal window that holds the log
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    TerminalLog(std::string_view time, std::string_view log, Command command, const allocator_type &allocator = {})
+        : time(time, allocator), log(log, allocator), command(std::move(command)) {
+    }
+    TerminalLog(const TerminalLog &other, const allocator_type &allocator = {})
+        : time(other.time, allocator), log(other.log, allocator), command(other.command) {
     }
+    TerminalLog(TerminalLog &&other, const allocator_type &allocator)
+        : time(std::move(other.time), allocator), log(std::move(other.log), allocator), command(std::move(other.command)) {
+    }
+    TerminalLog(TerminalLog &&other) = default;
     ~TerminalLog() = default;
 
-    std::string getTime() const { return time; }
-    std::string getLog() const { return log; }
-    Command getCommand() const { return command; }
+    const std::pmr::string &getTime() const { return time; }
+    const std::pmr::string &getLog() const { return log; }
+    const Command &getCommand() const { return command; }
 
 private:
-    std::string time;
-    std::string log;
+    std::pmr::string time;
+    std::pmr::string log;
     Command command;
   };
 
-  class TerminalWindow : public UIWindow {
+  class TerminalWindow : public UIWindow, public Workspace::ISnapshotWindow, public Memory::IReclaimable {
 public:
     TerminalWindow(const std::string& name) : TerminalWindow(ImGuiWindowFlags_None, name) {}
-    TerminalWindow(ImGuiWindowFlags flags, const std::string& name) : UIWindow(name, ImGuiWindowFlags_None, false) {
-      m_currentFolder->setChildDirectories();
+    TerminalWindow(ImGuiWindowFlags flags, const std::string& name) : UIWindow(name, ImGuiWindowFlags_None, false), m_memory(name, "terminal") {
+      //the working directory is only used as a path, its children are never listed so do not scan them here
 #ifdef __APPLE__
       pws = getpwuid(geteuid());
 #endif
+      Memory::MemoryPressureManager::add(this);
     }
 
+    TerminalWindow(const std::string &name, Workspace::SnapshotReader &reader);
+
     ~TerminalWindow();
 
     void render() override;
 
+    const char *getSnapshotType() const override { return "Terminal"; }
+    void writeSnapshot(Workspace::SnapshotWriter &writer) const override;
+
+    //everything but the last c_keptLogs lines is spilled to disk and read back on focus
+    size_t getReclaimableBytes() const override;
+    size_t reclaim() override;
+    const char *getReclaimName() const override { return "Terminal"; }
+
+    void setInput(std::string input) { m_input = std::move(input); }
+
+    /**
+     * @brief Commands run in any terminal this session, oldest first.
+     */
+    static const std::vector<std::string> &getHistory() { return s_history; }
+
+    /**
+     * @return The terminal that had focus last, nullptr once it is closed
+     */
+    static TerminalWindow *getLastFocused() { return s_lastFocused; }
+
+    /**
+     * @brief Splits a command line on &&, every part runs as its own command.
+     */
+    static std::vector<std::string> splitCommand(const std::string &command);
+
 private:
-    std::vector<std::string> splitCommand(const std::string &command);
 
     void executeCommand(const std::string &command);
-    void executeCommandThreaded(const Command& cmd);
 
     /**
-     * @brief Custom popen function to execute commands
-     * @param command The command to execute
-     * @param fp The file pointer to write the output to
-     * @return The exit code of the command
+     * @brief Streams the output of the command into the log until it exits or gets killed.
+     * Never awaits the main thread, the destructor waits for it.
+     */
+    Async::Task<void> runCommand(Command command);
+
+    /**
+     * @brief Runs the command on the agent, its output arrives on the agent thread and is posted to the log.
      */
-    int popenHumming(const char *command, FILE **fp);
+    void runRemoteCommand(const std::shared_ptr<Remote::AgentClient> &agent, Command command);
+
+    void pushLog(TerminalLog log);
+    TerminalLog readLog(Workspace::SnapshotReader &reader, const TerminalLog::allocator_type &allocator = {}) const;
+    void restoreLogs();
 
 private:
+    //called from the command workers, m_logs is only touched on the main thread
     void addLog(std::string log, const Command &command) {
-      std::lock_guard<std::mutex> lock(m_logMutex);
-      m_logs.emplace_back(TerminalLog(getTimestamp(), log, command));
+      Threading::MainThreadQueue::post(std::weak_ptr<bool>(m_lifetime), [this, time = getTimestamp(), log = std::move(log), command] {
+        pushLog(TerminalLog(time, log, command, &m_memory));
+      });
     }
 
     void errorLog(std::string log) {
-      std::lock_guard<std::mutex> lock(m_logMutex);
-      m_logs.emplace_back(TerminalLog(getTimestamp(), log, Command("", "")));
       CORE_ERROR(log);
+      Threading::MainThreadQueue::post(std::weak_ptr<bool>(m_lifetime), [this, time = getTimestamp(), log = std::move(log)] {
+        pushLog(TerminalLog(time, log, Command("", ""), &m_memory));
+      });
     }
 
     void killCurrentCommand(){
+      if (std::shared_ptr<Remote::AgentClient> agent = m_remoteAgent.lock())
+        agent->cancel(m_remoteRequestId);
+      m_remoteAgent.reset();
+
       pid_t pid = m_currentPid.load();
       if (pid != -1) {
 #ifdef __APPLE__
@@ -118,32 +180,36 @@ private:
       }
     }
 
-    //TODO: USE INPUT CLASS
     void handleInput() {
       if (ImGui::IsItemFocused() || ImGui::IsWindowFocused()) {
-        //record kb input and add to input string
-        bool inputChange = ImGui::GetIO().InputQueueCharacters.size();
-        if (inputChange) {
-          scrollToBottom();
-          int inputChar = ImGui::GetIO().InputQueueCharacters.front();
-          if (inputChar != 0) {
-            m_input += (char) inputChar;
+        //every event of this frame in the order it was typed, "ls<Enter>" in one frame still runs "ls"
+        for (const Input::Event &event: Input::getEvents()) {
+          if (event.type == Input::EventCharacter) {
+            scrollToBottom();
+            if (event.character != 0)
+              Input::appendUtf8(m_input, event.character);
+            continue;
           }
-        }
+          if (event.type != Input::EventKey || !event.down)
+            continue;
 
-        if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Backspace))) {
-          scrollToBottom();
-          if (m_input.size() > 0) {
-            m_input.pop_back();
+          if (event.key == ImGuiKey_Backspace) {
+            scrollToBottom();
+            //drop the whole character, not just its last UTF-8 byte
+            while (!m_input.empty() && (m_input.back() & 0xC0) == 0x80)
+              m_input.pop_back();
+            if (!m_input.empty())
+              m_input.pop_back();
+          } else if (event.key == ImGuiKey_Enter || event.key == ImGuiKey_KeypadEnter) {
+            scrollToBottom();
+            executeCommand(m_input);
+            m_input = "";
+          } else if (event.key == ImGuiKey_C && event.mods == ImGuiMod_Ctrl) {
+            CORE_TRACE("Killing current command");
+            killCurrentCommand();
           }
         }
 
-        if (ImGui::IsKeyPressed(ImGui::GetKeyIndex(ImGuiKey_Enter))) {
-          scrollToBottom();
-          executeCommand(m_input);
-          m_input = "";
-        }
-
         //todo: implement up for history etc.
       }
     }
@@ -153,9 +219,11 @@ private:
     }
     std::string getTimestamp() {
       std::time_t now = std::time(nullptr);
-      std::tm *ltm = std::localtime(&now);
+      //also called from the command workers
+      std::tm ltm = {};
+      localtime_r(&now, &ltm);
       char timestamp[10];
-      std::strftime(timestamp, sizeof(timestamp), "%H:%M:%S", ltm);
+      std::strftime(timestamp, sizeof(timestamp), "%H:%M:%S", &ltm);
       return std::string(timestamp);
     }
 
@@ -163,11 +231,32 @@ private:
     //Terminal
     std::shared_ptr<Folder> m_currentFolder = std::make_shared<Folder>("/Users/k.debruin/", "k.debruin");
     std::vector<std::string> m_commandQueue;
-    std::mutex m_logMutex;
-    std::vector<TerminalLog> m_logs;
+    //declared before everything that allocates from it
+    Memory::WindowMemoryResource m_memory;
+    std::pmr::vector<TerminalLog> m_logs{&m_memory};
+    size_t m_logBytes = 0;
+    //the oldest lines, in front of m_logs
+    Memory::SpillFile m_spill;
+    uint32_t m_spilledCount = 0;
+    //queued log lines are dropped once this is gone
+    std::shared_ptr<bool> m_lifetime = std::make_shared<bool>(true);
     std::string m_input;
     std::atomic<pid_t> m_currentPid = -1;// using atomic for thread-safety
-    std::thread commandThread;
+    Async::TaskScope m_commands;
+    UI::WindowVisibility m_visibility;
+    //the agent commands run on, empty for this machine. Not part of the snapshot, the agent might not be there next time
+    std::string m_target;
+    std::weak_ptr<Remote::AgentClient> m_remoteAgent;
+    uint32_t m_remoteRequestId = 0;
+    //command output, counted on the workers that read it
+    Metrics::Counter &m_bytesRead = Metrics::StatsRegistry::counter("terminal.bytes");
+    static constexpr double c_caretBlinkInterval = 0.4;
+    static constexpr float c_targetWidth = 200.0f;
+    static constexpr size_t c_keptLogs = 200;
+    static constexpr size_t c_maxHistory = 1000;
+
+    inline static std::vector<std::string> s_history = {};
+    inline static TerminalWindow *s_lastFocused = nullptr;
 
     //User data
     //get the user name
@@ -0,0 +1,167 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Rendering/FramePacer.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <optional>
+
+namespace HummingBirdCore::Threading {
+  /**
+   * @brief Handed to a model loader so it can report how far along it is and notice it is no longer needed.
+   */
+  class AsyncProgress {
+public:
+    explicit AsyncProgress(CancellationToken token) : m_token(std::move(token)) {}
+
+    /**
+     * @brief Safe to call from the loader thread, wakes the frame loop so the placeholder redraws.
+     * @param fraction 0 to 1
+     */
+    void set(float fraction) {
+      m_fraction.store(std::clamp(fraction, 0.0f, 1.0f), std::memory_order_relaxed);
+      Rendering::FramePacer::requestFrame();
+    }
+
+    float get() const { return m_fraction.load(std::memory_order_relaxed); }
+    bool isCancelled() const { return m_token.isCancelled(); }
+
+private:
+    CancellationToken m_token;
+    //negative until the loader reports something, the placeholder shows a spinner
+    std::atomic<float> m_fraction = -1.0f;
+  };
+
+  /**
+   * @brief Model of a window that is built on the thread pool instead of in the window constructor.
+   *
+   * The window constructor only calls load(), render() calls poll() and draws renderPlaceholder() until the model
+   * is there. The loader runs on a worker and must not capture the window, it gets everything it needs by value,
+   * so a window that closes while loading just drops the result. Loading again cancels the previous load.
+   */
+  template<typename T>
+  class AsyncModel {
+public:
+    AsyncModel() = default;
+    ~AsyncModel() { cancel(); }
+
+    AsyncModel(const AsyncModel &) = delete;
+    AsyncModel &operator=(const AsyncModel &) = delete;
+
+    /**
+     * @brief Starts building the model on the pool, the current model stays available until the new one is swapped in.
+     * @param loader Called as loader(AsyncProgress &) on a worker thread, returns the new model
+     * @param adopt Called by poll() on the main thread with the loaded model, returns the model to keep. For moving
+     * the model into memory of the window, which the worker can not allocate from
+     */
+    template<typename F>
+    void load(F &&loader, std::function<T(T &&)> adopt = nullptr) {
+      cancel();
+      m_adopt = std::move(adopt);
+      m_token = CancellationToken();
+      m_error.clear();
+      m_progress = std::make_shared<AsyncProgress>(m_token);
+      m_startNs = Profiling::Profiler::nowNs();
+      auto task = [loader = std::forward<F>(loader), progress = m_progress]() mutable {
+        T model = loader(*progress);
+        //idle rendering might be asleep, the swap happens on the next frame
+        Rendering::FramePacer::requestFrame();
+        return model;
+      };
+      m_task = ThreadPool::get().submit(std::move(task), m_token);
+    }
+
+    /**
+     * @brief Replaces the model right away, for models that are already known like a restored workspace.
+     */
+    void set(T value) {
+      cancel();
+      m_task = TaskHandle<T>();
+      m_value.emplace(std::move(value));
+    }
+
+    /**
+     * @brief Swaps in a finished load. Main thread only, call once per frame before using the model.
+     * @return true when there is a model to render
+     */
+    bool poll() {
+      if (m_task.isValid() && m_task.isReady()) {
+        if (!m_task.isCancelled()) {
+          try {
+            //emplaced, assigning a model with another allocator would copy it into the old model's memory
+            m_value.emplace(m_adopt != nullptr ? m_adopt(m_task.take()) : m_task.take());
+            CORE_TRACE("Model loaded in {0:.2f} ms", (double) (Profiling::Profiler::nowNs() - m_startNs) / 1e6);
+          } catch (const std::exception &e) {
+            m_error = e.what();
+            CORE_ERROR("Loading model failed: {0}", e.what());
+          } catch (...) {
+            m_error = "unknown error";
+            CORE_ERROR("Loading model failed");
+          }
+        }
+        m_task = TaskHandle<T>();
+        m_progress.reset();
+      }
+      return m_value.has_value();
+    }
+
+    void cancel() {
+      m_token.cancel();
+    }
+
+    /**
+     * @brief Drops the model and any running load, isReady() is false until the next load() or set().
+     */
+    void reset() {
+      cancel();
+      m_task = TaskHandle<T>();
+      m_progress.reset();
+      m_value.reset();
+      m_error.clear();
+    }
+
+    bool isLoading() const { return m_task.isValid(); }
+    //why the last load failed, empty when it did not
+    const std::string &getError() const { return m_error; }
+    bool isReady() const { return m_value.has_value(); }
+
+    T &get() { return *m_value; }
+    const T &get() const { return *m_value; }
+
+    /**
+     * @brief Draws what the window shows while the model is not there yet.
+     */
+    void renderPlaceholder(const char *label) const {
+      if (!m_error.empty()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s failed: %s", label, m_error.c_str());
+        return;
+      }
+
+      const float fraction = m_progress != nullptr ? m_progress->get() : -1.0f;
+      if (fraction >= 0.0f) {
+        ImGui::TextUnformatted(label);
+        ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f));
+      } else {
+        //the loader does not report progress, spin until it is done
+        ImGui::Text("%s %c", label, "|/-\\"[(int) (ImGui::GetTime() / c_spinnerInterval) & 3]);
+        Rendering::FramePacer::requestFrameIn(c_spinnerInterval);
+      }
+    }
+
+private:
+    static constexpr double c_spinnerInterval = 0.1;
+
+    std::optional<T> m_value = std::nullopt;
+    TaskHandle<T> m_task;
+    std::function<T(T &&)> m_adopt = nullptr;
+    CancellationToken m_token;
+    std::shared_ptr<AsyncProgress> m_progress = nullptr;
+    std::string m_error;
+    int64_t m_startNs = 0;
+  };
+}// namespace HummingBirdCore::Threading
@@ -0,0 +1,114 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "FrameScheduler.h"
+
+#include <Metrics/StatsRegistry.h>
+#include <Rendering/FramePacer.h>
+
+namespace HummingBirdCore::Threading {
+  void FrameScheduler::post(std::string name, Step step, const CancellationToken &token) {
+    Job job;
+    job.info.name = std::move(name);
+    job.step = std::move(step);
+    job.token = token;
+    job.posted = Clock::now();
+    s_jobs.push_back(std::move(job));
+
+    static Metrics::Gauge &depth = Metrics::StatsRegistry::gauge("frame_jobs.queue_depth");
+    depth.set((double) s_jobs.size());
+    Rendering::FramePacer::requestFrame();
+  }
+
+  void FrameScheduler::beginFrame() {
+    s_frameStart = Clock::now();
+    s_frame++;
+  }
+
+  void FrameScheduler::run() {
+    static Metrics::Gauge &depth = Metrics::StatsRegistry::gauge("frame_jobs.queue_depth");
+    static Metrics::Gauge &budgetMs = Metrics::StatsRegistry::gauge("frame_jobs.budget_ms");
+    static Metrics::Histogram &slice = Metrics::StatsRegistry::histogram("frame_jobs.slice");
+    static Metrics::Counter &cancelled = Metrics::StatsRegistry::counter("frame_jobs.cancelled");
+
+    if (s_jobs.empty()) {
+      s_lastSliceMs = 0.0;
+      depth.set(0.0);
+      return;
+    }
+    HB_PROFILE_SCOPE("FrameScheduler::run");
+
+    const Clock::time_point start = Clock::now();
+    //whatever the frame has left, rendering the windows already took its part
+    const double budget = std::max(c_minSliceMs, s_targetFrameMs - toMs(start - s_frameStart) - c_submitReserveMs);
+    const auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budget));
+    s_lastBudgetMs = budget;
+    budgetMs.set(budget);
+
+    //round robin, one step per job per pass so a long job does not starve the ones behind it
+    Clock::time_point now = start;
+    while (!s_jobs.empty() && now < deadline) {
+      const size_t count = s_jobs.size();
+      for (size_t i = 0; i < count && now < deadline; i++) {
+        Job job = std::move(s_jobs.front());
+        s_jobs.pop_front();
+        if (job.token.isCancelled()) {
+          cancelled.add(1);
+          continue;
+        }
+
+        bool done = true;
+        try {
+          done = job.step();
+        } catch (const std::exception &e) {
+          CORE_ERROR("Frame job {0} failed: {1}", job.info.name, e.what());
+        } catch (...) {
+          CORE_ERROR("Frame job {0} failed", job.info.name);
+        }
+        const Clock::time_point end = Clock::now();
+        job.info.ranMs += toMs(end - now);
+        job.info.steps++;
+        if (job.lastFrame != s_frame) {
+          job.lastFrame = s_frame;
+          job.info.frames++;
+        }
+        now = end;
+
+        if (done)
+          finish(job, now);
+        else
+          s_jobs.push_back(std::move(job));
+      }
+    }
+
+    s_lastSliceMs = toMs(now - start);
+    slice.record((uint64_t) (s_lastSliceMs * 1000.0));
+    depth.set((double) s_jobs.size());
+    //out of budget, continue next frame
+    if (!s_jobs.empty())
+      Rendering::FramePacer::requestFrame();
+  }
+
+  void FrameScheduler::forEachJob(const std::function<void(const JobInfo &)> &fn) {
+    const Clock::time_point now = Clock::now();
+    for (const Job &job: s_jobs) {
+      JobInfo info = job.info;
+      info.waitedMs = toMs(now - job.posted) - info.ranMs;
+      fn(info);
+    }
+  }
+
+  void FrameScheduler::finish(Job &job, Clock::time_point now) {
+    static Metrics::Histogram &wait = Metrics::StatsRegistry::histogram("frame_jobs.wait");
+    static Metrics::Histogram &duration = Metrics::StatsRegistry::histogram("frame_jobs.duration");
+    static Metrics::Counter &completed = Metrics::StatsRegistry::counter("frame_jobs.completed");
+
+    const double totalMs = toMs(now - job.posted);
+    wait.record((uint64_t) (std::max(0.0, totalMs - job.info.ranMs) * 1000.0));
+    duration.record((uint64_t) (totalMs * 1000.0));
+    completed.add(1);
+    CORE_TRACE("Frame job {0} done: {1} steps over {2} frames, {3:.2f} ms running, {4:.2f} ms waiting", job.info.name, job.info.steps,
+               job.info.frames, job.info.ranMs, totalMs - job.info.ranMs);
+  }
+}// namespace HummingBirdCore::Threading
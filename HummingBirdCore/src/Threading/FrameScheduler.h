@@ -0,0 +1,95 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "ThreadPool.h"
+
+namespace HummingBirdCore::Threading {
+  /**
+   * @brief Resumable jobs on the main thread that get what is left of the frame budget.
+   *
+   * For work that has to touch ImGui or window state and can not move to a worker: rebuilding a large tree,
+   * reapplying a theme, reading a big table back into window memory. A job is a step function that does a small
+   * piece of the work and returns true once it is done. After the windows rendered, the steps of all queued jobs run
+   * round robin until the frame reaches the target frame time minus a reserve for submitting it, so a long job is
+   * spread over a couple of frames instead of causing one long hitch. Every frame gets at least c_minSliceMs so jobs
+   * keep moving when rendering alone is over the target.
+   *
+   * The queue depth and budget are in the frame_jobs.* stats, every finished job records how long it waited for a
+   * slice in frame_jobs.wait. Main thread only.
+   */
+  //Class is fully static
+  class FrameScheduler {
+public:
+    /**
+     * @brief One piece of a job, called again until it returns true. Keep a step well under a millisecond.
+     */
+    using Step = std::function<bool()>;
+
+    struct JobInfo {
+      std::string name;
+      //queued without running, since it was posted
+      double waitedMs = 0.0;
+      double ranMs = 0.0;
+      uint32_t steps = 0;
+      uint32_t frames = 0;
+    };
+
+    /**
+     * @brief Queues a job, its first step runs in the next slice.
+     * The job is dropped once token is cancelled, windows cancel theirs when they close.
+     */
+    static void post(std::string name, Step step, const CancellationToken &token = CancellationToken());
+
+    /**
+     * @brief Called by the application once the frame starts, the budget is measured from here.
+     */
+    static void beginFrame();
+
+    /**
+     * @brief Runs steps until the frame budget is used up. Called by the application after the windows rendered.
+     */
+    static void run();
+
+    static void setTargetFrameMs(double ms) { s_targetFrameMs = ms; }
+    static double getTargetFrameMs() { return s_targetFrameMs; }
+    static double getLastBudgetMs() { return s_lastBudgetMs; }
+    static double getLastSliceMs() { return s_lastSliceMs; }
+    static size_t getQueueDepth() { return s_jobs.size(); }
+
+    /**
+     * @brief Calls fn for every queued job in the order they run, for the metrics window.
+     */
+    static void forEachJob(const std::function<void(const JobInfo &)> &fn);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+      JobInfo info;
+      Step step;
+      CancellationToken token;
+      Clock::time_point posted;
+      //frame the job last ran in, a job is only counted once per frame
+      uint64_t lastFrame = 0;
+    };
+
+    static double toMs(Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); }
+    static void finish(Job &job, Clock::time_point now);
+
+private:
+    static constexpr double c_minSliceMs = 1.0;
+    //ImGui::Render() and handing the frame to the backend, after the jobs
+    static constexpr double c_submitReserveMs = 2.0;
+
+    inline static std::deque<Job> s_jobs = {};
+    inline static Clock::time_point s_frameStart = {};
+    inline static uint64_t s_frame = 0;
+    inline static double s_targetFrameMs = 16.6;
+    inline static double s_lastBudgetMs = 0.0;
+    inline static double s_lastSliceMs = 0.0;
+  };
+}// namespace HummingBirdCore::Threading
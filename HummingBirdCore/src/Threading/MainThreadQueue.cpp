@@ -0,0 +1,91 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "MainThreadQueue.h"
+
+#include <Metrics/StatsRegistry.h>
+#include <Rendering/FramePacer.h>
+
+namespace HummingBirdCore::Threading {
+  void MainThreadQueue::post(std::function<void()> task) {
+    Node *node = new Node();
+    node->task = std::move(task);
+
+    s_pending.fetch_add(1, std::memory_order_relaxed);
+    Node *previous = s_head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+
+    Rendering::FramePacer::requestFrame();
+  }
+
+  MainThreadQueue::Node *MainThreadQueue::pop() {
+    Node *tail = s_tail;
+    Node *next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &s_stub) {
+      if (next == nullptr)
+        return nullptr;
+      s_tail = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+      s_tail = next;
+      return tail;
+    }
+
+    //a producer swapped the head but did not link its node yet, pick it up next frame
+    if (tail != s_head.load(std::memory_order_acquire))
+      return nullptr;
+
+    //tail is the last node, put the stub behind it so it can be handed out
+    s_stub.next.store(nullptr, std::memory_order_relaxed);
+    Node *previous = s_head.exchange(&s_stub, std::memory_order_acq_rel);
+    previous->next.store(&s_stub, std::memory_order_release);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      s_tail = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  size_t MainThreadQueue::drain(size_t maxTasks, double maxMs) {
+    HB_PROFILE_SCOPE("MainThreadQueue::drain");
+    const auto start = std::chrono::steady_clock::now();
+    const auto budget = std::chrono::duration<double, std::milli>(maxMs);
+
+    //tasks posted by the tasks of this drain wait for the next one, a task that posts itself can not hold up the frame
+    const size_t queued = std::min(maxTasks, s_pending.load(std::memory_order_relaxed));
+    size_t count = 0;
+    while (count < queued) {
+      std::unique_ptr<Node> node(pop());
+      if (node == nullptr)
+        break;
+
+      s_pending.fetch_sub(1, std::memory_order_relaxed);
+      count++;
+      try {
+        node->task();
+      } catch (const std::exception &e) {
+        CORE_ERROR("Main thread task failed: {0}", e.what());
+      } catch (...) {
+        CORE_ERROR("Main thread task failed");
+      }
+
+      if (std::chrono::steady_clock::now() - start > budget)
+        break;
+    }
+
+    s_lastDrainCount = count;
+    static Metrics::Counter &tasks = Metrics::StatsRegistry::counter("mainthread.tasks");
+    tasks.add((int64_t) count);
+    //out of budget, continue next frame
+    if (s_pending.load(std::memory_order_relaxed) > 0)
+      Rendering::FramePacer::requestFrame();
+    return count;
+  }
+}// namespace HummingBirdCore::Threading
@@ -0,0 +1,69 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <atomic>
+
+namespace HummingBirdCore::Threading {
+  /**
+   * @brief Lock-free multi producer, single consumer queue of closures that run on the main thread.
+   *
+   * Any thread can post, the frame loop drains the queue once per frame before the windows render. Workers never
+   * touch UI owned state directly, they post the change here. The drain has a budget so a burst of posts is spread
+   * over a couple of frames instead of stalling one.
+   */
+  class MainThreadQueue {
+public:
+    /**
+     * @brief Queues task for the next frame and wakes the frame loop. Safe to call from any thread.
+     */
+    static void post(std::function<void()> task);
+
+    /**
+     * @brief Queues task, it is dropped when owner is gone by the time the main thread gets to it.
+     * Windows pass a lifetime token they reset on destruction, so queued work never touches a deleted window.
+     */
+    template<typename T>
+    static void post(const std::weak_ptr<T> &owner, std::function<void()> task) {
+      post([owner, task = std::move(task)] {
+        if (owner.lock())
+          task();
+      });
+    }
+
+    /**
+     * @brief Runs the tasks that were queued when it was called until they are done or the budget is used up, tasks
+     * posted meanwhile run in the next drain. A task that throws is logged and skipped. Main thread only.
+     * @return The number of tasks that ran
+     */
+    static size_t drain(size_t maxTasks = c_maxTasksPerFrame, double maxMs = c_maxDrainMs);
+
+    static size_t getPendingCount() { return s_pending.load(std::memory_order_relaxed); }
+    static size_t getLastDrainCount() { return s_lastDrainCount; }
+
+private:
+    struct Node {
+      Node() : next(nullptr) {}
+
+      std::atomic<Node *> next;
+      std::function<void()> task;
+    };
+
+    static Node *pop();
+
+private:
+    static constexpr size_t c_maxTasksPerFrame = 512;
+    static constexpr double c_maxDrainMs = 2.0;
+
+    //Vyukov queue, producers swap the head, the consumer follows next pointers from the tail
+    inline static Node s_stub;
+    inline static std::atomic<Node *> s_head = &s_stub;
+    inline static Node *s_tail = &s_stub;
+
+    inline static std::atomic<size_t> s_pending = 0;
+    inline static size_t s_lastDrainCount = 0;
+  };
+}// namespace HummingBirdCore::Threading
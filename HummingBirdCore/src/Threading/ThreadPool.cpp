@@ -0,0 +1,163 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "ThreadPool.h"
+
+#include "Metrics/StatsRegistry.h"
+
+namespace HummingBirdCore::Threading {
+  ThreadPool::ThreadPool(size_t workerCount) {
+    workerCount = std::max<size_t>(1, workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+      m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < workerCount; i++) {
+      m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+    m_workerCount = workerCount;
+    CORE_INFO("Thread pool started with {0} workers", workerCount);
+  }
+
+  ThreadPool::~ThreadPool() {
+    shutdown();
+  }
+
+  void ThreadPool::shutdown() {
+    if (isWorkerThread()) {
+      CORE_ERROR("A worker can not shut its own pool down");
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      if (m_stopping)
+        return;
+      m_stopping = true;
+    }
+    m_sleepCondition.notify_all();
+    for (auto &worker: m_workers) {
+      worker.join();
+    }
+    m_workers.clear();
+    m_joined = true;
+    //posted by the last tasks after their worker had already left
+    while (runPendingTask()) {
+    }
+  }
+
+  ThreadPool &ThreadPool::get() {
+    //one thread is left for the main thread
+    static ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+  }
+
+  bool ThreadPool::isWorkerThread() const {
+    return s_currentPool == this;
+  }
+
+  void ThreadPool::post(std::function<void()> task) {
+    if (m_joined.load(std::memory_order_acquire)) {
+      //nobody is left to run it, a TaskHandle waiting on it would never return
+      task();
+      return;
+    }
+    const size_t index = isWorkerThread() ? s_workerIndex : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+      std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+      m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    //the lock makes sure a worker that is about to sleep sees the new task
+    {
+      std::lock_guard<std::mutex> lock(m_sleepMutex);
+      m_pendingTasks.fetch_add(1, std::memory_order_release);
+    }
+    m_sleepCondition.notify_one();
+  }
+
+  void ThreadPool::postThen(std::function<void()> task, std::function<void(bool succeeded)> continuation) {
+    post([this, task = std::move(task), continuation = std::move(continuation)]() mutable {
+      bool succeeded = true;
+      try {
+        task();
+      } catch (const std::exception &e) {
+        CORE_ERROR("Task threw: {0}", e.what());
+        succeeded = false;
+      } catch (...) {
+        CORE_ERROR("Task threw an unknown exception");
+        succeeded = false;
+      }
+      post([continuation = std::move(continuation), succeeded] { continuation(succeeded); });
+    });
+  }
+
+  std::unique_ptr<HummingBird::Plugins::ITaskGroup> ThreadPool::createGroup() {
+    return std::make_unique<TaskGroup>(*this);
+  }
+
+  void TaskGroup::wait() {
+    if (!m_pool.isWorkerThread()) {
+      m_waitGroup.wait();
+      return;
+    }
+    //waiting on a worker would starve the pool, help out instead
+    while (!m_waitGroup.isDone()) {
+      if (!m_pool.runPendingTask())
+        std::this_thread::yield();
+    }
+  }
+
+  bool ThreadPool::popTask(size_t index, std::function<void()> &task) {
+    WorkerQueue &queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+  }
+
+  bool ThreadPool::stealTask(size_t index, std::function<void()> &task) {
+    for (size_t i = 1; i <= m_queues.size(); i++) {
+      WorkerQueue &queue = *m_queues[(index + i) % m_queues.size()];
+      std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+      if (!lock.owns_lock() || queue.tasks.empty())
+        continue;
+
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  bool ThreadPool::runPendingTask() {
+    const size_t index = isWorkerThread() ? s_workerIndex : 0;
+    std::function<void()> task;
+    if (!popTask(index, task) && !stealTask(index, task))
+      return false;
+
+    m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    static Metrics::Histogram &taskTime = Metrics::StatsRegistry::histogram("threadpool.task_time");
+    Metrics::ScopedTimer timer(taskTime);
+    task();
+    return true;
+  }
+
+  void ThreadPool::workerLoop(size_t index) {
+    s_currentPool = this;
+    s_workerIndex = index;
+    Profiling::Profiler::setThreadName("Worker " + std::to_string(index));
+
+    while (true) {
+      if (runPendingTask())
+        continue;
+
+      std::unique_lock<std::mutex> lock(m_sleepMutex);
+      m_sleepCondition.wait(lock, [this] { return m_stopping || m_pendingTasks.load(std::memory_order_acquire) > 0; });
+      if (m_stopping && m_pendingTasks.load(std::memory_order_acquire) <= 0)
+        return;
+    }
+  }
+}// namespace HummingBirdCore::Threading
@@ -0,0 +1,375 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <IPlugin.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <optional>
+
+namespace HummingBirdCore::Threading {
+  /**
+   * @brief Shared flag to stop work that has not started yet, or to let long running work bail out early.
+   * Copies share the same flag.
+   */
+  class CancellationToken {
+public:
+    CancellationToken() : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() { m_cancelled->store(true, std::memory_order_release); }
+    bool isCancelled() const { return m_cancelled->load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+  };
+
+  /**
+   * @brief Counts outstanding work, wait() blocks until every add() got its done().
+   */
+  class WaitGroup {
+public:
+    void add(int count = 1) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_count += count;
+    }
+
+    void done() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_count == 0)
+        m_condition.notify_all();
+    }
+
+    void wait() {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_count == 0; });
+    }
+
+    bool isDone() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_count == 0;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    int m_count = 0;
+  };
+
+  class ThreadPool;
+
+  namespace Detail {
+    enum TaskStatus {
+      TaskStatusPending,
+      TaskStatusDone,
+      TaskStatusCancelled,
+      TaskStatusFailed
+    };
+
+    template<typename T>
+    struct TaskState {
+      std::mutex mutex;
+      std::condition_variable condition;
+      TaskStatus status = TaskStatusPending;
+      std::conditional_t<std::is_void_v<T>, bool, std::optional<T>> value = {};
+      std::exception_ptr exception = nullptr;
+      std::vector<std::function<void()>> continuations = {};
+
+      bool isFinished() const { return status != TaskStatusPending; }
+
+      void finish(TaskStatus newStatus) {
+        std::vector<std::function<void()>> toRun;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          status = newStatus;
+          toRun.swap(continuations);
+        }
+        condition.notify_all();
+        for (auto &continuation: toRun) {
+          continuation();
+        }
+      }
+    };
+  }// namespace Detail
+
+  /**
+   * @brief Result of ThreadPool::submit(), can be waited on or chained with then().
+   */
+  template<typename T>
+  class TaskHandle {
+public:
+    TaskHandle() = default;
+    explicit TaskHandle(std::shared_ptr<Detail::TaskState<T>> state, ThreadPool *pool) : m_state(std::move(state)), m_pool(pool) {}
+
+    bool isValid() const { return m_state != nullptr; }
+    bool isReady() const {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      return m_state->isFinished();
+    }
+    bool isCancelled() const {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      return m_state->status == Detail::TaskStatusCancelled;
+    }
+
+    /**
+     * @brief Blocks until the task finished. On a pool thread the caller runs other tasks while waiting.
+     */
+    void wait() const;
+
+    /**
+     * @brief Waits and returns the result, rethrows when the task threw.
+     * Cancelled tasks return a default constructed value.
+     */
+    T get() const {
+      wait();
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      if (m_state->exception)
+        std::rethrow_exception(m_state->exception);
+      if constexpr (!std::is_void_v<T>) {
+        return m_state->value.has_value() ? *m_state->value : T{};
+      }
+    }
+
+    /**
+     * @brief Like get() but moves the result out instead of copying it, for the one owner that consumes it.
+     * Later calls to get() or take() return a default constructed value.
+     */
+    T take() {
+      wait();
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      if (m_state->exception)
+        std::rethrow_exception(m_state->exception);
+      if constexpr (!std::is_void_v<T>) {
+        if (!m_state->value.has_value())
+          return T{};
+        T value = std::move(*m_state->value);
+        m_state->value.reset();
+        return value;
+      }
+    }
+
+    /**
+     * @brief Runs func on the pool once this task finished successfully.
+     * @param func Called with the result of this task, or without arguments when the task returns void
+     * @return Handle to the continuation, cancelled when this task failed or got cancelled
+     */
+    template<typename F>
+    auto then(F &&func);
+
+private:
+    std::shared_ptr<Detail::TaskState<T>> m_state = nullptr;
+    ThreadPool *m_pool = nullptr;
+  };
+
+  /**
+   * @brief Work-stealing task scheduler shared by core windows and plugins.
+   *
+   * Every worker owns a queue. Workers push work they submit themselves to the back of their own queue and pop
+   * from the back, tasks from other threads are handed out round robin. Idle workers steal from the front of
+   * the other queues before they go to sleep.
+   */
+  class ThreadPool : public HummingBird::Plugins::ITaskScheduler {
+public:
+    explicit ThreadPool(size_t workerCount);
+    ~ThreadPool() override;
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief The pool of the application, sized to the machine minus the main thread.
+     */
+    static ThreadPool &get();
+
+    /**
+     * @brief Queues func, it is skipped when token is cancelled before it starts.
+     */
+    template<typename F>
+    auto submit(F &&func, const CancellationToken &token = CancellationToken()) -> TaskHandle<std::invoke_result_t<F>> {
+      using Result = std::invoke_result_t<F>;
+      auto state = std::make_shared<Detail::TaskState<Result>>();
+      post([state, token, func = std::forward<F>(func)]() mutable {
+        if (token.isCancelled()) {
+          state->finish(Detail::TaskStatusCancelled);
+          return;
+        }
+        try {
+          if constexpr (std::is_void_v<Result>) {
+            func();
+          } else {
+            Result result = func();
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->value.emplace(std::move(result));
+          }
+        } catch (...) {
+          {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->exception = std::current_exception();
+          }
+          state->finish(Detail::TaskStatusFailed);
+          return;
+        }
+        state->finish(Detail::TaskStatusDone);
+      });
+      return TaskHandle<Result>(state, this);
+    }
+
+    /**
+     * @brief Queues func and marks it done on the wait group when it finished or got skipped.
+     */
+    template<typename F>
+    void submit(WaitGroup &waitGroup, F &&func, const CancellationToken &token = CancellationToken()) {
+      waitGroup.add();
+      post([&waitGroup, token, func = std::forward<F>(func)]() mutable {
+        if (!token.isCancelled()) {
+          try {
+            func();
+          } catch (const std::exception &e) {
+            CORE_ERROR("Task threw: {0}", e.what());
+          } catch (...) {
+            CORE_ERROR("Task threw an unknown exception");
+          }
+        }
+        waitGroup.done();
+      });
+    }
+
+    /**
+     * @brief Runs one queued task on the calling thread.
+     * @return false when there was nothing to run
+     */
+    bool runPendingTask();
+
+    bool isWorkerThread() const;
+
+    /**
+     * @brief Runs what is queued and joins the workers, tasks posted afterwards run on the calling thread.
+     * Called by the application on exit, before the statics the tasks use are destroyed.
+     */
+    void shutdown();
+
+    //ITaskScheduler
+    void post(std::function<void()> task) override;
+    void postThen(std::function<void()> task, std::function<void(bool succeeded)> continuation) override;
+    std::unique_ptr<HummingBird::Plugins::ITaskGroup> createGroup() override;
+    size_t getWorkerCount() const override { return m_workerCount; }
+
+private:
+    struct WorkerQueue {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popTask(size_t index, std::function<void()> &task);
+    bool stealTask(size_t index, std::function<void()> &task);
+
+private:
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues = {};
+    std::vector<std::thread> m_workers = {};
+    size_t m_workerCount = 0;
+
+    std::atomic<size_t> m_nextQueue = 0;
+    std::atomic<int64_t> m_pendingTasks = 0;
+    std::atomic<bool> m_stopping = false;
+    std::atomic<bool> m_joined = false;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+
+    inline static thread_local ThreadPool *s_currentPool = nullptr;
+    inline static thread_local size_t s_workerIndex = 0;
+  };
+
+  /**
+   * @brief ITaskGroup for plugins, a WaitGroup and a CancellationToken on one pool.
+   */
+  class TaskGroup : public HummingBird::Plugins::ITaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool) : m_pool(pool) {}
+    //the queued tasks point at the wait group
+    ~TaskGroup() override { wait(); }
+
+    void post(std::function<void()> task) override { m_pool.submit(m_waitGroup, std::move(task), m_token); }
+    void cancel() override { m_token.cancel(); }
+    bool isCancelled() const override { return m_token.isCancelled(); }
+    void wait() override;
+    bool isDone() override { return m_waitGroup.isDone(); }
+
+private:
+    ThreadPool &m_pool;
+    WaitGroup m_waitGroup;
+    CancellationToken m_token;
+  };
+
+  template<typename T>
+  void TaskHandle<T>::wait() const {
+    if (m_pool != nullptr && m_pool->isWorkerThread()) {
+      //waiting on a worker would starve the pool, help out instead
+      while (!isReady()) {
+        if (!m_pool->runPendingTask())
+          std::this_thread::yield();
+      }
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    m_state->condition.wait(lock, [this] { return m_state->isFinished(); });
+  }
+
+  template<typename T>
+  template<typename F>
+  auto TaskHandle<T>::then(F &&func) {
+    using Result = std::conditional_t<std::is_void_v<T>, std::invoke_result<F>, std::invoke_result<F, T>>::type;
+
+    auto nextState = std::make_shared<Detail::TaskState<Result>>();
+    ThreadPool *pool = m_pool;
+    auto continuation = [state = m_state, nextState, pool, func = std::forward<F>(func)]() mutable {
+      if (state->status != Detail::TaskStatusDone) {
+        nextState->finish(Detail::TaskStatusCancelled);
+        return;
+      }
+      pool->post([state, nextState, func = std::move(func)]() mutable {
+        try {
+          if constexpr (std::is_void_v<T> && std::is_void_v<Result>) {
+            func();
+          } else if constexpr (std::is_void_v<T>) {
+            Result result = func();
+            std::lock_guard<std::mutex> lock(nextState->mutex);
+            nextState->value.emplace(std::move(result));
+          } else if constexpr (std::is_void_v<Result>) {
+            func(*state->value);
+          } else {
+            Result result = func(*state->value);
+            std::lock_guard<std::mutex> lock(nextState->mutex);
+            nextState->value.emplace(std::move(result));
+          }
+        } catch (...) {
+          {
+            std::lock_guard<std::mutex> lock(nextState->mutex);
+            nextState->exception = std::current_exception();
+          }
+          nextState->finish(Detail::TaskStatusFailed);
+          return;
+        }
+        nextState->finish(Detail::TaskStatusDone);
+      });
+    };
+
+    bool finished;
+    {
+      std::lock_guard<std::mutex> lock(m_state->mutex);
+      finished = m_state->isFinished();
+      if (!finished)
+        m_state->continuations.push_back(continuation);
+    }
+    if (finished)
+      continuation();
+
+    return TaskHandle<Result>(nextState, pool);
+  }
+}// namespace HummingBirdCore::Threading
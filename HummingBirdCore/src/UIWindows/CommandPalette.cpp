@@ -0,0 +1,139 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "CommandPalette.h"
+
+#include "Memory/FrameArena.h"
+#include "Metrics/StatsRegistry.h"
+#include "Utils/Input.h"
+
+#include <optional>
+
+namespace HummingBirdCore::UI {
+  void CommandPalette::open() {
+    HB_PROFILE_SCOPE("CommandPalette::open");
+    s_commands.clear();
+    Commands::CommandRegistry::collect(s_commands);
+
+    size_t bytes = 0;
+    for (const auto &command: s_commands) {
+      bytes += command.category.size() + 2 + command.name.size();
+    }
+    s_matcher.clear();
+    s_matcher.reserve(s_commands.size(), bytes);
+    //the category is searched too, "theme dark" finds the dark themes
+    std::string text;
+    for (const auto &command: s_commands) {
+      text.assign(command.category).append(": ").append(command.name);
+      s_matcher.add(text);
+    }
+
+    s_query[0] = '\0';
+    s_open = true;
+    s_focusInput = true;
+    search();
+  }
+
+  void CommandPalette::close() {
+    s_open = false;
+    s_commands.clear();
+    s_matcher.clear();
+    s_results.clear();
+  }
+
+  void CommandPalette::render() {
+    if (Input::isKeyPressed(ImGuiKey_P, ImGuiMod_Ctrl | ImGuiMod_Shift) || Input::isKeyPressed(ImGuiKey_P, ImGuiMod_Super | ImGuiMod_Shift)) {
+      if (s_open)
+        close();
+      else
+        open();
+    }
+    if (!s_open)
+      return;
+
+    HB_PROFILE_SCOPE("CommandPalette::render");
+    if (Input::isKeyPressed(ImGuiKey_Escape)) {
+      close();
+      return;
+    }
+    bool moved = false;
+    if (!s_results.empty()) {
+      if (Input::isKeyPressed(ImGuiKey_DownArrow) && s_selected + 1 < s_results.size()) {
+        s_selected++;
+        moved = true;
+      }
+      if (Input::isKeyPressed(ImGuiKey_UpArrow) && s_selected > 0) {
+        s_selected--;
+        moved = true;
+      }
+      if (Input::isKeyPressed(ImGuiKey_Enter) || Input::isKeyPressed(ImGuiKey_KeypadEnter)) {
+        run(s_selected);
+        return;
+      }
+    }
+
+    const ImGuiViewport *viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x * 0.5f, viewport->WorkPos.y + viewport->WorkSize.y * 0.15f),
+                            ImGuiCond_Always, ImVec2(0.5f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(c_width, 0.0f));
+    if (s_focusInput)
+      ImGui::SetNextWindowFocus();
+
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoSavedSettings |
+                                   ImGuiWindowFlags_NoMove | ImGuiWindowFlags_AlwaysAutoResize;
+    if (ImGui::Begin("##CommandPalette", nullptr, flags)) {
+      if (s_focusInput) {
+        ImGui::SetKeyboardFocusHere();
+        s_focusInput = false;
+      }
+      ImGui::SetNextItemWidth(-FLT_MIN);
+      if (ImGui::InputTextWithHint("##Query", "Type a command, window or file", s_query, sizeof(s_query))) {
+        search();
+      }
+
+      std::optional<size_t> picked;
+      if (s_results.empty()) {
+        ImGui::TextDisabled("No matching commands");
+      } else {
+        const float height = (float) std::min(s_results.size(), c_visibleResults) * ImGui::GetTextLineHeightWithSpacing();
+        if (ImGui::BeginChild("##Results", ImVec2(0.0f, height))) {
+          for (size_t i = 0; i < s_results.size(); i++) {
+            const Commands::Command &command = s_commands[s_results[i].id];
+            const bool selected = i == s_selected;
+            if (ImGui::Selectable(Memory::FrameArena::get().format("{}: {}##{}", command.category, command.name, i), selected))
+              picked = i;
+            if (selected && moved)
+              ImGui::SetScrollHereY();
+          }
+        }
+        ImGui::EndChild();
+      }
+
+      //clicking anywhere else closes it like a popup
+      const bool focused = ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
+      ImGui::End();
+      if (picked.has_value())
+        run(*picked);
+      else if (!focused)
+        close();
+      return;
+    }
+    ImGui::End();
+  }
+
+  void CommandPalette::search() {
+    static Metrics::Histogram &searchTime = Metrics::StatsRegistry::histogram("command_palette.search");
+    Metrics::ScopedTimer timer(searchTime);
+    s_matcher.match(s_query, c_maxResults, s_results);
+    s_selected = 0;
+  }
+
+  void CommandPalette::run(size_t result) {
+    //closing drops the commands, keep the action alive until it returned
+    std::function<void()> action = s_commands[s_results[result].id].action;
+    close();
+    if (action)
+      action();
+  }
+}// namespace HummingBirdCore::UI
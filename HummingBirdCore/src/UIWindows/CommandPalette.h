@@ -0,0 +1,48 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Commands/CommandRegistry.h"
+#include "Commands/FuzzyMatcher.h"
+
+namespace HummingBirdCore::UI {
+  /**
+   * @brief Searchable list of every command, opened with Ctrl+Shift+P (Cmd+Shift+P on macOS) or View -> Command Palette.
+   *
+   * Opening collects the commands and builds the fuzzy index once, typing only searches that index. Up and down pick
+   * a result, enter runs it, escape or clicking outside closes the palette. Every search is recorded in the
+   * command_palette.search histogram. Main thread only.
+   */
+  //Class is fully static
+  class CommandPalette {
+public:
+    static void open();
+    static void close();
+    static bool isOpen() { return s_open; }
+
+    /**
+     * @brief Called by the application every frame after the windows.
+     */
+    static void render();
+
+private:
+    static void search();
+    static void run(size_t result);
+
+private:
+    static constexpr size_t c_maxResults = 50;
+    static constexpr size_t c_visibleResults = 12;
+    static constexpr float c_width = 560.0f;
+
+    inline static bool s_open = false;
+    inline static bool s_focusInput = false;
+    inline static char s_query[256] = {};
+    inline static size_t s_selected = 0;
+    inline static std::vector<Commands::Command> s_commands = {};
+    inline static Commands::FuzzyMatcher s_matcher = {};
+    inline static std::vector<Commands::FuzzyMatcher::Match> s_results = {};
+  };
+}// namespace HummingBirdCore::UI
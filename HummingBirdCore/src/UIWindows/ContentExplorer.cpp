@@ -7,40 +7,136 @@
 namespace HummingBirdCore {
   namespace UIWindows {
     void HummingBirdCore::UIWindows::ContentExplorer::render() {
+      HB_PROFILE_SCOPE("ContentExplorer::render");
+      if (!m_visibility.begin())
+        return;
 
       if(ImGui::Button("<-")){
         if(m_backstack.size() > 0) {
-          m_forwardstack.push_back(m_currentDirectory->getPath());
-          m_currentDirectory = std::make_shared<ContentFolderItem>(m_backstack.back().string(),
-                                                                   m_backstack.back().filename().string());
+          m_forwardstack.push_back(m_currentPath);
+          const std::filesystem::path path = m_backstack.back();
           m_backstack.pop_back();
-          m_currentDirectory->setChildDirectories();
+          loadDirectory(path, path.filename().string(), NavigationBack);
         }
       }
       ImGui::SameLine();
       if(ImGui::Button("->")){
         if(m_forwardstack.size() > 0) {
-          m_backstack.push_back(m_currentDirectory->getPath());
-          m_currentDirectory = std::make_shared<ContentFolderItem>(m_forwardstack.back().string(),
-                                                                   m_forwardstack.back().filename().string());
+          m_backstack.push_back(m_currentPath);
+          const std::filesystem::path path = m_forwardstack.back();
           m_forwardstack.pop_back();
-          m_currentDirectory->setChildDirectories();
+          loadDirectory(path, path.filename().string(), NavigationForward);
         }
       }
       ImGui::SameLine();
       ImGui::SameLine();
       const char* fmt = "Path: %s" ;
-      ImGui::Text(fmt, m_currentDirectory->getPath().c_str());
+      ImGui::Text(fmt, m_currentPath.c_str());
       ImGui::Separator();
 
+      const bool loaded = m_currentDirectory.poll();
+      if (m_navigation.has_value() && !m_currentDirectory.isLoading()) {
+        if (!m_currentDirectory.getError().empty())
+          undoNavigation();
+        else
+          m_navigationError.clear();
+        m_navigation.reset();
+      }
+      if (!m_navigationError.empty())
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", m_navigationError.c_str());
+
       ImGui::BeginChild("###ContentExplorerChild", ImVec2(0, 0), true);
-      for(auto &item : m_currentDirectory->getSubDirectories()) {
-        if (ImGui::Selectable(item.getName().c_str())){
-          changeDirectory(item);
+      //the old listing stays in the model until the new one is swapped in, do not show it for the new path
+      if (!loaded || m_currentDirectory.isLoading()) {
+        m_currentDirectory.renderPlaceholder("Listing folder");
+      } else {
+        //the listing is scanned once per directory change, changing directory replaces the folder we iterate
+        std::shared_ptr<ContentFolderItem> currentDirectory = m_currentDirectory.get();
+        for(auto &folder : currentDirectory->getFolder().SubDirectories) {
+          if (ImGui::Selectable(folder.Name.c_str())){
+            changeDirectory(folder.Path, folder.Name);
+          }
         }
       }
       ImGui::EndChild();
 
     }
+
+    void ContentExplorer::undoNavigation() {
+      CORE_WARN(m_currentDirectory.getError());
+      m_navigationError = m_currentDirectory.getError();
+      const std::filesystem::path failedPath = m_currentPath;
+      switch (m_navigation->type) {
+        case NavigationOpen:
+          m_backstack.pop_back();
+          break;
+        case NavigationBack:
+          m_forwardstack.pop_back();
+          m_backstack.push_back(failedPath);
+          break;
+        case NavigationForward:
+          m_backstack.pop_back();
+          m_forwardstack.push_back(failedPath);
+          break;
+      }
+      //the listing of the previous folder is still in the model
+      m_currentPath = m_navigation->previousPath;
+      m_currentName = m_navigation->previousName;
+    }
+
+    namespace {
+      void writePaths(Workspace::SnapshotWriter &writer, const std::pmr::vector<std::filesystem::path> &paths) {
+        writer.writeU32((uint32_t) paths.size());
+        for (const auto &path: paths) {
+          writer.writeString(path.native());
+        }
+      }
+
+      void readPaths(Workspace::SnapshotReader &reader, std::pmr::vector<std::filesystem::path> &paths) {
+        const uint32_t count = reader.readCount(sizeof(uint32_t));
+        paths.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+          paths.emplace_back(reader.readString());
+        }
+      }
+    }// namespace
+
+    ContentExplorer::ContentExplorer(const std::string &name, Workspace::SnapshotReader &reader) : UIWindow(name, ImGuiWindowFlags_None), m_memory(name, "content_explorer") {
+      //the snapshot holds the listing, the folder is not scanned again until the user navigates
+      m_currentPath = reader.readString();
+      m_currentName = reader.readString();
+      if (reader.readBool()) {
+        Folder folder(m_currentPath, m_currentName);
+        const uint32_t childCount = reader.readCount(2 * sizeof(uint32_t));
+        folder.SubDirectories.reserve(childCount);
+        for (uint32_t i = 0; i < childCount; i++) {
+          std::filesystem::path path(reader.readString());
+          folder.SubDirectories.emplace_back(path, std::string(reader.readString()));
+        }
+        m_currentDirectory.set(std::make_shared<ContentFolderItem>(std::move(folder)));
+      } else {
+        loadDirectory(m_currentPath, m_currentName);
+      }
+      readPaths(reader, m_backstack);
+      readPaths(reader, m_forwardstack);
+    }
+
+    void ContentExplorer::writeSnapshot(Workspace::SnapshotWriter &writer) const {
+      writer.writeString(m_currentPath.native());
+      writer.writeString(m_currentName);
+      //a listing that is still loading is scanned again on restore
+      const bool listed = m_currentDirectory.isReady() && !m_currentDirectory.isLoading();
+      writer.writeBool(listed);
+      if (listed) {
+        const Folder &folder = m_currentDirectory.get()->getFolder();
+        writer.writeU32((uint32_t) folder.SubDirectories.size());
+        for (const auto &child: folder.SubDirectories) {
+          writer.writeString(child.Path.native());
+          writer.writeString(child.Name);
+        }
+      }
+      writePaths(writer, m_backstack);
+      writePaths(writer, m_forwardstack);
+    }
   }// namespace UIWindows
 }// namespace HummingBirdCore
\ No newline at end of file
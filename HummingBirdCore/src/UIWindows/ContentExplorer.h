@@ -8,6 +8,11 @@
 
 #include <HBUI/UIWindow.h>
 
+#include "Memory/WindowMemoryResource.h"
+#include "Threading/AsyncModel.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
+
 namespace HummingBirdCore {
   class ContentBrowserItem {
 public:
@@ -33,6 +38,11 @@ public:
       m_folder.setChildDirectories();
     }
 
+    /**
+     * @brief Uses an already scanned folder, for restoring a workspace.
+     */
+    explicit ContentFolderItem(Folder folder) : ContentBrowserItem(folder.Path, folder.Name), m_folder(std::move(folder)) {}
+
     ~ContentFolderItem(){};
 
     const Folder &getFolder() const { return m_folder; }
@@ -41,43 +51,88 @@ public:
       m_folder.setChildDirectories();
     }
 
-    std::vector<ContentFolderItem> getSubDirectories() const {
-      std::vector<ContentFolderItem> r;
-      for (auto &folder: m_folder.SubDirectories) {
-        r.emplace_back(folder.Path, folder.Name);
-      }
-      return r;
-    }
-
 private:
     Folder m_folder;
   };
 
   namespace UIWindows {
 
-    class ContentExplorer : public HummingBirdCore::UIWindow {
+    class ContentExplorer : public HummingBirdCore::UIWindow, public Workspace::ISnapshotWindow {
 
   public:
       ContentExplorer(const std::string& name) : ContentExplorer(ImGuiWindowFlags_None, name) {}
-      ContentExplorer(ImGuiWindowFlags flags, const std::string& name) : UIWindow(name, ImGuiWindowFlags_None) {
-        changeDirectory(*m_currentDirectory);
+      ContentExplorer(ImGuiWindowFlags flags, const std::string& name) : UIWindow(name, ImGuiWindowFlags_None), m_memory(name, "content_explorer") {
+        m_backstack.push_back(c_startPath);
+        loadDirectory(c_startPath, "opt");
       }
+      ContentExplorer(const std::string &name, Workspace::SnapshotReader &reader);
 
       ~ContentExplorer() {
       }
 
-      void changeDirectory(const ContentFolderItem &folder) {
-        m_backstack.push_back(m_currentDirectory->getPath());
-        m_currentDirectory = std::make_shared<ContentFolderItem>(folder.getPath(), folder.getName());
-        m_currentDirectory->setChildDirectories();
+      void changeDirectory(const std::filesystem::path &path, const std::string &name) {
+        m_backstack.push_back(m_currentPath);
+        loadDirectory(path, name, NavigationOpen);
       }
 
       void render() override;
 
+      const char *getSnapshotType() const override { return "ContentExplorer"; }
+      void writeSnapshot(Workspace::SnapshotWriter &writer) const override;
+
+  private:
+      enum NavigationType {
+        NavigationOpen,
+        NavigationBack,
+        NavigationForward
+      };
+
+      /**
+       * @brief A navigation whose folder is still being listed, undone when the folder can not be listed.
+       */
+      struct Navigation {
+        NavigationType type;
+        std::filesystem::path previousPath;
+        std::string previousName;
+      };
+
+      //large or network mounted folders take a while to list, scan on a worker
+      void loadDirectory(const std::filesystem::path &path, const std::string &name, std::optional<NavigationType> navigation = std::nullopt) {
+        if (navigation.has_value())
+          m_navigation = Navigation{*navigation, m_currentPath, m_currentName};
+        else
+          m_navigation.reset();
+        m_currentPath = path;
+        m_currentName = name;
+        m_currentDirectory.load([path, name](Threading::AsyncProgress &) {
+          //Folder only logs a folder it can not list, the navigation has to know
+          std::error_code ec;
+          std::filesystem::directory_iterator(path, ec);
+          if (ec)
+            throw std::runtime_error("Unable to open " + path.string() + ": " + ec.message());
+          return std::make_shared<ContentFolderItem>(path, name);
+        });
+      }
+
+      /**
+       * @brief Goes back to the folder and history from before the navigation that failed.
+       */
+      void undoNavigation();
+
   private:
-      std::shared_ptr<ContentFolderItem> m_currentDirectory = std::make_shared<ContentFolderItem>("/opt/", "opt");
-      std::vector<std::filesystem::path> m_backstack = {};
-      std::vector<std::filesystem::path> m_forwardstack = {};
+      const std::filesystem::path c_startPath = "/opt/";
+
+      std::filesystem::path m_currentPath;
+      std::string m_currentName;
+      Threading::AsyncModel<std::shared_ptr<ContentFolderItem>> m_currentDirectory;
+      //the listings come from the folder cache every window shares, the history is what this window owns
+      Memory::WindowMemoryResource m_memory;
+      std::pmr::vector<std::filesystem::path> m_backstack{&m_memory};
+      std::pmr::vector<std::filesystem::path> m_forwardstack{&m_memory};
+      std::optional<Navigation> m_navigation = std::nullopt;
+      //shown above the listing until the next navigation
+      std::string m_navigationError;
+      UI::WindowVisibility m_visibility;
     };
 
   }// namespace UIWindows
@@ -15,6 +15,7 @@ public:
     ~LogWindow() = default;
 
     void render() override {
+      HB_PROFILE_SCOPE("LogWindow::render");
       //TODO: Fix this
 //      std::vector<HummingBirdCore::Logging::ImGuiLogSinkItem> logMessages =
 //              HummingBirdCore::Logging::MainLogSink<std::mutex>::getInstance()->getLogMessages();
@@ -15,7 +15,10 @@
 // UIWindows/Widget
 #include "UIWindows/Widget/AllAddonsWidget.h"
 #include "UIWindows/Widget/DataViewer.h"
+#include "UIWindows/Widget/FlameGraphWidget.h"
+#include "UIWindows/Widget/FleetWidget.h"
 #include "UIWindows/Widget/MetricsWidget.h"
+#include "UIWindows/WindowVisibility.h"
 
 // OTHER WINDOWS
 #include "Terminal/TerminalWindow.h"
@@ -28,167 +31,199 @@
 
 // System
 #include <HBUI/WindowManager.h>
+#include "Commands/CommandRegistry.h"
+#include "UIWindows/CommandPalette.h"
+#include "Profiling/SamplingProfiler.h"
+#include "Rendering/FramePacer.h"
+#include "Threading/MainThreadQueue.h"
+#include "Threading/ThreadPool.h"
+#include "Workspace/WorkspaceManager.h"
+
+#include <portable-file-dialogs.h>
 
 //sql
 #include "Sql/SqlWindow.h"
 
 namespace HummingBirdCore {
-  void UI::mainMenuBarCallback() {
-    HummingBirdCore::UI::WindowManager *windowManager = HummingBirdCore::UI::WindowManager::getInstance();
-
-    // File menu
-    if (ImGui::BeginMenu("File")) {
-      // Project management
-      if (ImGui::MenuItem("New Project")) {
-        CORE_WARN("NEW PROJECT NOT IMPLEMENTED");
-      }
-      if (ImGui::MenuItem("Open Project")) {
-        CORE_WARN("OPEN PROJECT NOT IMPLEMENTED");
-      }
-      if (ImGui::MenuItem("Save Project")) {
-        CORE_WARN("SAVE PROJECT NOT IMPLEMENTED");
-      }
-
-      ImGui::Separator();
-
-      // Session management
-      if (ImGui::MenuItem("Log Out")) {
-        CORE_WARN("LOG OUT NOT IMPLEMENTED");
-      }
-      if (ImGui::MenuItem("Exit")) {
-        HBUI::shutdown();
-      }
-      ImGui::EndMenu();
+  namespace {
+    //the dialogs block until the user picks a file, ask on a worker and apply the result between frames
+    void openProject() {
+      Threading::ThreadPool::get().post([] {
+        std::vector<std::string> paths = pfd::open_file("Open Project", "", {"HummingBird workspace", "*.hbws"}).result();
+        if (!paths.empty()) {
+          Threading::MainThreadQueue::post([path = paths.front()] { Workspace::WorkspaceManager::load(path); });
+        }
+      });
     }
 
-    if (ImGui::BeginMenu("SQL")) {
-
-      const std::string baseName = "Sql ";
-#ifndef HUMMINGBIRD_WITH_SQL
-      ImGui::BeginDisabled(true);
-#endif
-
-      if (ImGui::MenuItem("Sql Connect")) {
-#ifdef HUMMINGBIRD_WITH_SQL
-        windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::SqlWindow>(baseName));
-#endif
-      }
-#ifdef HUMMINGBIRD_WITH_SQL
-        ImGui::EndDisabled();
-#endif
+    void saveProject() {
+      Threading::ThreadPool::get().post([] {
+        std::string path = pfd::save_file("Save Project", "workspace.hbws", {"HummingBird workspace", "*.hbws"}).result();
+        if (!path.empty()) {
+          Threading::MainThreadQueue::post([path] { Workspace::WorkspaceManager::save(path); });
+        }
+      });
+    }
 
-      ImGui::EndMenu();
+    template<typename T>
+    void openWindow(const std::string &baseName) {
+      const std::string name = Workspace::WorkspaceManager::makeUniqueName(baseName);
+      Workspace::WorkspaceManager::addWindow(name, std::make_shared<T>(name));
     }
 
-    // Tools menu
-    if (ImGui::BeginMenu("Tools")) {
-      // System Tools
-      if (ImGui::BeginMenu("System Tools")) {
-        if (ImGui::MenuItem("Edit Hosts")) {
-          const std::string baseName = "Edit Hosts ";
-          windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::System::EditHostsWindow>(baseName));
+    //the main menu as a tree of the fixed commands, submenus and items in the order they first appear
+    struct MenuNode {
+      struct Entry {
+        //index into the commands, or into submenus when it is a submenu
+        size_t index = 0;
+        bool submenu = false;
+      };
+
+      std::string name;
+      std::vector<Entry> entries;
+      std::vector<MenuNode> submenus;
+    };
+
+    MenuNode s_menu;
+    uint64_t s_menuVersion = UINT64_MAX;
+
+    void buildMenu(const std::vector<Commands::Command> &commands) {
+      s_menu = MenuNode();
+      for (size_t i = 0; i < commands.size(); i++) {
+        MenuNode *node = &s_menu;
+        std::string_view path = commands[i].category;
+        while (!path.empty()) {
+          const size_t slash = path.find('/');
+          const std::string_view part = path.substr(0, slash);
+          path = slash == std::string_view::npos ? std::string_view() : path.substr(slash + 1);
+
+          auto submenu = std::find_if(node->submenus.begin(), node->submenus.end(), [&](const MenuNode &menu) { return menu.name == part; });
+          if (submenu == node->submenus.end()) {
+            node->entries.push_back({node->submenus.size(), true});
+            node->submenus.push_back({std::string(part)});
+            submenu = node->submenus.end() - 1;
+          }
+          node = &*submenu;
         }
+        node->entries.push_back({i, false});
+      }
+    }
 
-        if (ImGui::MenuItem("Launch daemons")) {
-          const std::string baseName = "Launch daemons ";
-          windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::System::LaunchDaemonsManager>(baseName));
+    //returns the command that was clicked, it is run after the menus are closed
+    std::optional<size_t> renderMenu(const MenuNode &node, const std::vector<Commands::Command> &commands) {
+      std::optional<size_t> clicked;
+      for (const MenuNode::Entry &entry: node.entries) {
+        if (entry.submenu) {
+          const MenuNode &submenu = node.submenus[entry.index];
+          if (ImGui::BeginMenu(submenu.name.c_str())) {
+            if (std::optional<size_t> command = renderMenu(submenu, commands); command.has_value())
+              clicked = command;
+            ImGui::EndMenu();
+          }
+          continue;
         }
 
-        ImGui::EndMenu();
+        const Commands::Command &command = commands[entry.index];
+        if (command.separator)
+          ImGui::Separator();
+        const bool checked = command.isChecked != nullptr && command.isChecked();
+        if (ImGui::MenuItem(command.name.c_str(), command.shortcut.empty() ? nullptr : command.shortcut.c_str(), checked, command.enabled))
+          clicked = entry.index;
       }
-      ImGui::EndMenu();
+      return clicked;
     }
+  }// namespace
 
-    // Developer Tools
-    if (ImGui::BeginMenu("Developer Tools")) {
-      if (ImGui::MenuItem("Terminal")) {
-        const std::string baseName = "Terminal ";
-        windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::Terminal::TerminalWindow>(baseName));
-      }
-      if (ImGui::MenuItem("Debug Window")) {
-        const std::string baseName = "Debug Window ";
-//        windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::UI::LogWindow>(baseName));
-      }
-      ImGui::EndMenu();
+  void UI::mainMenuBarCallback() {
+    const std::vector<Commands::Command> &commands = Commands::CommandRegistry::getCommands();
+    if (s_menuVersion != Commands::CommandRegistry::getVersion()) {
+      buildMenu(commands);
+      s_menuVersion = Commands::CommandRegistry::getVersion();
     }
 
-    // Additional Tools
-    if (ImGui::BeginMenu("Additional Tools")) {
-      if (ImGui::MenuItem("Data Viewer")) {
-        const std::string baseName = "Data Viewer ";
-        windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::Widgets::DataViewer>(baseName));
-      }
+    if (std::optional<size_t> clicked = renderMenu(s_menu, commands); clicked.has_value()) {
+      //the action may add or remove commands, a plugin loading itself for one, so it runs from a copy
+      const std::function<void()> action = commands[*clicked].action;
+      action();
+    }
+  }
 
-      if (ImGui::MenuItem("Content Explorer")) {
-        const std::string baseName = "Content Explorer ";
-        windowManager->addWindow(baseName, 0, std::make_shared<HummingBirdCore::UIWindows::ContentExplorer>(baseName));
-      }
-      ImGui::EndMenu();
+  void UI::registerCommands() {
+    using Commands::CommandRegistry;
+
+    //the main menu, the category is the menu path
+    CommandRegistry::add("File", "New Project", [] { CORE_WARN("NEW PROJECT NOT IMPLEMENTED"); });
+    CommandRegistry::add("File", "Open Project", openProject);
+    CommandRegistry::add("File", "Save Project", saveProject);
+    CommandRegistry::add({.category = "File", .name = "Log Out", .action = [] { CORE_WARN("LOG OUT NOT IMPLEMENTED"); }, .separator = true});
+    CommandRegistry::add("File", "Exit", [] { HBUI::shutdown(); });
+#ifdef HUMMINGBIRD_WITH_SQL
+    CommandRegistry::add("SQL", "Sql Connect", [] { openWindow<HummingBirdCore::SqlWindow>("Sql "); });
+#else
+    CommandRegistry::add({.category = "SQL", .name = "Sql Connect", .action = [] {}, .enabled = false});
+#endif
+    CommandRegistry::add("Tools/System Tools", "Edit Hosts", [] { openWindow<HummingBirdCore::System::EditHostsWindow>("Edit Hosts "); });
+    CommandRegistry::add("Tools/System Tools", "Launch daemons", [] { openWindow<HummingBirdCore::System::LaunchDaemonsManager>("Launch daemons "); });
+    CommandRegistry::add("Developer Tools", "Terminal", [] { openWindow<HummingBirdCore::Terminal::TerminalWindow>("Terminal "); });
+    CommandRegistry::add("Developer Tools", "Metrics", [] { openWindow<HummingBirdCore::Widgets::MetricsWidget>("Metrics "); });
+    CommandRegistry::add({.category = "Developer Tools",
+                          .name = "Sampling Profiler",
+                          .action =
+                                  [] {
+                                    if (Profiling::SamplingProfiler::isRunning())
+                                      Profiling::SamplingProfiler::stop();
+                                    else
+                                      Profiling::SamplingProfiler::start();
+                                  },
+                          .isChecked = Profiling::SamplingProfiler::isRunning});
+    CommandRegistry::add("Developer Tools", "Flame Graph", [] { openWindow<HummingBirdCore::Widgets::FlameGraphWidget>("Flame Graph "); });
+    CommandRegistry::add("Developer Tools", "Fleet", [] { openWindow<HummingBirdCore::Widgets::FleetWidget>("Fleet "); });
+    CommandRegistry::add("Additional Tools", "Data Viewer", [] { openWindow<HummingBirdCore::Widgets::DataViewer>("Data Viewer "); });
+    CommandRegistry::add("Additional Tools", "Content Explorer", [] { openWindow<HummingBirdCore::UIWindows::ContentExplorer>("Content Explorer "); });
+    CommandRegistry::add({.category = "View",
+                          .name = "Idle Rendering",
+                          .action = [] { Rendering::FramePacer::setIdleMode(!Rendering::FramePacer::isIdleMode()); },
+                          .isChecked = Rendering::FramePacer::isIdleMode});
+    CommandRegistry::add({.category = "View",
+                          .name = "Skip Hidden Windows",
+                          .action = [] { WindowVisibility::setEnabled(!WindowVisibility::isEnabled()); },
+                          .isChecked = WindowVisibility::isEnabled});
+    CommandRegistry::add({.category = "View", .name = "Command Palette", .action = CommandPalette::open, .shortcut = "Ctrl+Shift+P"});
+    CommandRegistry::add("View/Styles", "ThemeManager", [] { openWindow<HummingBirdCore::Themes::ThemeManager>("ThemeManager "); });
+    for (int theme = 0; theme < Themes::ImGuiTheme_Count; theme++) {
+      CommandRegistry::add("View/Styles/Themes", Themes::ImGuiTheme_Name((Themes::ImGuiTheme_) theme), [theme] { Themes::ApplyTheme((Themes::ImGuiTheme_) theme); });
     }
 
-    if (ImGui::BeginMenu("View")) {
-      if (ImGui::BeginMenu("Styles")) {
-        if (ImGui::MenuItem("ThemeManager")) {
-          const std::string baseName = "ThemeManager ";
-          WindowManager().addWindow(baseName, 0, std::make_shared<HummingBirdCore::Themes::ThemeManager>(baseName));
-        }
-        if (ImGui::BeginMenu("Themes")) {
-          if (ImGui::MenuItem("ImGuiColorsClassic")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_ImGuiColorsClassic);
-          }
-          if (ImGui::MenuItem("ImGuiColorsDark")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_ImGuiColorsDark);
-          }
-          if (ImGui::MenuItem("ImGuiColorsLight")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_ImGuiColorsLight);
-          }
-          if (ImGui::MenuItem("MaterialFlat")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_MaterialFlat);
-          }
-          if (ImGui::MenuItem("PhotoshopStyle")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_PhotoshopStyle);
-          }
-          if (ImGui::MenuItem("GrayVariations")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_GrayVariations);
-          }
-          if (ImGui::MenuItem("GrayVariations_Darker")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_GrayVariations_Darker);
-          }
-          if (ImGui::MenuItem("MicrosoftStyle")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_MicrosoftStyle);
-          }
-          if (ImGui::MenuItem("Cherry")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_Cherry);
-          }
-          if (ImGui::MenuItem("Darcula")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_Darcula);
-          }
-          if (ImGui::MenuItem("DarculaDarker")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_DarculaDarker);
-          }
-          if (ImGui::MenuItem("LightRounded")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_LightRounded);
-          }
-          if (ImGui::MenuItem("SoDark_AccentBlue")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_SoDark_AccentBlue);
-          }
-          if (ImGui::MenuItem("SoDark_AccentYellow")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_SoDark_AccentYellow);
-          }
-          if (ImGui::MenuItem("SoDark_AccentRed")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_SoDark_AccentRed);
-          }
-          if (ImGui::MenuItem("BlackIsBlack")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_BlackIsBlack);
-          }
-          if (ImGui::MenuItem("WhiteIsWhite")) {
-            Themes::ApplyTheme(Themes::ImGuiTheme_WhiteIsWhite);
-          }
-          ImGui::EndMenu();
-        }
-        ImGui::EndMenu();
+    //every open window has a unique name, HBUI titles the window with it
+    CommandRegistry::addProvider([](std::vector<Commands::Command> &commands) {
+      Workspace::WorkspaceManager::forEachOpenWindow([&commands](const std::string &name) {
+        commands.push_back({"Window", name, [name] { Workspace::WorkspaceManager::focusWindow(name); }});
+      });
+    });
+
+    CommandRegistry::addProvider([](std::vector<Commands::Command> &commands) {
+      for (const auto &path: Workspace::WorkspaceManager::getRecentFiles()) {
+        commands.push_back({"Recent", path.string(), [path] {
+                              Threading::MainThreadQueue::post([path] { Workspace::WorkspaceManager::load(path); });
+                            }});
       }
-      ImGui::EndMenu();
-    }
+    });
+
+    //picking a command puts it at the prompt, it is not run until the user presses enter
+    CommandRegistry::addProvider([](std::vector<Commands::Command> &commands) {
+      const std::vector<std::string> &history = Terminal::TerminalWindow::getHistory();
+      for (auto command = history.rbegin(); command != history.rend(); ++command) {
+        commands.push_back({"Terminal history", *command, [command = *command] {
+                              if (Terminal::TerminalWindow *terminal = Terminal::TerminalWindow::getLastFocused(); terminal != nullptr) {
+                                terminal->setInput(command);
+                                return;
+                              }
+                              const std::string name = Workspace::WorkspaceManager::makeUniqueName("Terminal ");
+                              auto terminal = std::make_shared<HummingBirdCore::Terminal::TerminalWindow>(name);
+                              terminal->setInput(command);
+                              Workspace::WorkspaceManager::addWindow(name, terminal);
+                            }});
+      }
+    });
   }
 }// namespace HummingBirdCore
\ No newline at end of file
@@ -5,5 +5,14 @@
 #pragma once
 
 namespace HummingBirdCore::UI {
+  /**
+   * @brief Draws the main menu from the fixed commands in the command registry, plugin commands included.
+   */
   void mainMenuBarCallback();
+
+  /**
+   * @brief Adds the menu actions to the command registry, and providers for the open windows, recent workspaces and
+   * terminal history to the command palette.
+   */
+  void registerCommands();
 }
\ No newline at end of file
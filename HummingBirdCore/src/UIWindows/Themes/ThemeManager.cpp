@@ -9,11 +9,18 @@ namespace HummingBirdCore {
     int ThemeManager::currentThemeIDX = 0;
 
     void ThemeManager::render() {
+      HB_PROFILE_SCOPE("ThemeManager::render");
+      if (!m_visibility.begin())
+        return;
       ImGui::Text("Theme");
 
-      std::vector<const char*> all_themes_names_antic;
-      for (const auto &v: ALL_THEMES_NAMES)
-        all_themes_names_antic.push_back(v.c_str());
+      //the names never change, build the list once
+      static const std::vector<const char*> all_themes_names_antic = [] {
+        std::vector<const char *> names;
+        for (const auto &v: ALL_THEMES_NAMES)
+          names.push_back(v.c_str());
+        return names;
+      }();
 
       bool changed = ImGui::ListBox(
               "##Theme", &ThemeManager::currentThemeIDX, all_themes_names_antic.data(), all_themes_names_antic.size(), all_themes_names_antic.size());
@@ -5,6 +5,8 @@
 #pragma once
 #include <HBUI/UIWindow.h>
 #include <UIWindows/Themes/Themes.h>
+#include <UIWindows/WindowVisibility.h>
+#include <Workspace/Snapshot.h>
 
 namespace HummingBirdCore::Themes{
   const std::vector<ImGuiTheme_> ALL_THEMES = {
@@ -45,7 +47,7 @@ namespace HummingBirdCore::Themes{
           "SoDark_AccentRed",
           "BlackIsBlack",
           "WhiteIsWhite"};
-  class ThemeManager : public UIWindow {
+  class ThemeManager : public UIWindow, public Workspace::ISnapshotWindow {
 public:
     ThemeManager(const std::string &name) : UIWindow(name, ImGuiWindowFlags_None) {
 
@@ -54,7 +56,11 @@ public:
     ~ThemeManager() = default;
 public:
     void render() override;
+
+    const char *getSnapshotType() const override { return "ThemeManager"; }
+    void writeSnapshot(Workspace::SnapshotWriter &writer) const override {}
 private:
     static int currentThemeIDX;
+    UI::WindowVisibility m_visibility;
   };
 }// namespace HummingBirdCore::Themes
@@ -7,6 +7,8 @@
 
 #include <PCH/pch.h>
 #include <time.h>
+
+#include "UIWindows/WindowVisibility.h"
 //#include <addons/imguidatechooser/imguidatechooser.h>
 
 namespace HummingBirdCore {
@@ -16,6 +18,9 @@ public:
     }
     ~AddonWidget() = default;
     void render() override {
+      HB_PROFILE_SCOPE("AddonWidget::render");
+      if (!m_visibility.begin())
+        return;
       ImGui::Begin("Addon Widget");
 //      if(ImGui::Button("Show/Hide date chooser")){
 //        m_showDateChooser = !m_showDateChooser;
@@ -34,6 +39,7 @@ public:
 
 private:
     bool m_showDateChooser = false;
+    UI::WindowVisibility m_visibility;
   };
 }// namespace HummingBirdCore
 
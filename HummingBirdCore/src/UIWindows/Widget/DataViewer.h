@@ -6,6 +6,15 @@
 
 #include <PCH/pch.h>
 
+#include <HBUI/UIWindow.h>
+
+#include "Memory/MemoryPressureManager.h"
+#include "Memory/WindowMemoryResource.h"
+#include "Metrics/StatsRegistry.h"
+#include "Threading/FrameScheduler.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
+
 namespace HummingBirdCore::Widgets {
   struct Header {
     std::string name;
@@ -13,31 +22,52 @@ namespace HummingBirdCore::Widgets {
   };
 
   struct Row {
+    //the cells live in the memory of the table that holds the row
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     int id;
-    std::map<std::string, std::string> data;
+    std::pmr::map<std::pmr::string, std::pmr::string, std::less<>> data;
+
+    Row(int id, const allocator_type &allocator = {}) : id(id), data(allocator) {
+    }
 
-    Row(int id) : Row(id, {}) {
+    Row(int id, const std::map<std::string, std::string> &data, const allocator_type &allocator = {}) : id(id), data(allocator) {
+      for (const auto &[key, value]: data) {
+        this->data.emplace_hint(this->data.end(), key, value);
+      }
     }
 
-    Row(int id, const std::map<std::string, std::string> &data) : id(id), data(data) {
+    Row(const Row &other, const allocator_type &allocator = {}) : id(other.id), data(other.data, allocator) {
     }
 
-    std::string& operator[](const std::string& key) {
-      return data[key];
+    Row(Row &&other, const allocator_type &allocator) : id(other.id), data(std::move(other.data), allocator) {
     }
 
-    void setValue(const std::string &key, const std::string &value) {
-      data[key] = value;
+    Row(Row &&other) = default;
+    Row &operator=(const Row &other) = default;
+    Row &operator=(Row &&other) = default;
+
+    std::pmr::string& operator[](std::string_view key) {
+      auto it = data.find(key);
+      if (it == data.end())
+        it = data.emplace(key, std::string_view()).first;
+      return it->second;
+    }
+
+    void setValue(std::string_view key, std::string_view value) {
+      (*this)[key] = value;
     }
   };
 
   struct Table {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     std::string name;
 
     bool isInitialized = false;
 
-    std::vector<Header> headers;
-    std::vector<Row> rows;
+    std::pmr::vector<Header> headers;
+    std::pmr::vector<Row> rows;
 
     uint currentColumnIndex = 0;
     std::string currentColumnName = "";
@@ -45,6 +75,9 @@ namespace HummingBirdCore::Widgets {
     uint currentRowIndex = 0;
     std::string currentRowName = "";
 
+    explicit Table(const allocator_type &allocator = {}) : headers(allocator), rows(allocator) {
+    }
+
     int numOfRows() const {
       return rows.size();
     }
@@ -54,22 +87,49 @@ namespace HummingBirdCore::Widgets {
     }
 
     void setHeadersAndRows(const std::vector<Header> &headers, const std::vector<Row> &rows) {
-      this->headers = headers;
-      this->rows = rows;
+      this->headers.assign(headers.begin(), headers.end());
+      this->rows.assign(rows.begin(), rows.end());
       isInitialized = true;
     }
   };
 
-  class DataViewer : public UIWindow {
+  class DataViewer : public UIWindow, public Workspace::ISnapshotWindow, public Memory::IReclaimable {
 public:
-    explicit DataViewer(const std::string &name) : UIWindow(name, ImGuiWindowFlags_MenuBar) {
-
+    explicit DataViewer(const std::string &name) : UIWindow(name, ImGuiWindowFlags_MenuBar), m_memory(name, "dataviewer") {
+      Memory::MemoryPressureManager::add(this);
+    }
+    DataViewer(const std::string &name, Workspace::SnapshotReader &reader) : UIWindow(name, ImGuiWindowFlags_MenuBar), m_memory(name, "dataviewer") {
+      Memory::MemoryPressureManager::add(this);
+      if (reader.readBool())
+        setTable(readTable(reader, &m_memory));
+    }
+    ~DataViewer() {
+      m_restoreToken.cancel();
+      Memory::MemoryPressureManager::remove(this);
     }
-    ~DataViewer() = default;
     void render() override {
+      HB_PROFILE_SCOPE("DataViewer::render");
+      if (!m_visibility.begin())
+        return;
+      Metrics::ScopedTimer timer(m_renderTime);
+      if (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows)) {
+        Memory::MemoryPressureManager::touch(this);
+        if (m_spill.isSpilled() && m_restore == nullptr && !m_restoreFailed)
+          restoreTable();
+      } else {
+        //a failed restore is tried again the next time the window gets the focus, not every frame
+        m_restoreFailed = false;
+      }
+
       ImGui::BeginChild("DataDisplay", ImVec2(0, -ImGui::GetFrameHeightWithSpacing() * 2), true);
       {
-        if (m_table == nullptr) {
+        if (m_restore != nullptr) {
+          ImGui::TextDisabled("Loading %u/%u rows", (uint32_t) m_restore->table->rows.size(), m_restore->rowCount);
+        } else if (m_spill.isSpilled() && m_restoreFailed) {
+          ImGui::TextDisabled("Unable to load the table, focus the window again to retry");
+        } else if (m_spill.isSpilled()) {
+          ImGui::TextDisabled("Unloaded to save memory, focus the window to load it again");
+        } else if (m_table == nullptr) {
           ImGui::Text("No table selected");
         } else {
           if (!m_table->isInitialized) {
@@ -110,9 +170,9 @@ public:
 
                   for (int column_n = 0; column_n < m_table->numOfHeaders(); column_n++) {
                     ImGui::TableSetColumnIndex(column_n);
-                    std::string header = m_table->headers[column_n].name;
-                    std::string value = row->data[header];
-                    ImGui::Text("%s", value.c_str());
+                    const auto value = row->data.find(std::string_view(m_table->headers[column_n].name));
+                    if (value != row->data.end())
+                      ImGui::TextUnformatted(value->second.c_str());
                   }
                   ImGui::PopID();
                 }
@@ -123,9 +183,9 @@ public:
               ImGui::TextColored(ImColor(255, 0, 0), "No headers found");
             }
 
-            getRenderStats()->addStat("Num of displayed items", numOfDisplayedItems);
-            getRenderStats()->addStat("Num of rows", m_table->numOfRows());
-            getRenderStats()->addStat("Num of headers", m_table->numOfHeaders());
+            m_displayedItems.set(numOfDisplayedItems);
+            m_rows.set(m_table->numOfRows());
+            m_headers.set(m_table->numOfHeaders());
           }
         }
       }
@@ -140,12 +200,197 @@ public:
 
     }
 
+    const char *getSnapshotType() const override { return "DataViewer"; }
+    void writeSnapshot(Workspace::SnapshotWriter &writer) const override {
+      if (m_spill.isSpilled()) {
+        Utils::MappedFile file = m_spill.map();
+        Workspace::SnapshotReader reader(file.data(), file.size());
+        std::shared_ptr<Table> table = readTable(reader, std::pmr::get_default_resource());
+        writer.writeBool(table != nullptr);
+        if (table != nullptr)
+          writeTable(writer, *table);
+        return;
+      }
+
+      writer.writeBool(m_table != nullptr);
+      if (m_table != nullptr)
+        writeTable(writer, *m_table);
+    }
+
+    //a table that is only held by this window is written to a spill file and read back on focus
+    size_t getReclaimableBytes() const override {
+      return m_table != nullptr && m_table.use_count() == 1 ? m_tableBytes : 0;
+    }
+
+    size_t reclaim() override {
+      const size_t bytes = getReclaimableBytes();
+      if (bytes == 0)
+        return 0;
+
+      Workspace::SnapshotWriter writer;
+      writeTable(writer, *m_table);
+      if (!m_spill.write(writer.getBuffer()))
+        return 0;
+      m_table.reset();
+      //the pool keeps freed blocks around for the window, hand them back now that the table is gone
+      if (m_memory.getLiveBytes() == 0)
+        m_memory.release();
+      return bytes;
+    }
+
+    const char *getReclaimName() const override { return "DataViewer"; }
+
 public:
+    /**
+     * @brief Shows a new table in the memory of this window, fill is called with the empty table. The table never
+     * leaves the window, it can not outlive the memory it lives in.
+     */
+    void buildTable(const std::function<void(Table &)> &fill) {
+      auto table = std::allocate_shared<Table>(std::pmr::polymorphic_allocator<Table>(&m_memory));
+      fill(*table);
+      setTable(table);
+    }
+
     void setTable(const std::shared_ptr<Table> table) {
+      //a table set while the spilled one is still being read wins
+      if (m_restore != nullptr) {
+        m_restoreToken.cancel();
+        m_restoreToken = Threading::CancellationToken();
+        m_restore.reset();
+      }
+      m_spill.remove();
+      m_restoreFailed = false;
       m_table = table;
+      m_tableBytes = table != nullptr ? estimateBytes(*table) : 0;
     }
 
 private:
+    /**
+     * @brief The spilled table is read back in steps of c_restoreRowsPerStep rows, a large table takes a couple of
+     * frames instead of one long one.
+     */
+    void restoreTable() {
+      auto restore = std::make_unique<Restore>();
+      restore->file = m_spill.map();
+      restore->reader = Workspace::SnapshotReader(restore->file.data(), restore->file.size());
+      restore->table = readTableHeader(restore->reader, &m_memory, restore->rowCount);
+      m_restore = std::move(restore);
+
+      //the job is dropped before the window goes, the state lives in the window
+      Threading::FrameScheduler::post("DataViewer::restoreTable", [this] {
+        Restore &restore = *m_restore;
+        const uint32_t rows = std::min(c_restoreRowsPerStep, restore.rowCount - (uint32_t) restore.table->rows.size());
+        try {
+          readRows(restore.reader, *restore.table, rows);
+        } catch (...) {
+          //the scheduler logs it and drops the job, the window must not wait for it. The spill stays for a retry
+          m_restore.reset();
+          m_restoreFailed = true;
+          throw;
+        }
+        if (restore.reader.isValid() && restore.table->rows.size() < restore.rowCount)
+          return false;
+
+        std::shared_ptr<Table> table = restore.reader.isValid() ? restore.table : nullptr;
+        if (table == nullptr)
+          CORE_ERROR("Unable to read back the spilled table");
+        m_restore.reset();
+        setTable(table);
+        return true;
+      }, m_restoreToken);
+    }
+
+    static void writeTable(Workspace::SnapshotWriter &writer, const Table &table) {
+      writer.writeString(table.name);
+      writer.writeBool(table.isInitialized);
+      writer.writeU32((uint32_t) table.headers.size());
+      for (const auto &header: table.headers) {
+        writer.writeString(header.name);
+      }
+
+      //cells are written in map order so restoring can append with a hint
+      writer.writeU32((uint32_t) table.rows.size());
+      for (const auto &row: table.rows) {
+        writer.writeI32(row.id);
+        writer.writeU32((uint32_t) row.data.size());
+        for (const auto &[key, value]: row.data) {
+          writer.writeString(key);
+          writer.writeString(value);
+        }
+      }
+    }
+
+    static std::shared_ptr<Table> readTable(Workspace::SnapshotReader &reader, std::pmr::memory_resource *resource) {
+      uint32_t rowCount = 0;
+      std::shared_ptr<Table> table = readTableHeader(reader, resource, rowCount);
+      readRows(reader, *table, rowCount);
+      return reader.isValid() ? table : nullptr;
+    }
+
+    /**
+     * @brief Reads everything up to the rows, rowCount is set to the number of rows that follow.
+     */
+    static std::shared_ptr<Table> readTableHeader(Workspace::SnapshotReader &reader, std::pmr::memory_resource *resource, uint32_t &rowCount) {
+      auto table = std::allocate_shared<Table>(std::pmr::polymorphic_allocator<Table>(resource));
+      table->name = reader.readString();
+      table->isInitialized = reader.readBool();
+
+      const uint32_t headerCount = reader.readCount(sizeof(uint32_t));
+      table->headers.reserve(headerCount);
+      for (uint32_t i = 0; i < headerCount; i++) {
+        table->headers.push_back({std::string(reader.readString())});
+      }
+
+      rowCount = reader.readCount(2 * sizeof(uint32_t));
+      table->rows.reserve(rowCount);
+      return table;
+    }
+
+    static void readRows(Workspace::SnapshotReader &reader, Table &table, uint32_t count) {
+      for (uint32_t i = 0; i < count; i++) {
+        Row &row = table.rows.emplace_back(reader.readI32());
+        const uint32_t cellCount = reader.readCount(2 * sizeof(uint32_t));
+        for (uint32_t cell = 0; cell < cellCount; cell++) {
+          std::string_view key = reader.readString();
+          row.data.emplace_hint(row.data.end(), key, reader.readString());
+        }
+      }
+    }
+
+    static size_t estimateBytes(const Table &table) {
+      size_t bytes = sizeof(Table) + table.headers.capacity() * sizeof(Header) + table.rows.capacity() * sizeof(Row);
+      for (const auto &row: table.rows) {
+        for (const auto &[key, value]: row.data) {
+          //map node header plus both strings
+          bytes += 4 * sizeof(void *) + 2 * sizeof(std::pmr::string) + key.capacity() + value.capacity();
+        }
+      }
+      return bytes;
+    }
+
+private:
+    struct Restore {
+      Utils::MappedFile file;
+      Workspace::SnapshotReader reader;
+      std::shared_ptr<Table> table;
+      uint32_t rowCount = 0;
+    };
+
+    static constexpr uint32_t c_restoreRowsPerStep = 256;
+
+    //declared before the table so a table built in it goes first
+    Memory::WindowMemoryResource m_memory;
     std::shared_ptr<Table> m_table;
+    size_t m_tableBytes = 0;
+    Memory::SpillFile m_spill;
+    UI::WindowVisibility m_visibility;
+    std::unique_ptr<Restore> m_restore;
+    bool m_restoreFailed = false;
+    Threading::CancellationToken m_restoreToken;
+
+    Metrics::Histogram &m_renderTime = Metrics::StatsRegistry::histogram("dataviewer.render_time");
+    Metrics::Gauge &m_displayedItems = Metrics::StatsRegistry::gauge("dataviewer.displayed_items");
+    Metrics::Gauge &m_rows = Metrics::StatsRegistry::gauge("dataviewer.rows");
+    Metrics::Gauge &m_headers = Metrics::StatsRegistry::gauge("dataviewer.headers");
   };
 }// namespace HummingBirdCore::Widgets
@@ -0,0 +1,162 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <HBUI/UIWindow.h>
+
+#include "Profiling/SamplingProfiler.h"
+#include "Rendering/FramePacer.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
+
+namespace HummingBirdCore::Widgets {
+  /**
+   * @brief Flame graph of the samples taken by the SamplingProfiler, callers on top of their callees.
+   * Clicking a function zooms into it, clicking the top row zooms back out one level.
+   */
+  class FlameGraphWidget : public UIWindow, public Workspace::ISnapshotWindow {
+public:
+    explicit FlameGraphWidget(const std::string &name) : UIWindow(name, ImGuiWindowFlags_MenuBar) {
+    }
+
+    ~FlameGraphWidget() = default;
+    void render() override {
+      HB_PROFILE_SCOPE("FlameGraphWidget::render");
+      //the sample ring has to be drained while hidden too, the handler drops samples once it is full
+      if (!m_visibility.begin()) {
+        if (m_visibility.isBackgroundTickDue())
+          Profiling::SamplingProfiler::collect();
+        return;
+      }
+      Profiling::SamplingProfiler::collect();
+
+      const bool running = Profiling::SamplingProfiler::isRunning();
+      if (ImGui::BeginMenuBar()) {
+        if (ImGui::MenuItem(running ? "Stop" : "Start")) {
+          if (running)
+            Profiling::SamplingProfiler::stop();
+          else
+            Profiling::SamplingProfiler::start();
+        }
+        if (ImGui::MenuItem("Clear")) {
+          Profiling::SamplingProfiler::clear();
+          m_zoomNode = Profiling::SamplingProfiler::c_rootNode;
+        }
+        if (ImGui::MenuItem("Reset Zoom", nullptr, false, m_zoomNode != Profiling::SamplingProfiler::c_rootNode)) {
+          m_zoomNode = Profiling::SamplingProfiler::c_rootNode;
+        }
+        ImGui::EndMenuBar();
+      }
+
+      ImGui::Text("%s, %llu samples at %d Hz, %llu dropped", running ? "Sampling" : "Stopped",
+                  (unsigned long long) Profiling::SamplingProfiler::getSampleCount(), Profiling::SamplingProfiler::getFrequency(),
+                  (unsigned long long) Profiling::SamplingProfiler::getDroppedCount());
+      if (running) {
+        //new samples only show up when a frame collects them
+        Rendering::FramePacer::requestFrameIn(c_refreshInterval);
+      }
+      ImGui::Separator();
+
+      const std::vector<Profiling::FlameNode> &nodes = Profiling::SamplingProfiler::getNodes();
+      if (nodes.empty() || nodes[Profiling::SamplingProfiler::c_rootNode].samples == 0) {
+        ImGui::TextDisabled("No samples yet, start sampling from the menu bar or Developer Tools");
+        return;
+      }
+      if (m_zoomNode >= nodes.size())
+        m_zoomNode = Profiling::SamplingProfiler::c_rootNode;
+
+      renderGraph(nodes);
+    }
+
+    //samples are only meaningful for the session they were taken in
+    const char *getSnapshotType() const override { return "FlameGraph"; }
+    void writeSnapshot(Workspace::SnapshotWriter &writer) const override {}
+
+private:
+    void renderGraph(const std::vector<Profiling::FlameNode> &nodes) {
+      ImGui::BeginChild("FlameGraph", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+      uint32_t maxDepth = 0;
+      for (const auto &node: nodes) {
+        maxDepth = std::max(maxDepth, node.depth);
+      }
+      const float rowHeight = ImGui::GetTextLineHeight() + 2.0f * c_rowPadding;
+      const ImVec2 origin = ImGui::GetCursorScreenPos();
+      const float width = ImGui::GetContentRegionAvail().x;
+      const float height = (float) (maxDepth - nodes[m_zoomNode].depth + 1) * rowHeight;
+      ImGui::InvisibleButton("##canvas", ImVec2(std::max(width, 1.0f), std::max(height, 1.0f)));
+      const bool canvasHovered = ImGui::IsItemHovered();
+
+      ImDrawList *drawList = ImGui::GetWindowDrawList();
+      m_hoveredNode = c_noNode;
+      drawNode(drawList, nodes, m_zoomNode, origin.x, width, origin.y, rowHeight, canvasHovered);
+
+      if (m_hoveredNode != c_noNode) {
+        const Profiling::FlameNode &hovered = nodes[m_hoveredNode];
+        const double total = (double) nodes[Profiling::SamplingProfiler::c_rootNode].samples;
+        ImGui::BeginTooltip();
+        ImGui::TextUnformatted(Profiling::SamplingProfiler::getSymbolName(hovered.symbol).c_str());
+        ImGui::Text("Total: %llu samples (%.2f%%)", (unsigned long long) hovered.samples, 100.0 * (double) hovered.samples / total);
+        ImGui::Text("Self: %llu samples (%.2f%%)", (unsigned long long) hovered.selfSamples, 100.0 * (double) hovered.selfSamples / total);
+        ImGui::EndTooltip();
+
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
+          //the top row is the zoomed function itself, clicking it goes back up one level
+          m_zoomNode = m_hoveredNode == m_zoomNode ? nodes[m_zoomNode].parent : m_hoveredNode;
+        }
+      }
+      ImGui::EndChild();
+    }
+
+    void drawNode(ImDrawList *drawList, const std::vector<Profiling::FlameNode> &nodes, uint32_t index, float x, float width, float y,
+                  float rowHeight, bool canvasHovered) {
+      const Profiling::FlameNode &node = nodes[index];
+      const ImVec2 min(x, y);
+      const ImVec2 max(x + width - 1.0f, y + rowHeight - 1.0f);
+      drawList->AddRectFilled(min, max, getColor(node.symbol));
+
+      //only label what has room for a couple of characters
+      if (width > c_minLabelWidth) {
+        const std::string &name = Profiling::SamplingProfiler::getSymbolName(node.symbol);
+        const ImVec4 clip(min.x, min.y, max.x - c_rowPadding, max.y);
+        drawList->AddText(nullptr, 0.0f, ImVec2(x + c_rowPadding, y + c_rowPadding), IM_COL32(20, 20, 20, 255), name.c_str(),
+                          name.c_str() + name.size(), 0.0f, &clip);
+      }
+
+      if (canvasHovered && ImGui::IsMouseHoveringRect(min, max, false))
+        m_hoveredNode = index;
+
+      //children split the width by their share of the samples, what is left is time spent in this function itself
+      float childX = x;
+      for (uint32_t child: node.children) {
+        const float childWidth = width * (float) nodes[child].samples / (float) node.samples;
+        if (childWidth >= c_minNodeWidth)
+          drawNode(drawList, nodes, child, childX, childWidth, y + rowHeight, rowHeight, canvasHovered);
+        childX += childWidth;
+      }
+    }
+
+    static ImU32 getColor(uint32_t symbol) {
+      //stable warm colors per function, neighbours differ enough to tell them apart
+      const uint32_t hash = symbol * 2654435761u;
+      const int red = 205 + (int) (hash % 50);
+      const int green = 80 + (int) ((hash >> 8) % 150);
+      const int blue = (int) ((hash >> 16) % 60);
+      return IM_COL32(red, green, blue, 255);
+    }
+
+private:
+    static constexpr uint32_t c_noNode = std::numeric_limits<uint32_t>::max();
+    static constexpr double c_refreshInterval = 0.25;
+    static constexpr float c_rowPadding = 2.0f;
+    static constexpr float c_minNodeWidth = 1.0f;
+    static constexpr float c_minLabelWidth = 20.0f;
+
+    uint32_t m_zoomNode = Profiling::SamplingProfiler::c_rootNode;
+    uint32_t m_hoveredNode = c_noNode;
+    UI::WindowVisibility m_visibility{std::chrono::milliseconds((int) (c_refreshInterval * 1000))};
+  };
+}// namespace HummingBirdCore::Widgets
@@ -0,0 +1,212 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include "Rendering/FramePacer.h"
+#include "Remote/AgentRegistry.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
+
+namespace HummingBirdCore::Widgets {
+  /**
+   * @brief Every agent this UI talks to, with the stats and system load each one publishes.
+   *
+   * Subscribes to the stats topic of every connected agent, the agents only send what changed since the last
+   * publish so a few dozen idle nodes cost next to nothing. Windows pick one of these agents as their target.
+   */
+  class FleetWidget : public UIWindow, public Workspace::ISnapshotWindow {
+public:
+    explicit FleetWidget(const std::string &name) : UIWindow(name, ImGuiWindowFlags_None) {
+    }
+
+    ~FleetWidget() {
+      for (const auto &[address, subscription]: m_subscriptions) {
+        if (std::shared_ptr<Remote::AgentClient> agent = subscription.agent.lock())
+          agent->cancel(subscription.requestId);
+      }
+    }
+
+    void render() override {
+      HB_PROFILE_SCOPE("FleetWidget::render");
+      if (!m_visibility.begin())
+        return;
+      ImGui::SetNextItemWidth(c_addressWidth);
+      const bool entered = ImGui::InputTextWithHint("##Address", "host:port", m_address, sizeof(m_address), ImGuiInputTextFlags_EnterReturnsTrue);
+      ImGui::SameLine();
+      if ((ImGui::Button("Add agent") || entered) && m_address[0] != '\0') {
+        if (Remote::AgentRegistry::add(m_address) == nullptr)
+          CORE_WARN("Invalid agent address {0}", m_address);
+        m_address[0] = '\0';
+      }
+      if (Remote::AgentRegistry::getToken().empty())
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "HUMMINGBIRD_AGENT_TOKEN is not set, agents will turn this UI down");
+      ImGui::Separator();
+
+      subscribe();
+
+      const std::vector<std::shared_ptr<Remote::AgentClient>> &agents = Remote::AgentRegistry::getAgents();
+      if (agents.empty()) {
+        ImGui::TextDisabled("No agents, start HummingBirdAgent on a host and add it above");
+        return;
+      }
+
+      std::string removed;
+      const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+      if (ImGui::BeginTable("Agents", 6, flags)) {
+        ImGui::TableSetupColumn("Agent", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Host");
+        ImGui::TableSetupColumn("State");
+        ImGui::TableSetupColumn("Load 1/5/15");
+        ImGui::TableSetupColumn("Pending");
+        ImGui::TableSetupColumn("##Actions");
+        ImGui::TableHeadersRow();
+
+        for (const auto &agent: agents) {
+          const std::string &address = agent->getAddress();
+          ImGui::TableNextRow();
+          ImGui::PushID(address.c_str());
+          ImGui::TableNextColumn();
+          if (ImGui::Selectable(address.c_str(), m_selected == address, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap))
+            m_selected = address;
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(agent->getHostname().c_str());
+          ImGui::TableNextColumn();
+          if (agent->getState() == Remote::AgentClient::StateFailed) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", agent->getStateName());
+            if (ImGui::IsItemHovered())
+              ImGui::SetTooltip("%s", agent->getError().c_str());
+          } else {
+            ImGui::TextUnformatted(agent->getStateName());
+          }
+          ImGui::TableNextColumn();
+          if (auto subscription = m_subscriptions.find(address); subscription != m_subscriptions.end()) {
+            std::lock_guard lock(subscription->second.stats->mutex);
+            const std::map<std::string, std::string> &values = subscription->second.stats->values;
+            ImGui::Text("%s %s %s", getValue(values, "system.load1"), getValue(values, "system.load5"), getValue(values, "system.load15"));
+          }
+          ImGui::TableNextColumn();
+          ImGui::Text("%zu", agent->getPendingCount());
+          ImGui::TableNextColumn();
+          if (agent->getState() == Remote::AgentClient::StateFailed) {
+            if (ImGui::SmallButton("Reconnect"))
+              agent->connect();
+            ImGui::SameLine();
+          }
+          if (ImGui::SmallButton("Remove"))
+            removed = address;
+          ImGui::PopID();
+        }
+        ImGui::EndTable();
+      }
+
+      if (!removed.empty()) {
+        unsubscribe(removed);
+        Remote::AgentRegistry::remove(removed);
+        if (m_selected == removed)
+          m_selected.clear();
+      }
+      renderSelected();
+    }
+
+    //the agents come from the registry, reopening the window is enough
+    const char *getSnapshotType() const override { return "Fleet"; }
+    void writeSnapshot(Workspace::SnapshotWriter &writer) const override {}
+
+private:
+    //written on the agent thread, read while rendering
+    struct Stats {
+      std::mutex mutex;
+      std::map<std::string, std::string> values;
+    };
+
+    struct Subscription {
+      std::weak_ptr<Remote::AgentClient> agent;
+      uint32_t requestId = 0;
+      std::shared_ptr<Stats> stats = std::make_shared<Stats>();
+      std::shared_ptr<std::atomic<bool>> active = std::make_shared<std::atomic<bool>>(true);
+    };
+
+    /**
+     * @brief Subscribes to every connected agent that is not subscribed to yet, again after it reconnected.
+     */
+    void subscribe() {
+      for (const auto &agent: Remote::AgentRegistry::getAgents()) {
+        if (agent->getState() != Remote::AgentClient::StateConnected)
+          continue;
+        auto existing = m_subscriptions.find(agent->getAddress());
+        if (existing != m_subscriptions.end() && existing->second.active->load() && existing->second.agent.lock() == agent)
+          continue;
+
+        Subscription subscription;
+        subscription.agent = agent;
+        Workspace::SnapshotWriter writer;
+        writer.writeString(Remote::c_topicStats);
+        subscription.requestId = agent->stream(Remote::MessageSubscribe, writer.getBuffer(),
+                                               [stats = subscription.stats, active = subscription.active](const Remote::Frame &frame) {
+                                                 //an error ends the subscription, a reconnect subscribes again
+                                                 if (frame.type != Remote::MessageDelta) {
+                                                   active->store(false);
+                                                   return;
+                                                 }
+                                                 Workspace::SnapshotReader reader = frame.getReader();
+                                                 {
+                                                   std::lock_guard lock(stats->mutex);
+                                                   Remote::applyDelta(reader, stats->values);
+                                                 }
+                                                 Rendering::FramePacer::requestFrame();
+                                               });
+        m_subscriptions[agent->getAddress()] = std::move(subscription);
+      }
+    }
+
+    void unsubscribe(const std::string &address) {
+      auto subscription = m_subscriptions.find(address);
+      if (subscription == m_subscriptions.end())
+        return;
+      if (std::shared_ptr<Remote::AgentClient> agent = subscription->second.agent.lock())
+        agent->cancel(subscription->second.requestId);
+      m_subscriptions.erase(subscription);
+    }
+
+    void renderSelected() {
+      auto subscription = m_subscriptions.find(m_selected);
+      if (subscription == m_subscriptions.end())
+        return;
+
+      ImGui::Separator();
+      ImGui::Text("Stats of %s", m_selected.c_str());
+      const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV |
+                                    ImGuiTableFlags_ScrollY;
+      if (ImGui::BeginTable("Stats", 2, flags)) {
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        std::lock_guard lock(subscription->second.stats->mutex);
+        for (const auto &[name, value]: subscription->second.stats->values) {
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(name.c_str());
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(value.c_str());
+        }
+        ImGui::EndTable();
+      }
+    }
+
+    static const char *getValue(const std::map<std::string, std::string> &values, const std::string &name) {
+      auto value = values.find(name);
+      return value == values.end() ? "-" : value->second.c_str();
+    }
+
+private:
+    static constexpr float c_addressWidth = 240.0f;
+
+    char m_address[256] = {};
+    std::string m_selected;
+    std::unordered_map<std::string, Subscription> m_subscriptions;
+    UI::WindowVisibility m_visibility;
+  };
+}// namespace HummingBirdCore::Widgets
@@ -5,8 +5,20 @@
 #pragma once
 #include <PCH/pch.h>
 
+#include "Profiling/Profiler.h"
+#include "Memory/AllocationCounter.h"
+#include "Memory/FrameArena.h"
+#include "Memory/ImGuiAllocator.h"
+#include "Memory/WindowMemoryResource.h"
+#include "Metrics/StatsRegistry.h"
+#include "Rendering/FramePacer.h"
+#include "Threading/FrameScheduler.h"
+#include "Threading/MainThreadQueue.h"
+#include "UIWindows/WindowVisibility.h"
+#include "Workspace/Snapshot.h"
+
 namespace HummingBirdCore::Widgets {
-  class MetricsWidget : public UIWindow {
+  class MetricsWidget : public UIWindow, public Workspace::ISnapshotWindow {
 public:
         explicit MetricsWidget(const std::string &name) : UIWindow(name, ImGuiWindowFlags_MenuBar) {
 
@@ -14,7 +26,260 @@ public:
 
         ~MetricsWidget() = default;
         void render() override {
+          HB_PROFILE_SCOPE("MetricsWidget::render");
+          if (!m_visibility.begin())
+            return;
+          if (ImGui::BeginMenuBar()) {
+            if (ImGui::MenuItem("Dump Trace")) {
+              dumpTrace();
+            }
+            if (ImGui::MenuItem("Export Stats")) {
+              exportStats();
+            }
+            if (ImGui::MenuItem("Reset")) {
+              Profiling::Profiler::resetStats();
+              Metrics::StatsRegistry::reset();
+            }
+            if (ImGui::MenuItem("Pause", nullptr, &m_paused) && m_paused) {
+              //keep a copy so the table stays readable while paused
+              m_pausedZoneStats = Profiling::Profiler::getZoneStats();
+            }
+            ImGui::EndMenuBar();
+          }
+
+          ImGui::Text("Frame rate: %.1f fps", Rendering::FramePacer::getFrameRate());
+          ImGui::Text("Idle: %.1f%%", Rendering::FramePacer::getIdlePercentage());
+          ImGui::Text("Idle rendering: %s", Rendering::FramePacer::isIdleMode() ? "on" : "off");
+          ImGui::Text("Main thread queue: %zu ran, %zu pending", Threading::MainThreadQueue::getLastDrainCount(),
+                      Threading::MainThreadQueue::getPendingCount());
+          ImGui::Text("Frame jobs: %zu queued, %.1f of %.1f ms budget used", Threading::FrameScheduler::getQueueDepth(),
+                      Threading::FrameScheduler::getLastSliceMs(), Threading::FrameScheduler::getLastBudgetMs());
+          if (Memory::AllocationCounter::isEnabled()) {
+            ImGui::Text("Heap allocations last frame: %llu", (unsigned long long) Memory::AllocationCounter::getLastFrameAllocations());
+          }
+          ImGui::Text("Frame arena: %zu KB peak, %zu KB reserved", Memory::FrameArena::get().getPeakBytes() / 1024,
+                      Memory::FrameArena::get().getCapacity() / 1024);
+          ImGui::Separator();
+
+          renderFrameGraph();
+          if (ImGui::TreeNode("ImGui memory")) {
+            renderAllocatorTable();
+            ImGui::TreePop();
+          }
+          if (ImGui::TreeNode("Frame jobs")) {
+            renderFrameJobTable();
+            ImGui::TreePop();
+          }
+          if (ImGui::TreeNode("Window memory")) {
+            renderWindowMemoryTable();
+            ImGui::TreePop();
+          }
+          if (ImGui::TreeNode("Stats")) {
+            renderStatsTable();
+            ImGui::TreePop();
+          }
+          renderZoneTable();
+        }
+
+        //the statistics describe this session, reopening the window is enough
+        const char *getSnapshotType() const override { return "Metrics"; }
+        void writeSnapshot(Workspace::SnapshotWriter &writer) const override {}
+
+private:
+        void renderFrameGraph() {
+          if (!m_paused) {
+            m_frameTimes = Profiling::Profiler::getFrameTimes();
+            m_frameTimesOffset = Profiling::Profiler::getFrameTimesOffset();
+          }
+
+          float maxFrameTime = 0.0f;
+          for (float frameTime: m_frameTimes) {
+            maxFrameTime = std::max(maxFrameTime, frameTime);
+          }
+
+          char overlay[32];
+          snprintf(overlay, sizeof(overlay), "%.2f ms (max %.2f)", Profiling::Profiler::getLastFrameTime(), maxFrameTime);
+          ImGui::PlotLines("##FrameTimes", m_frameTimes.data(), (int) m_frameTimes.size(), m_frameTimesOffset, overlay,
+                           0.0f, std::max(maxFrameTime, c_targetFrameMs), ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+        }
+
+        void renderZoneTable() {
+          const std::vector<Profiling::ZoneStats> &zoneStats = m_paused ? m_pausedZoneStats : Profiling::Profiler::getZoneStats();
+
+          const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter |
+                                        ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY;
+          if (ImGui::BeginTable("Zones", 5, flags)) {
+            ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Last (ms)");
+            ImGui::TableSetupColumn("Avg (ms)");
+            ImGui::TableSetupColumn("Max (ms)");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableHeadersRow();
+
+            for (const auto &zone: zoneStats) {
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::Indent((float) zone.depth * 10.0f + 1.0f);
+              ImGui::TextUnformatted(zone.name.c_str());
+              ImGui::Unindent((float) zone.depth * 10.0f + 1.0f);
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%.3f", zone.lastMs);
+              ImGui::TableSetColumnIndex(2);
+              ImGui::Text("%.3f", zone.avgMs);
+              ImGui::TableSetColumnIndex(3);
+              ImGui::Text("%.3f", zone.maxMs);
+              ImGui::TableSetColumnIndex(4);
+              ImGui::Text("%u", zone.calls);
+            }
+            ImGui::EndTable();
+          }
+        }
+
+        void renderFrameJobTable() {
+          const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+          if (ImGui::BeginTable("FrameJobs", 5, flags)) {
+            ImGui::TableSetupColumn("Job", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Waited (ms)");
+            ImGui::TableSetupColumn("Ran (ms)");
+            ImGui::TableSetupColumn("Steps");
+            ImGui::TableSetupColumn("Frames");
+            ImGui::TableHeadersRow();
+
+            Threading::FrameScheduler::forEachJob([](const Threading::FrameScheduler::JobInfo &job) {
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::TextUnformatted(job.name.c_str());
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%.1f", job.waitedMs);
+              ImGui::TableSetColumnIndex(2);
+              ImGui::Text("%.1f", job.ranMs);
+              ImGui::TableSetColumnIndex(3);
+              ImGui::Text("%u", job.steps);
+              ImGui::TableSetColumnIndex(4);
+              ImGui::Text("%u", job.frames);
+            });
+            ImGui::EndTable();
+          }
+        }
+
+        void renderWindowMemoryTable() {
+          const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+          if (ImGui::BeginTable("WindowMemory", 4, flags)) {
+            ImGui::TableSetupColumn("Window", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Live (KB)");
+            ImGui::TableSetupColumn("Reserved (KB)");
+            ImGui::TableSetupColumn("Peak (KB)");
+            ImGui::TableHeadersRow();
+
+            for (const Memory::WindowMemoryResource *resource: Memory::WindowMemoryResource::getResources()) {
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::TextUnformatted(resource->getWindowName().c_str());
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%.1f", (double) resource->getLiveBytes() / 1024.0);
+              ImGui::TableSetColumnIndex(2);
+              ImGui::Text("%.1f", (double) resource->getReservedBytes() / 1024.0);
+              ImGui::TableSetColumnIndex(3);
+              ImGui::Text("%.1f", (double) resource->getPeakBytes() / 1024.0);
+            }
+            ImGui::EndTable();
+          }
+        }
+
+        void renderAllocatorTable() {
+          ImGui::Text("Pooled: %zu KB", Memory::ImGuiAllocator::getPooledBytes() / 1024);
+
+          const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+          if (ImGui::BeginTable("Allocators", 5, flags)) {
+            ImGui::TableSetupColumn("Owner", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Live (KB)");
+            ImGui::TableSetupColumn("Peak (KB)");
+            ImGui::TableSetupColumn("Blocks");
+            ImGui::TableSetupColumn("Allocs/s");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < Memory::ImGuiAllocator::getOwnerCount(); i++) {
+              const Memory::AllocatorOwner &owner = Memory::ImGuiAllocator::getOwner(i);
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::TextUnformatted(owner.name.c_str());
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%.1f", (double) owner.liveBytes.load() / 1024.0);
+              ImGui::TableSetColumnIndex(2);
+              ImGui::Text("%.1f", (double) owner.peakBytes.load() / 1024.0);
+              ImGui::TableSetColumnIndex(3);
+              ImGui::Text("%lld", (long long) owner.liveAllocations.load());
+              ImGui::TableSetColumnIndex(4);
+              ImGui::Text("%.0f", owner.allocationsPerSecond);
+            }
+            ImGui::EndTable();
+          }
+        }
+
+        void renderStatsTable() {
+          const ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+          if (ImGui::BeginTable("Stats", 5, flags)) {
+            ImGui::TableSetupColumn("Stat", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Value / p50");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableHeadersRow();
+
+            Metrics::StatsRegistry::forEachCounter([](const std::string &name, const Metrics::Counter &counter) {
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::TextUnformatted(name.c_str());
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%lld", (long long) counter.get());
+            });
+            Metrics::StatsRegistry::forEachGauge([](const std::string &name, const Metrics::Gauge &gauge) {
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::TextUnformatted(name.c_str());
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%.2f", gauge.get());
+            });
+            Metrics::StatsRegistry::forEachHistogram([](const std::string &name, const Metrics::Histogram &histogram) {
+              const Metrics::HistogramSummary summary = histogram.getSummary();
+              ImGui::TableNextRow();
+              ImGui::TableSetColumnIndex(0);
+              ImGui::Text("%s (%s)", name.c_str(), histogram.getUnit().c_str());
+              ImGui::TableSetColumnIndex(1);
+              ImGui::Text("%llu", (unsigned long long) summary.p50);
+              ImGui::TableSetColumnIndex(2);
+              ImGui::Text("%llu", (unsigned long long) summary.p99);
+              ImGui::TableSetColumnIndex(3);
+              ImGui::Text("%llu", (unsigned long long) summary.max);
+              ImGui::TableSetColumnIndex(4);
+              ImGui::Text("%llu", (unsigned long long) summary.count);
+            });
+            ImGui::EndTable();
+          }
+        }
+
+        void exportStats() {
+          std::time_t now = std::time(nullptr);
+          char fileName[64];
+          std::strftime(fileName, sizeof(fileName), "HummingBirdStats-%Y%m%d-%H%M%S.json", std::localtime(&now));
+          Metrics::StatsRegistry::exportJson(fileName);
+        }
+
+        void dumpTrace() {
+          std::time_t now = std::time(nullptr);
+          char fileName[64];
+          std::strftime(fileName, sizeof(fileName), "HummingBirdTrace-%Y%m%d-%H%M%S.json", std::localtime(&now));
+          Profiling::Profiler::dumpChromeTrace(fileName);
         }
+
+private:
+        const float c_targetFrameMs = 16.6f;
+
+        bool m_paused = false;
+        std::array<float, Profiling::Profiler::c_frameHistorySize> m_frameTimes = {};
+        int m_frameTimesOffset = 0;
+        std::vector<Profiling::ZoneStats> m_pausedZoneStats = {};
+        UI::WindowVisibility m_visibility;
   };
 }
-
@@ -0,0 +1,34 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "WindowVisibility.h"
+
+#include "Metrics/StatsRegistry.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace HummingBirdCore::UI {
+  bool WindowVisibility::begin() {
+    static Metrics::Counter &rendered = Metrics::StatsRegistry::counter("ui.windows_rendered");
+    static Metrics::Counter &skipped = Metrics::StatsRegistry::counter("ui.windows_skipped");
+
+    //ImGui sets SkipItems for collapsed windows, unselected dock tabs and windows that are not active this frame,
+    //it is cleared again for the frames a window needs to measure itself
+    const ImGuiWindow *window = ImGui::GetCurrentWindowRead();
+    m_visible = !s_enabled || window == nullptr || !window->SkipItems;
+    (m_visible ? rendered : skipped).add();
+    return m_visible;
+  }
+
+  bool WindowVisibility::isBackgroundTickDue() {
+    if (m_visible || m_backgroundInterval.count() <= 0)
+      return false;
+    const Clock::time_point now = Clock::now();
+    if (now - m_lastBackgroundTick < m_backgroundInterval)
+      return false;
+    m_lastBackgroundTick = now;
+    return true;
+  }
+}// namespace HummingBirdCore::UI
@@ -0,0 +1,51 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+namespace HummingBirdCore::UI {
+  /**
+   * @brief Tells a window whether anything it draws this frame can be seen.
+   *
+   * WindowManager calls render() on every window every frame, also on windows that are collapsed or sit in an
+   * unselected dock tab. Windows own one of these and check it first thing in render(), a hidden window returns
+   * right away. Windows that have to keep up with work while hidden pass a background interval and do that work
+   * when isBackgroundTickDue(). Rendered and skipped bodies are counted in ui.windows_rendered and
+   * ui.windows_skipped. Main thread only.
+   */
+  class WindowVisibility {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit WindowVisibility(std::chrono::milliseconds backgroundInterval = std::chrono::milliseconds(0)) : m_backgroundInterval(backgroundInterval) {
+    }
+
+    /**
+     * @brief Call first in render(), the window WindowManager began is the current ImGui window.
+     * @return false when the body can be skipped
+     */
+    bool begin();
+
+    /**
+     * @return true at most once per background interval while the window is hidden, never without an interval
+     */
+    bool isBackgroundTickDue();
+
+    bool isVisible() const { return m_visible; }
+
+    /**
+     * @brief Turned off every window renders its body again, to compare frame times. View -> Skip Hidden Windows.
+     */
+    static void setEnabled(bool enabled) { s_enabled = enabled; }
+    static bool isEnabled() { return s_enabled; }
+
+private:
+    std::chrono::milliseconds m_backgroundInterval;
+    Clock::time_point m_lastBackgroundTick = {};
+    bool m_visible = true;
+
+    inline static bool s_enabled = true;
+  };
+}// namespace HummingBirdCore::UI
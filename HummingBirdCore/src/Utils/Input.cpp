@@ -0,0 +1,218 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "Input.h"
+
+#include "Metrics/StatsRegistry.h"
+
+#include <GLFW/glfw3.h>
+
+namespace HummingBirdCore {
+  namespace {
+    struct KeyMapping {
+      int glfwKey;
+      ImGuiKey key;
+    };
+
+    const KeyMapping c_keyMappings[] = {
+            {GLFW_KEY_ENTER, ImGuiKey_Enter},
+            {GLFW_KEY_KP_ENTER, ImGuiKey_KeypadEnter},
+            {GLFW_KEY_BACKSPACE, ImGuiKey_Backspace},
+            {GLFW_KEY_DELETE, ImGuiKey_Delete},
+            {GLFW_KEY_TAB, ImGuiKey_Tab},
+            {GLFW_KEY_ESCAPE, ImGuiKey_Escape},
+            {GLFW_KEY_SPACE, ImGuiKey_Space},
+            {GLFW_KEY_UP, ImGuiKey_UpArrow},
+            {GLFW_KEY_DOWN, ImGuiKey_DownArrow},
+            {GLFW_KEY_LEFT, ImGuiKey_LeftArrow},
+            {GLFW_KEY_RIGHT, ImGuiKey_RightArrow},
+            {GLFW_KEY_HOME, ImGuiKey_Home},
+            {GLFW_KEY_END, ImGuiKey_End},
+            {GLFW_KEY_PAGE_UP, ImGuiKey_PageUp},
+            {GLFW_KEY_PAGE_DOWN, ImGuiKey_PageDown},
+            {GLFW_KEY_LEFT_CONTROL, ImGuiKey_LeftCtrl},
+            {GLFW_KEY_RIGHT_CONTROL, ImGuiKey_RightCtrl},
+            {GLFW_KEY_LEFT_SHIFT, ImGuiKey_LeftShift},
+            {GLFW_KEY_RIGHT_SHIFT, ImGuiKey_RightShift},
+            {GLFW_KEY_LEFT_ALT, ImGuiKey_LeftAlt},
+            {GLFW_KEY_RIGHT_ALT, ImGuiKey_RightAlt},
+            {GLFW_KEY_LEFT_SUPER, ImGuiKey_LeftSuper},
+            {GLFW_KEY_RIGHT_SUPER, ImGuiKey_RightSuper},
+    };
+
+    ImGuiKey toImGuiKey(int glfwKey) {
+      if (glfwKey >= GLFW_KEY_A && glfwKey <= GLFW_KEY_Z)
+        return (ImGuiKey) (ImGuiKey_A + (glfwKey - GLFW_KEY_A));
+      if (glfwKey >= GLFW_KEY_0 && glfwKey <= GLFW_KEY_9)
+        return (ImGuiKey) (ImGuiKey_0 + (glfwKey - GLFW_KEY_0));
+      for (const auto &mapping: c_keyMappings) {
+        if (mapping.glfwKey == glfwKey)
+          return mapping.key;
+      }
+      return ImGuiKey_None;
+    }
+
+    ImGuiKeyChord toImGuiMods(int glfwMods) {
+      ImGuiKeyChord mods = 0;
+      if (glfwMods & GLFW_MOD_CONTROL)
+        mods |= ImGuiMod_Ctrl;
+      if (glfwMods & GLFW_MOD_SHIFT)
+        mods |= ImGuiMod_Shift;
+      if (glfwMods & GLFW_MOD_ALT)
+        mods |= ImGuiMod_Alt;
+      if (glfwMods & GLFW_MOD_SUPER)
+        mods |= ImGuiMod_Super;
+      return mods;
+    }
+
+    //the callbacks that were installed before ours, ImGui's backend
+    GLFWcharfun s_previousCharCallback = nullptr;
+    GLFWkeyfun s_previousKeyCallback = nullptr;
+    GLFWmousebuttonfun s_previousMouseButtonCallback = nullptr;
+    GLFWscrollfun s_previousScrollCallback = nullptr;
+  }// namespace
+
+  void Input::install(GLFWwindow *window) {
+    if (window == nullptr) {
+      CORE_WARN("No window to read input from");
+      return;
+    }
+    if (s_window != nullptr)
+      uninstall();
+
+    //only the main window, ImGui owns the callbacks of the windows it creates for viewports
+    s_window = window;
+    s_previousCharCallback = glfwSetCharCallback(window, onCharacter);
+    s_previousKeyCallback = glfwSetKeyCallback(window, onKey);
+    s_previousMouseButtonCallback = glfwSetMouseButtonCallback(window, onMouseButton);
+    s_previousScrollCallback = glfwSetScrollCallback(window, onScroll);
+  }
+
+  void Input::uninstall() {
+    if (s_window == nullptr)
+      return;
+
+    glfwSetCharCallback(s_window, s_previousCharCallback);
+    glfwSetKeyCallback(s_window, s_previousKeyCallback);
+    glfwSetMouseButtonCallback(s_window, s_previousMouseButtonCallback);
+    glfwSetScrollCallback(s_window, s_previousScrollCallback);
+    s_window = nullptr;
+    s_pendingEvents.clear();
+    s_frameEvents.clear();
+  }
+
+  void Input::addCharacter(uint32_t character) {
+    Event &event = s_pendingEvents.emplace_back();
+    event.type = EventCharacter;
+    event.character = character;
+    event.arrivalNs = Profiling::Profiler::nowNs();
+  }
+
+  void Input::addKey(ImGuiKey key, bool down, bool repeat, ImGuiKeyChord mods) {
+    Event &event = s_pendingEvents.emplace_back();
+    event.type = EventKey;
+    event.key = key;
+    event.down = down;
+    event.repeat = repeat;
+    event.mods = mods;
+    event.arrivalNs = Profiling::Profiler::nowNs();
+  }
+
+  void Input::addMouseButton(int button, bool down) {
+    Event &event = s_pendingEvents.emplace_back();
+    event.type = EventMouseButton;
+    event.button = button;
+    event.down = down;
+    event.arrivalNs = Profiling::Profiler::nowNs();
+  }
+
+  void Input::addScroll(float x, float y) {
+    Event &event = s_pendingEvents.emplace_back();
+    event.type = EventScroll;
+    event.scrollX = x;
+    event.scrollY = y;
+    event.arrivalNs = Profiling::Profiler::nowNs();
+  }
+
+  void Input::beginFrame() {
+    //the previous frame's list is empty after endFrame, swapping keeps both allocations around
+    s_frameEvents.clear();
+    std::swap(s_frameEvents, s_pendingEvents);
+  }
+
+  void Input::endFrame() {
+    HB_PROFILE_SCOPE("Input::endFrame");
+    static Metrics::Histogram &latency = Metrics::StatsRegistry::histogram("input.latency");
+    static Metrics::Counter &events = Metrics::StatsRegistry::counter("input.events");
+
+    const int64_t presentNs = Profiling::Profiler::nowNs();
+    for (const Event &event: s_frameEvents) {
+      latency.record((uint64_t) std::max<int64_t>(presentNs - event.arrivalNs, 0) / 1000);
+    }
+    events.add((int64_t) s_frameEvents.size());
+    s_frameEvents.clear();
+  }
+
+  std::string Input::getText() {
+    std::string text;
+    for (const Event &event: s_frameEvents) {
+      if (event.type == EventCharacter)
+        appendUtf8(text, event.character);
+    }
+    return text;
+  }
+
+  bool Input::isKeyPressed(ImGuiKey key, ImGuiKeyChord mods) {
+    for (const Event &event: s_frameEvents) {
+      if (event.type == EventKey && event.key == key && event.down && event.mods == mods)
+        return true;
+    }
+    return false;
+  }
+
+  void Input::appendUtf8(std::string &text, uint32_t character) {
+    if (character < 0x80) {
+      text += (char) character;
+    } else if (character < 0x800) {
+      text += (char) (0xC0 | (character >> 6));
+      text += (char) (0x80 | (character & 0x3F));
+    } else if (character < 0x10000) {
+      text += (char) (0xE0 | (character >> 12));
+      text += (char) (0x80 | ((character >> 6) & 0x3F));
+      text += (char) (0x80 | (character & 0x3F));
+    } else if (character < 0x110000) {
+      text += (char) (0xF0 | (character >> 18));
+      text += (char) (0x80 | ((character >> 12) & 0x3F));
+      text += (char) (0x80 | ((character >> 6) & 0x3F));
+      text += (char) (0x80 | (character & 0x3F));
+    }
+  }
+
+  void Input::onCharacter(GLFWwindow *window, unsigned int codepoint) {
+    if (s_previousCharCallback != nullptr)
+      s_previousCharCallback(window, codepoint);
+    addCharacter(codepoint);
+  }
+
+  void Input::onKey(GLFWwindow *window, int key, int scancode, int action, int mods) {
+    if (s_previousKeyCallback != nullptr)
+      s_previousKeyCallback(window, key, scancode, action, mods);
+
+    const ImGuiKey imGuiKey = toImGuiKey(key);
+    if (imGuiKey != ImGuiKey_None)
+      addKey(imGuiKey, action != GLFW_RELEASE, action == GLFW_REPEAT, toImGuiMods(mods));
+  }
+
+  void Input::onMouseButton(GLFWwindow *window, int button, int action, int mods) {
+    if (s_previousMouseButtonCallback != nullptr)
+      s_previousMouseButtonCallback(window, button, action, mods);
+    addMouseButton(button, action == GLFW_PRESS);
+  }
+
+  void Input::onScroll(GLFWwindow *window, double x, double y) {
+    if (s_previousScrollCallback != nullptr)
+      s_previousScrollCallback(window, x, y);
+    addScroll((float) x, (float) y);
+  }
+}// namespace HummingBirdCore
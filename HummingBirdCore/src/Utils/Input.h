@@ -2,189 +2,93 @@
 // Created by Kasper de Bruin on 20/12/2023.
 //
 #pragma once
+#include <PCH/pch.h>
 
-#include "Log.h"
-//#include <SDL.h>
-#include <vector>
+#include <imgui.h>
+
+struct GLFWwindow;
 
-//TODO: expand this class
-// with mouse locations etc.
 namespace HummingBirdCore {
+  /**
+   * @brief Every input event that arrived since the previous frame, in arrival order and timestamped on arrival.
+   *
+   * ImGui only exposes the state at the start of a frame, a window that polls it sees one key press or character
+   * per frame at most. Input queues the raw events instead, beginFrame() hands all of them to the frame that is
+   * about to be built and endFrame() records how long every one of them waited until that frame was presented in
+   * the input.latency histogram. Main thread only.
+   */
   //Class is fully static
   class Input {
 public:
-//
-////    inline static void update(const SDL_Event &event) {
-//      //Keys
-////      if (event.type == SDL_KEYDOWN) {
-////        m_isAnyKeyPressed = true;
-////        if (event.key.keysym.mod & KMOD_LSHIFT || event.key.keysym.mod & KMOD_RSHIFT) {
-////          m_isAnyShiftPressed = true;
-////          m_isLeftShiftPressed = true;
-////        }
-////        if (event.key.keysym.mod & KMOD_LALT || event.key.keysym.mod & KMOD_RALT) {
-////          m_isAnyAltPressed = true;
-////          m_isLeftAltPressed = true;
-////        }
-////        if (event.key.keysym.mod & KMOD_LCTRL || event.key.keysym.mod & KMOD_RCTRL) {
-////          m_isAnyCtrlPressed = true;
-////          m_isLeftCtrlPressed = true;
-////        }
-////      }
-////      if (event.type == SDL_KEYUP) {
-////        if (!(event.key.keysym.mod & KMOD_LSHIFT || event.key.keysym.mod & KMOD_RSHIFT)) {
-////          m_isAnyShiftPressed = false;
-////          m_isLeftShiftPressed = false;
-////        }
-////        if (!(event.key.keysym.mod & KMOD_LALT || event.key.keysym.mod & KMOD_RALT)) {
-////          m_isAnyAltPressed = false;
-////          m_isLeftAltPressed = false;
-////        }
-////        if (!(event.key.keysym.mod & KMOD_LCTRL || event.key.keysym.mod & KMOD_RCTRL)) {
-////          m_isAnyCtrlPressed = false;
-////          m_isLeftCtrlPressed = false;
-////        }
-////      }
-////
-////      if (event.type == SDL_KEYUP) {
-////        for (int i = 0; i < m_pressedKeys.size(); i++) {
-////          if (m_pressedKeys[i] == event.key.keysym.sym) {
-////            m_pressedKeys.erase(m_pressedKeys.begin() + i);
-////            break;
-////          }
-////        }
-////      }
-////
-////      if (event.type == SDL_KEYDOWN) {
-////        bool add = true;
-////        if (m_pressedKeys.size() > 0) {
-////          for (int i = 0; i < m_pressedKeys.size(); i++) {
-////            if (m_pressedKeys[i] == event.key.keysym.sym) {
-////              add = false;
-////              break;
-////            }
-////          }
-////        }
-////        if (add) {
-////          m_pressedKeys.push_back(event.key.keysym.sym);
-////        }
-////      }
-////
-////      if (m_pressedKeys.size() > 0) {
-////        m_isAnyKeyPressed = true;
-////      }
-////
-////      //Mouse
-////      if (event.type == SDL_MOUSEBUTTONDOWN) {
-////        if (event.button.button == SDL_BUTTON_LEFT) {
-////          m_isLeftMousePressed = true;
-////        }
-////        if (event.button.button == SDL_BUTTON_RIGHT) {
-////          m_isRightMousePressed = true;
-////        }
-////        if (event.button.button == SDL_BUTTON_MIDDLE) {
-////          m_isMiddleMousePressed = true;
-////        }
-////      }
-////
-////      if (event.type == SDL_MOUSEBUTTONUP) {
-////        if (event.button.button == SDL_BUTTON_LEFT) {
-////          m_isLeftMousePressed = false;
-////        }
-////        if (event.button.button == SDL_BUTTON_RIGHT) {
-////          m_isRightMousePressed = false;
-////        }
-////        if (event.button.button == SDL_BUTTON_MIDDLE) {
-////          m_isMiddleMousePressed = false;
-////        }
-////      }
-//    }
-//
-////    inline static bool isKeyPressed (SDL_Keycode key) {
-////      for (int i = 0; i < m_pressedKeys.size(); i++) {
-////        if (m_pressedKeys[i] == key) {
-////          return true;
-////        }
-////      }
-////      return false;
-////    }
-//
-//    inline static bool isAnyKeyPressed() {
-//      return m_isAnyKeyPressed;
-//    }
-//
-//    inline static bool isAnyShiftPressed() {
-//      return m_isAnyShiftPressed;
-//    }
-//
-//    inline static bool isAnyAltPressed() {
-//      return m_isAnyAltPressed;
-//    }
-//
-//    inline static bool isAnyCtrlPressed() {
-//      return m_isAnyCtrlPressed;
-//    }
-//
-//    inline static bool isLeftShiftPressed() {
-//      return m_isLeftShiftPressed;
-//    }
-//
-//    inline static bool isLeftAltPressed() {
-//      return m_isLeftAltPressed;
-//    }
-//
-//    inline static bool isLeftCtrlPressed() {
-//      return m_isLeftCtrlPressed;
-//    }
-//
-//    inline static bool isLeftMousePressed() {
-//      return m_isLeftMousePressed;
-//    }
-//
-//    inline static bool isRightMousePressed() {
-//      return m_isRightMousePressed;
-//    }
-//
-//    inline static bool isMiddleMousePressed() {
-//      return m_isMiddleMousePressed;
-//    }
-//
-//    //
-//    inline static void reset() {
-//      m_isAnyKeyPressed = false;
-//      m_isAnyShiftPressed = false;
-//      m_isAnyAltPressed = false;
-//      m_isAnyCtrlPressed = false;
-//      m_isLeftShiftPressed = false;
-//      m_isLeftAltPressed = false;
-//      m_isLeftCtrlPressed = false;
-//      m_isLeftMousePressed = false;
-//      m_isRightMousePressed = false;
-//      m_isMiddleMousePressed = false;
-//      m_pressedKeys.clear();
-//    }
-//
-//private:
-//    //keys
-//    //Inputs
-//    inline static bool m_isAnyShiftPressed = false;
-//    inline static bool m_isAnyAltPressed = false;
-//    inline static bool m_isAnyKeyPressed = false;
-//    inline static bool m_isAnyCtrlPressed = false;
-//    //left
-//    inline static bool m_isLeftCtrlPressed = false;
-//    inline static bool m_isLeftShiftPressed = false;
-//    inline static bool m_isLeftAltPressed = false;
-//    //Right
-//    inline static bool m_isRightCtrlPressed = false;
-//    inline static bool m_isRightShiftPressed = false;
-//    inline static bool m_isRightAltPressed = false;
-//    //other keys
-////    inline static std::vector<SDL_Keycode> m_pressedKeys;
-//
-//    //Mouse
-//    inline static bool m_isLeftMousePressed = false;
-//    inline static bool m_isRightMousePressed = false;
-//    inline static bool m_isMiddleMousePressed = false;
+    enum EventType {
+      EventCharacter,
+      EventKey,
+      EventMouseButton,
+      EventScroll
+    };
+
+    struct Event {
+      EventType type = EventCharacter;
+      //unicode codepoint for EventCharacter
+      uint32_t character = 0;
+      ImGuiKey key = ImGuiKey_None;
+      //ImGuiMod_ flags held while the key was pressed
+      ImGuiKeyChord mods = 0;
+      int button = 0;
+      bool down = false;
+      bool repeat = false;
+      float scrollX = 0.0f;
+      float scrollY = 0.0f;
+      int64_t arrivalNs = 0;
+    };
+
+    /**
+     * @brief Hooks the window's GLFW callbacks, the callbacks installed before (ImGui's) keep being called.
+     */
+    static void install(GLFWwindow *window);
+    static void uninstall();
+
+    //event sources, the headless runner feeds its recording through these
+    static void addCharacter(uint32_t character);
+    static void addKey(ImGuiKey key, bool down, bool repeat = false, ImGuiKeyChord mods = 0);
+    static void addMouseButton(int button, bool down);
+    static void addScroll(float x, float y);
+
+    /**
+     * @brief Hands everything queued so far to this frame, call after the platform events were polled.
+     */
+    static void beginFrame();
+
+    /**
+     * @brief Records the input-to-present latency of this frame's events, call once the frame was presented.
+     */
+    static void endFrame();
+
+    static const std::vector<Event> &getEvents() { return s_frameEvents; }
+
+    /**
+     * @return every character typed this frame as UTF-8
+     */
+    static std::string getText();
+
+    /**
+     * @return true when the key went down or repeated this frame
+     */
+    static bool isKeyPressed(ImGuiKey key, ImGuiKeyChord mods = 0);
+
+    static void appendUtf8(std::string &text, uint32_t character);
+
+private:
+    static void onCharacter(GLFWwindow *window, unsigned int codepoint);
+    static void onKey(GLFWwindow *window, int key, int scancode, int action, int mods);
+    static void onMouseButton(GLFWwindow *window, int button, int action, int mods);
+    static void onScroll(GLFWwindow *window, double x, double y);
+
+private:
+    //arrived since the last beginFrame
+    inline static std::vector<Event> s_pendingEvents = {};
+    //delivered to the frame that is being built
+    inline static std::vector<Event> s_frameEvents = {};
+    inline static GLFWwindow *s_window = nullptr;
   };
 }// namespace HummingBirdCore
@@ -0,0 +1,81 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HummingBirdCore::Utils {
+  /**
+   * @brief Read only memory mapping of a whole file, pages are only read from disk when they are touched.
+   */
+  class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path &path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+    MappedFile &operator=(MappedFile &&other) noexcept {
+      if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+      }
+      return *this;
+    }
+
+    bool open(const std::filesystem::path &path) {
+      close();
+
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd == -1) {
+        CORE_ERROR("Unable to open file: " + path.string());
+        return false;
+      }
+
+      struct stat info = {};
+      if (fstat(fd, &info) == -1 || info.st_size == 0) {
+        CORE_ERROR("Unable to map empty or unreadable file: " + path.string());
+        ::close(fd);
+        return false;
+      }
+
+      void *data = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      //the mapping keeps the file alive on its own
+      ::close(fd);
+      if (data == MAP_FAILED) {
+        CORE_ERROR("Unable to map file: " + path.string());
+        return false;
+      }
+
+      m_data = (const uint8_t *) data;
+      m_size = (size_t) info.st_size;
+      return true;
+    }
+
+    void close() {
+      if (m_data != nullptr) {
+        munmap((void *) m_data, m_size);
+      }
+      m_data = nullptr;
+      m_size = 0;
+    }
+
+    bool isOpen() const { return m_data != nullptr; }
+    const uint8_t *data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const uint8_t *m_data = nullptr;
+    size_t m_size = 0;
+  };
+}// namespace HummingBirdCore::Utils
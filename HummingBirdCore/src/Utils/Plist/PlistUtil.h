@@ -10,6 +10,7 @@
 #include <libxml2/libxml/parser.h>
 #include <libxml2/libxml/tree.h>
 
+#include <Memory/Cache.h>
 #include <Utils/UUID.h>
 
 //Kasper coding at 3:00 AM so no idea what this doe
@@ -139,6 +140,30 @@ public:
     }
   };
 
+  struct CachedPlist {
+    std::filesystem::file_time_type modified;
+    PlistNode rootNode;
+  };
+
+  inline size_t getNodeSize(const PlistNode &node) {
+    size_t size = sizeof(PlistNode) + node.key.capacity();
+    if (node.value.has_value() && std::holds_alternative<std::string>(*node.value))
+      size += std::get<std::string>(*node.value).capacity();
+    for (const auto &[key, child]: node.children) {
+      //map node header plus the copy of the key
+      size += 4 * sizeof(void *) + sizeof(std::string) + key.capacity() + getNodeSize(child);
+    }
+    return size;
+  }
+
+  /**
+   * @brief Parsed plists by path, selecting a launch daemon parses its file again for the unsaved changes check.
+   */
+  inline Memory::Cache<std::string, CachedPlist> &getPlistCache() {
+    static Memory::Cache<std::string, CachedPlist> cache("plists", [](const CachedPlist &plist) { return getNodeSize(plist.rootNode); });
+    return cache;
+  }
+
   class Plist {
 public:
     explicit Plist() {
@@ -249,14 +274,43 @@ public:
 
       parseNode(root_element, rootNode, currentKey);
 
+      //no xmlCleanupParser() here, launch agents are parsed on workers while other threads use libxml2
       xmlFreeDoc(doc);
-      xmlCleanupParser();
 
       checkForDateNodes(rootNode);
       parsed = true;
       return true;
     }
 
+    /**
+     * @brief parsePlist() through the plist cache, a file that did not change since it was parsed is not read again.
+     */
+    bool loadPlist(const std::string &filename) {
+      std::error_code ec;
+      const std::filesystem::file_time_type modified = std::filesystem::last_write_time(filename, ec);
+      if (ec)
+        return parsePlist(filename);
+
+      Memory::Cache<std::string, CachedPlist>::Value cached = getPlistCache().getOrLoad(
+              filename,
+              [&filename, modified]() -> std::optional<CachedPlist> {
+                Plist plist;
+                if (!plist.parsePlist(filename))
+                  return std::nullopt;
+                return CachedPlist{modified, std::move(plist.rootNode)};
+              },
+              [modified](const CachedPlist &plist) { return plist.modified == modified; });
+      if (cached == nullptr) {
+        parsed = false;
+        return false;
+      }
+
+      //the editor changes the tree in place, the cached one stays as it is on disk
+      rootNode = cached->rootNode;
+      parsed = true;
+      return true;
+    }
+
     void checkForDateNodes(PlistNode &node) {
       if (PlistNode::Date::Identify(node)) {
         node.type = PlistTypeDate;
@@ -314,6 +368,18 @@ public:
       return rootNode;
     }
 
+    const PlistNode &getRootNode() const {
+      return rootNode;
+    }
+
+    /**
+     * @brief Takes an already parsed tree, for restoring a workspace without reading the file again.
+     */
+    void setRootNode(PlistNode node) {
+      rootNode = std::move(node);
+      parsed = true;
+    }
+
     bool writePlist(File &file) {
       std::string plistString = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       plistString += "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" \"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n";
@@ -73,7 +73,7 @@ namespace HummingBirdCore {
       }
 
   public:
-      const std::string getName() const {
+      const std::string &getName() const {
         return name;
       }
       std::string getExtension() const {
@@ -185,6 +185,7 @@ namespace HummingBirdCore {
         }
 
         std::fclose(fp);
+        return true;
       }
 
       inline static File getFile(const std::filesystem::path &fileLocation) {
@@ -0,0 +1,31 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <IPlugin.h>
+#include "WorkspaceManager.h"
+
+namespace HummingBirdCore::Workspace {
+  /**
+   * @brief Hands the workspace to plugins, their windows are listed and focused like the core ones.
+   * Plugin windows have no snapshot type, a saved workspace does not reopen them.
+   */
+  class PluginWindows : public HummingBird::Plugins::IWindowRegistry {
+public:
+    static PluginWindows &get() {
+      static PluginWindows s_instance;
+      return s_instance;
+    }
+
+    void addWindow(const char *name, std::shared_ptr<UIWindow> window) override {
+      WorkspaceManager::addWindow(name, window);
+    }
+
+    bool focusWindow(const char *name) override {
+      return WorkspaceManager::focusWindow(name);
+    }
+  };
+}// namespace HummingBirdCore::Workspace
@@ -0,0 +1,175 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <bit>
+#include <cstring>
+#include <string_view>
+
+namespace HummingBirdCore::Workspace {
+  /**
+   * @brief Swaps the bytes of an integer on big endian hosts, converts both to and from the file order.
+   */
+  template<typename T>
+  constexpr T toLittleEndian(T value) {
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+      return std::byteswap(value);
+    return value;
+  }
+
+  /**
+   * @brief Appends values to a byte buffer, little endian on every host. Strings and blobs are stored as a u32 length
+   * and the bytes.
+   */
+  class SnapshotWriter {
+public:
+    void writeU8(uint8_t value) { m_buffer.push_back(value); }
+    void writeBool(bool value) { writeU8(value ? 1 : 0); }
+    void writeU32(uint32_t value) { writeValue(value); }
+    void writeI32(int32_t value) { writeValue(value); }
+    void writeU64(uint64_t value) { writeValue(value); }
+    void writeF32(float value) { writeValue(std::bit_cast<uint32_t>(value)); }
+
+    void writeString(std::string_view value) { writeBytes(value.data(), value.size()); }
+    void writeBytes(const void *data, size_t size) {
+      writeU32((uint32_t) size);
+      writeRaw(data, size);
+    }
+
+    /**
+     * @brief Starts a length prefixed block, readers that do not understand the block can skip it.
+     * @return The offset to pass to endBlock()
+     */
+    size_t beginBlock() {
+      writeU32(0);
+      return m_buffer.size();
+    }
+
+    void endBlock(size_t offset) {
+      const uint32_t size = toLittleEndian((uint32_t) (m_buffer.size() - offset));
+      std::memcpy(m_buffer.data() + offset - sizeof(uint32_t), &size, sizeof(size));
+    }
+
+    const std::vector<uint8_t> &getBuffer() const { return m_buffer; }
+
+private:
+    template<typename T>
+    void writeValue(T value) {
+      value = toLittleEndian(value);
+      writeRaw(&value, sizeof(value));
+    }
+
+    void writeRaw(const void *data, size_t size) {
+      const auto *bytes = (const uint8_t *) data;
+      m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+private:
+    std::vector<uint8_t> m_buffer;
+  };
+
+  /**
+   * @brief Reads values written by SnapshotWriter straight out of a (mapped) buffer without copying it.
+   * Reading past the end, or a value the caller rejects with fail(), marks the reader as failed and returns empty
+   * values from then on, check isValid() once afterwards.
+   */
+  class SnapshotReader {
+public:
+    SnapshotReader() = default;
+    SnapshotReader(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+    uint8_t readU8() {
+      uint8_t value = 0;
+      readRaw(&value, sizeof(value));
+      return value;
+    }
+    bool readBool() { return readU8() != 0; }
+    uint32_t readU32() { return readValue<uint32_t>(); }
+    int32_t readI32() { return readValue<int32_t>(); }
+    uint64_t readU64() { return readValue<uint64_t>(); }
+    float readF32() { return std::bit_cast<float>(readValue<uint32_t>()); }
+
+    /**
+     * @brief The view points into the mapped file, copy it when it has to outlive the reader.
+     */
+    std::string_view readString() {
+      const uint32_t size = readU32();
+      const uint8_t *data = skip(size);
+      return data == nullptr ? std::string_view() : std::string_view((const char *) data, size);
+    }
+
+    /**
+     * @brief Reads a block written with beginBlock()/endBlock() as its own reader.
+     */
+    SnapshotReader readBlock() {
+      const uint32_t size = readU32();
+      const uint8_t *data = skip(size);
+      return data == nullptr ? SnapshotReader() : SnapshotReader(data, size);
+    }
+
+    /**
+     * @brief Guards element counts read from the file against allocating for a corrupt value.
+     */
+    uint32_t readCount(size_t minimumElementSize = 1) {
+      const uint32_t count = readU32();
+      if (!m_failed && (uint64_t) count * minimumElementSize > getRemaining()) {
+        m_failed = true;
+        return 0;
+      }
+      return count;
+    }
+
+    const uint8_t *skip(size_t size) {
+      if (m_failed || size > getRemaining()) {
+        m_failed = true;
+        return nullptr;
+      }
+      const uint8_t *data = m_data + m_offset;
+      m_offset += size;
+      return data;
+    }
+
+    /**
+     * @brief Marks the data as corrupt, for values that are in the file but make no sense like an unknown tag.
+     */
+    void fail() { m_failed = true; }
+
+    bool isValid() const { return !m_failed && m_data != nullptr; }
+    size_t getRemaining() const { return m_size - m_offset; }
+
+private:
+    template<typename T>
+    T readValue() {
+      T value = {};
+      readRaw(&value, sizeof(value));
+      return toLittleEndian(value);
+    }
+
+    void readRaw(void *value, size_t size) {
+      if (const uint8_t *data = skip(size); data != nullptr)
+        std::memcpy(value, data, size);
+    }
+
+private:
+    const uint8_t *m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_offset = 0;
+    bool m_failed = false;
+  };
+
+  /**
+   * @brief Implemented by windows that can be saved in a workspace.
+   * A window writes the model state it would otherwise rebuild on open, restoring reads it back through the factory
+   * registered for getSnapshotType() with WorkspaceManager::registerWindowType().
+   */
+  class ISnapshotWindow {
+public:
+    virtual ~ISnapshotWindow() = default;
+
+    virtual const char *getSnapshotType() const = 0;
+    virtual void writeSnapshot(SnapshotWriter &writer) const = 0;
+  };
+}// namespace HummingBirdCore::Workspace
@@ -0,0 +1,260 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#include "WorkspaceManager.h"
+
+#include <HBUI/WindowManager.h>
+
+#include "Utils/MappedFile.h"
+
+#include "System/Hosts/EditHostsWindow.h"
+#include "System/LaunchDaemonsManager.h"
+#include "Terminal/TerminalWindow.h"
+#include "UIWindows/ContentExplorer.h"
+#include "UIWindows/Themes/ThemeManager.h"
+#include "UIWindows/Widget/DataViewer.h"
+#include "UIWindows/Widget/FlameGraphWidget.h"
+#include "UIWindows/Widget/FleetWidget.h"
+#include "UIWindows/Widget/MetricsWidget.h"
+
+namespace HummingBirdCore::Workspace {
+  namespace {
+    template<typename T>
+    std::shared_ptr<UIWindow> restoreWindow(const std::string &name, SnapshotReader &reader) {
+      return std::make_shared<T>(name, reader);
+    }
+
+    //windows without model state only need to be reopened
+    template<typename T>
+    std::shared_ptr<UIWindow> reopenWindow(const std::string &name, SnapshotReader &) {
+      return std::make_shared<T>(name);
+    }
+  }// namespace
+
+  void WorkspaceManager::registerCoreWindows() {
+    registerWindowType("ContentExplorer", restoreWindow<UIWindows::ContentExplorer>);
+    registerWindowType("Terminal", restoreWindow<Terminal::TerminalWindow>);
+    registerWindowType("EditHosts", restoreWindow<System::EditHostsWindow>);
+    registerWindowType("LaunchDaemons", restoreWindow<System::LaunchDaemonsManager>);
+    registerWindowType("DataViewer", restoreWindow<Widgets::DataViewer>);
+    registerWindowType("Metrics", reopenWindow<Widgets::MetricsWidget>);
+    registerWindowType("FlameGraph", reopenWindow<Widgets::FlameGraphWidget>);
+    registerWindowType("Fleet", reopenWindow<Widgets::FleetWidget>);
+    registerWindowType("ThemeManager", reopenWindow<Themes::ThemeManager>);
+  }
+
+  void WorkspaceManager::registerWindowType(const std::string &type, WindowFactory factory) {
+    s_factories[type] = std::move(factory);
+  }
+
+  void WorkspaceManager::addWindow(const std::string &name, const std::shared_ptr<UIWindow> &window) {
+    std::erase_if(s_openWindows, [](const OpenWindow &openWindow) { return openWindow.window.expired(); });
+    if (isNameUsed(name))
+      CORE_WARN("A window named {0} is already open, focusing it by name picks either one", name);
+    s_openWindows.push_back({name, window});
+    UI::WindowManager::getInstance()->addWindow(name, 0, window);
+  }
+
+  std::string WorkspaceManager::makeUniqueName(const std::string &baseName) {
+    for (size_t number = 1;; number++) {
+      std::string name = baseName + std::to_string(number);
+      if (!isNameUsed(name))
+        return name;
+    }
+  }
+
+  bool WorkspaceManager::isNameUsed(const std::string &name) {
+    return std::any_of(s_openWindows.begin(), s_openWindows.end(),
+                       [&](const OpenWindow &openWindow) { return openWindow.name == name && !openWindow.window.expired(); });
+  }
+
+  bool WorkspaceManager::save(const std::filesystem::path &path) {
+    HB_PROFILE_SCOPE("WorkspaceManager::save");
+    const int64_t start = Profiling::Profiler::nowNs();
+
+    std::vector<std::pair<const OpenWindow *, std::shared_ptr<UIWindow>>> windows;
+    for (const auto &openWindow: s_openWindows) {
+      if (auto window = openWindow.window.lock(); window != nullptr && dynamic_cast<ISnapshotWindow *>(window.get()) != nullptr)
+        windows.emplace_back(&openWindow, std::move(window));
+    }
+
+    SnapshotWriter writer;
+    writer.writeU32(c_magic);
+    writer.writeU32(c_version);
+
+    size_t iniSize = 0;
+    const char *ini = ImGui::SaveIniSettingsToMemory(&iniSize);
+    writer.writeBytes(ini, iniSize);
+
+    writer.writeU32((uint32_t) windows.size());
+    for (const auto &[openWindow, window]: windows) {
+      const auto *snapshotWindow = dynamic_cast<const ISnapshotWindow *>(window.get());
+      writer.writeString(snapshotWindow->getSnapshotType());
+      writer.writeString(openWindow->name);
+      const size_t block = writer.beginBlock();
+      snapshotWindow->writeSnapshot(writer);
+      writer.endBlock(block);
+    }
+
+    //write next to the old workspace and swap, a crash halfway never leaves a broken file behind
+    const std::filesystem::path tempPath = path.string() + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      CORE_ERROR("Unable to write workspace: " + tempPath.string());
+      return false;
+    }
+    out.write((const char *) writer.getBuffer().data(), (std::streamsize) writer.getBuffer().size());
+    out.close();
+    if (!out) {
+      CORE_ERROR("Unable to write workspace: " + tempPath.string());
+      return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+      CORE_ERROR("Unable to replace workspace " + path.string() + ": " + ec.message());
+      return false;
+    }
+
+    addRecentFile(path);
+    CORE_INFO("Saved {0} windows ({1} KB) to {2} in {3:.2f} ms", windows.size(), writer.getBuffer().size() / 1024, path.string(),
+              (double) (Profiling::Profiler::nowNs() - start) / 1e6);
+    return true;
+  }
+
+  bool WorkspaceManager::load(const std::filesystem::path &path) {
+    HB_PROFILE_SCOPE("WorkspaceManager::load");
+    const int64_t start = Profiling::Profiler::nowNs();
+
+    Utils::MappedFile file(path);
+    if (!file.isOpen())
+      return false;
+
+    SnapshotReader reader(file.data(), file.size());
+    const uint32_t magic = reader.readU32();
+    const uint32_t version = reader.readU32();
+    if (!reader.isValid() || magic != c_magic) {
+      CORE_ERROR(path.string() + " is not a workspace file");
+      return false;
+    }
+    if (version != c_version) {
+      CORE_ERROR("Workspace " + path.string() + " has version " + std::to_string(version) + ", expected " + std::to_string(c_version));
+      return false;
+    }
+
+    const std::string_view ini = reader.readString();
+    //smallest window record is two empty strings and an empty block
+    const uint32_t windowCount = reader.readCount(3 * sizeof(uint32_t));
+    if (!reader.isValid()) {
+      CORE_ERROR("Workspace " + path.string() + " is truncated");
+      return false;
+    }
+
+    //windows created after this pick up their position, size and docking from the settings
+    ImGui::LoadIniSettingsFromMemory(ini.data(), ini.size());
+
+    size_t restored = 0;
+    for (uint32_t i = 0; i < windowCount; i++) {
+      const std::string type(reader.readString());
+      std::string name(reader.readString());
+      SnapshotReader payload = reader.readBlock();
+      if (!reader.isValid()) {
+        CORE_ERROR("Workspace " + path.string() + " is truncated");
+        break;
+      }
+
+      auto factory = s_factories.find(type);
+      if (factory == s_factories.end()) {
+        CORE_WARN("Skipping window " + name + ", unknown type " + type);
+        continue;
+      }
+
+      //loading into a session that already has a window by that name, the saved layout is lost for this one
+      if (isNameUsed(name))
+        name = makeUniqueName(name.substr(0, name.find_last_not_of("0123456789") + 1));
+      std::shared_ptr<UIWindow> window = factory->second(name, payload);
+      if (window == nullptr || !payload.isValid()) {
+        CORE_ERROR("Skipping window " + name + ", its snapshot is corrupt");
+        continue;
+      }
+      addWindow(name, window);
+      restored++;
+    }
+
+    addRecentFile(path);
+    CORE_INFO("Restored {0} windows from {1} in {2:.2f} ms", restored, path.string(), (double) (Profiling::Profiler::nowNs() - start) / 1e6);
+    return true;
+  }
+
+  bool WorkspaceManager::focusWindow(const std::string &name) {
+    if (!isNameUsed(name))
+      return false;
+    //HBUI titles the window with the name it was added under
+    ImGui::SetWindowFocus(name.c_str());
+    return true;
+  }
+
+  size_t WorkspaceManager::getOpenWindowCount() {
+    return (size_t) std::count_if(s_openWindows.begin(), s_openWindows.end(), [](const OpenWindow &openWindow) { return !openWindow.window.expired(); });
+  }
+
+  void WorkspaceManager::forEachOpenWindow(const std::function<void(const std::string &name)> &callback) {
+    for (const auto &openWindow: s_openWindows) {
+      if (!openWindow.window.expired())
+        callback(openWindow.name);
+    }
+  }
+
+  void WorkspaceManager::addRecentFile(const std::filesystem::path &path) {
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    if (ec)
+      absolute = path;
+    std::erase(s_recentFiles, absolute);
+    s_recentFiles.insert(s_recentFiles.begin(), std::move(absolute));
+    if (s_recentFiles.size() > c_maxRecentFiles)
+      s_recentFiles.resize(c_maxRecentFiles);
+    saveRecentFiles();
+  }
+
+  std::filesystem::path WorkspaceManager::getRecentFilesPath() {
+    const char *home = std::getenv("HOME");
+    if (home == nullptr)
+      return {};
+    return std::filesystem::path(home) / ".hummingbird" / "recent_workspaces";
+  }
+
+  void WorkspaceManager::loadRecentFiles() {
+    const std::filesystem::path path = getRecentFilesPath();
+    std::ifstream file(path);
+    if (path.empty() || !file.is_open())
+      return;
+
+    s_recentFiles.clear();
+    std::string line;
+    while (std::getline(file, line) && s_recentFiles.size() < c_maxRecentFiles) {
+      if (!line.empty())
+        s_recentFiles.emplace_back(line);
+    }
+  }
+
+  //one path per line, most recent first
+  void WorkspaceManager::saveRecentFiles() {
+    const std::filesystem::path path = getRecentFilesPath();
+    if (path.empty())
+      return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+      CORE_WARN("Unable to write the recent workspaces to " + path.string());
+      return;
+    }
+    for (const auto &recentFile: s_recentFiles) {
+      file << recentFile.string() << '\n';
+    }
+  }
+}// namespace HummingBirdCore::Workspace
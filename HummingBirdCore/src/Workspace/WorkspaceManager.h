@@ -0,0 +1,93 @@
+//
+// Created by Kasper de Bruin on 18/10/2026.
+//
+
+#pragma once
+#include <PCH/pch.h>
+
+#include <HBUI/UIWindow.h>
+
+#include "Snapshot.h"
+
+namespace HummingBirdCore::Workspace {
+  /**
+   * @brief Saves and restores the open windows, the ImGui layout and the window models as one binary file.
+   *
+   * Layout of a workspace file, all values little endian:
+   *   u32 magic 'HBWS', u32 version
+   *   string imgui ini settings
+   *   u32 window count, per window: string type, string name, block payload
+   *
+   * The file is memory mapped on load, windows read their payload straight out of the mapping so restoring does not
+   * scan the filesystem or parse plists again. Unknown window types are skipped, their payload is a sized block.
+   */
+  class WorkspaceManager {
+public:
+    using WindowFactory = std::function<std::shared_ptr<UIWindow>(const std::string &name, SnapshotReader &reader)>;
+
+    /**
+     * @brief Registers the windows that ship with the core.
+     */
+    static void registerCoreWindows();
+
+    static void registerWindowType(const std::string &type, WindowFactory factory);
+
+    /**
+     * @brief Opens a window through the window manager and remembers it for the next save.
+     * @param name Unique among the open windows, HBUI titles and focuses the window by it, see makeUniqueName()
+     */
+    static void addWindow(const std::string &name, const std::shared_ptr<UIWindow> &window);
+
+    /**
+     * @brief baseName followed by the lowest number no open window uses yet, "Terminal 1", "Terminal 2".
+     */
+    static std::string makeUniqueName(const std::string &baseName);
+
+    static bool save(const std::filesystem::path &path);
+
+    /**
+     * @brief Applies the layout and opens every window stored in the file.
+     * Call between frames, the menu defers it through the main thread queue.
+     */
+    static bool load(const std::filesystem::path &path);
+
+    /**
+     * @return false when no window by that name is open
+     */
+    static bool focusWindow(const std::string &name);
+
+    static size_t getOpenWindowCount();
+    static void forEachOpenWindow(const std::function<void(const std::string &name)> &callback);
+
+    /**
+     * @brief Workspaces saved or loaded, most recent first. The list is kept in ~/.hummingbird/recent_workspaces.
+     */
+    static const std::vector<std::filesystem::path> &getRecentFiles() { return s_recentFiles; }
+
+    /**
+     * @brief Reads the recent workspaces of earlier sessions, called once by the application on start.
+     */
+    static void loadRecentFiles();
+
+private:
+    static void addRecentFile(const std::filesystem::path &path);
+    static void saveRecentFiles();
+    static std::filesystem::path getRecentFilesPath();
+    static bool isNameUsed(const std::string &name);
+
+private:
+    struct OpenWindow {
+      std::string name;
+      std::weak_ptr<UIWindow> window;
+    };
+
+private:
+    static constexpr uint32_t c_magic = 0x53574248;//'HBWS'
+    static constexpr uint32_t c_version = 2;
+    static constexpr size_t c_maxRecentFiles = 10;
+
+    inline static std::vector<OpenWindow> s_openWindows = {};
+    inline static std::unordered_map<std::string, WindowFactory> s_factories = {};
+    inline static std::vector<std::filesystem::path> s_recentFiles = {};
+  };
+}// namespace HummingBirdCore::Workspace
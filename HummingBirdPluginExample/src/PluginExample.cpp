@@ -6,7 +6,21 @@
 
 void PluginExample::initialize() {
   std::cout << "PluginManager initialized" << std::endl;
-  HummingBirdCore::UI::WindowManager::getInstance()->addWindow("Plugin Example", 0, std::make_shared<PluginExampleWindow>());
+  openWindow();
+  if (getCommandRegistry() != nullptr) {
+    getCommandRegistry()->addCommand("Plugin Example", "Open Plugin Example", [this] { openWindow(); });
+    getCommandRegistry()->addCommand("Plugin Example", "Say hello", [] { std::cout << "Hello from the plugin example" << std::endl; });
+  }
+}
+
+void PluginExample::openWindow() {
+  if (getWindowRegistry() == nullptr) {
+    HummingBirdCore::UI::WindowManager::getInstance()->addWindow("Plugin Example", 0, std::make_shared<PluginExampleWindow>());
+    return;
+  }
+  //the host saves and focuses the windows it knows about
+  if (!getWindowRegistry()->focusWindow("Plugin Example"))
+    getWindowRegistry()->addWindow("Plugin Example", std::make_shared<PluginExampleWindow>());
 }
 
 void PluginExample::cleanup() {
@@ -4,7 +4,7 @@
 
 #ifndef HUMMINGBIRD_PLUGINMANAGER_H
 #define HUMMINGBIRD_PLUGINMANAGER_H
-#include "../include/IPlugin.h"
+#include <IPlugin.h>
 #include <HBUI/HBUI.h>
 
 #include "PluginExampleWindow.h"
@@ -17,6 +17,9 @@ class PluginExample : public HummingBird::Plugins::IPlugin {
   void initialize() override;
   void update() override;
   void cleanup() override;
+
+  private:
+  void openWindow();
 };
 
 extern "C" HummingBird::Plugins::IPlugin *create_plugin(
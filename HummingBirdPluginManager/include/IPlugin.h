@@ -5,9 +5,157 @@
 #ifndef HUMMINGBIRD_PLUGIN_MANAGER_IPLUGIN_H
 #define HUMMINGBIRD_PLUGIN_MANAGER_IPLUGIN_H
 #include <HBUI/HBUI.h>
+#include <HBUI/UIWindow.h>
 #include <HBUI/WindowManager.h>
 
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace HummingBird::Plugins {
+  /**
+   * @brief Tasks that are waited on and cancelled together, made by ITaskScheduler::createGroup().
+   * Destroying the group waits for its tasks.
+   */
+  class ITaskGroup {
+public:
+    virtual ~ITaskGroup() = default;
+
+    /**
+     * @brief Queues task, it is skipped when the group is cancelled before it starts.
+     */
+    virtual void post(std::function<void()> task) = 0;
+
+    /**
+     * @brief Tasks that already run finish, the ones that did not start yet are skipped.
+     */
+    virtual void cancel() = 0;
+    virtual bool isCancelled() const = 0;
+
+    /**
+     * @brief Blocks until every task finished or was skipped. On a worker the caller runs other tasks while waiting.
+     */
+    virtual void wait() = 0;
+    virtual bool isDone() = 0;
+  };
+
+  /**
+   * @brief The core thread pool, plugins queue their background work here instead of starting their own threads.
+   */
+  class ITaskScheduler {
+public:
+    virtual ~ITaskScheduler() = default;
+
+    virtual void post(std::function<void()> task) = 0;
+
+    /**
+     * @brief Queues task, continuation is queued once it finished, with succeeded false when task threw.
+     */
+    virtual void postThen(std::function<void()> task, std::function<void(bool succeeded)> continuation) = 0;
+
+    virtual std::unique_ptr<ITaskGroup> createGroup() = 0;
+    virtual size_t getWorkerCount() const = 0;
+  };
+
+  /**
+   * @brief Hands out ImGui allocator user data that accounts memory to a named owner.
+   * Pass the result as userData to create_plugin so the host can show memory use per plugin.
+   */
+  class IAllocatorRegistry {
+public:
+    virtual ~IAllocatorRegistry() = default;
+
+    virtual void *registerOwner(const char *name) = 0;
+  };
+
+  /**
+   * @brief The host stats registry, plugins record into it so their numbers show up next to the core ones.
+   */
+  class IMetrics {
+public:
+    virtual ~IMetrics() = default;
+
+    /**
+     * @brief Looks a timer up once, names are dotted paths like "plugin.example.load_time".
+     * @return Handle to pass to recordTime()
+     */
+    virtual void *getTimer(const char *name) = 0;
+    virtual void recordTime(void *timer, uint64_t microseconds) = 0;
+  };
+
+  /**
+   * @brief The host command palette and main menu, plugins add the actions they want to be reachable from either.
+   * The host lists them under Plugins, the category is the menu path below that, '/' separates submenus.
+   */
+  class ICommandRegistry {
+public:
+    virtual ~ICommandRegistry() = default;
+
+    /**
+     * @brief Called on the main thread when the user picks the command, usually from initialize().
+     */
+    virtual void addCommand(const char *category, const char *name, std::function<void()> action) = 0;
+
+    /**
+     * @brief The plugin manager removes every command a plugin added when it cleans up, the actions point into the
+     * plugin's library.
+     */
+    virtual void removeCommand(const char *category, const char *name) = 0;
+  };
+
+  /**
+   * @brief The host windows, plugins open theirs through it so the host can list, focus and save them.
+   */
+  class IWindowRegistry {
+public:
+    virtual ~IWindowRegistry() = default;
+
+    virtual void addWindow(const char *name, std::shared_ptr<HummingBirdCore::UIWindow> window) = 0;
+
+    /**
+     * @brief Brings the open window that was added under name to the front.
+     * @return false when no window by that name is open
+     */
+    virtual bool focusWindow(const char *name) = 0;
+  };
+
+  /**
+   * @brief A command a plugin adds to the command palette, listed in its manifest so it can be shown before the plugin is loaded.
+   *
+   * Every window in the manifest gets an "Open <window>" command under the plugin name. When the plugin registers
+   * that command itself it is run after loading, otherwise the window the plugin added in initialize() is focused.
+   */
+  struct PluginContribution {
+    std::string category;
+    std::string name;
+  };
+
+  /**
+   * @brief What the host knows about a plugin without loading it, read from the manifest next to the library.
+   */
+  struct PluginManifest {
+    std::string name;
+    std::string version;
+    std::filesystem::path library;
+    //names of plugins that have to be initialized first
+    std::vector<std::string> dependencies;
+    //loaded the first time one of its commands or windows is used instead of at startup
+    bool lazy = false;
+    std::vector<PluginContribution> commands;
+    std::vector<std::string> windows;
+  };
+
+  /**
+   * @brief Implemented by every plugin library.
+   *
+   * The host may dlopen a plugin library on a worker thread to warm it up before it is loaded for real. The static
+   * constructors of a plugin, and any other code that runs when the library is loaded, can therefore run off the main
+   * thread and before the ImGui context and window manager exist. Keep them free of ImGui, HBUI and thread bound
+   * state. The constructor and initialize() run on the main thread, do that work there.
+   */
   class IPlugin {
 public:
       IPlugin(HummingBirdCore::UI::WindowManager *windowManagerPtr, ImGuiContext *imGuiContext,
@@ -20,6 +168,45 @@ public:
     virtual void initialize() = 0;
     virtual void update() = 0;
     virtual void cleanup() = 0;
+
+    /**
+     * @brief Set by the host before initialize(), nullptr when the plugin is loaded without a scheduler.
+     */
+    void setTaskScheduler(ITaskScheduler *taskScheduler) { m_taskScheduler = taskScheduler; }
+    ITaskScheduler *getTaskScheduler() const { return m_taskScheduler; }
+
+    /**
+     * @brief Set by the host before initialize(), nullptr when allocations are not tracked per plugin.
+     */
+    void setAllocatorRegistry(IAllocatorRegistry *allocatorRegistry) { m_allocatorRegistry = allocatorRegistry; }
+    IAllocatorRegistry *getAllocatorRegistry() const { return m_allocatorRegistry; }
+
+    /**
+     * @brief Set by the host before initialize(), nullptr when the host does not collect stats.
+     */
+    void setMetrics(IMetrics *metrics) { m_metrics = metrics; }
+    IMetrics *getMetrics() const { return m_metrics; }
+
+    /**
+     * @brief Set by the host before initialize(), nullptr when the host has no command palette.
+     */
+    void setCommandRegistry(ICommandRegistry *commandRegistry) { m_commandRegistry = commandRegistry; }
+    ICommandRegistry *getCommandRegistry() const { return m_commandRegistry; }
+
+    /**
+     * @brief Set by the host before initialize(), nullptr when plugins add their windows to the window manager themselves.
+     * A window added to the window manager directly is not listed, focused or saved by the host, only fall back to
+     * that when this is nullptr.
+     */
+    void setWindowRegistry(IWindowRegistry *windowRegistry) { m_windowRegistry = windowRegistry; }
+    IWindowRegistry *getWindowRegistry() const { return m_windowRegistry; }
+
+private:
+    ITaskScheduler *m_taskScheduler = nullptr;
+    IAllocatorRegistry *m_allocatorRegistry = nullptr;
+    IMetrics *m_metrics = nullptr;
+    ICommandRegistry *m_commandRegistry = nullptr;
+    IWindowRegistry *m_windowRegistry = nullptr;
   };
 }// namespace HummingBird::Plugins
 #endif//HUMMINGBIRD_PLUGIN_MANAGER_IPLUGIN_H
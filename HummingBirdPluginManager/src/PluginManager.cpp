@@ -6,7 +6,10 @@
 
 void PluginManager::initialize() {
   std::cout << "PluginManager initialized" << std::endl;
-  HummingBirdCore::UI::WindowManager::getInstance()->addWindow("PluginManager", 0, std::make_shared<PluginManagerWindow>());
+  if (getWindowRegistry() != nullptr)
+    getWindowRegistry()->addWindow("PluginManager", std::make_shared<PluginManagerWindow>());
+  else
+    HummingBirdCore::UI::WindowManager::getInstance()->addWindow("PluginManager", 0, std::make_shared<PluginManagerWindow>());
 }
 
 void PluginManager::cleanup() {
@@ -14,10 +17,22 @@ void PluginManager::cleanup() {
   for (auto &plugin : plugins) {
     plugin->cleanup();
   }
+  //the stubs and plugin actions capture this and code in the plugin libraries
+  for (auto &entry : entries) {
+    if (entry.commandRegistry != nullptr)
+      entry.commandRegistry->removeAll();
+  }
+  for (auto &registry : ownedRegistries) {
+    registry->removeAll();
+  }
 }
 
 void PluginManager::update() {
-  for (auto &plugin : plugins) {
-    plugin->update();
+  for (size_t i = 0; i < plugins.size(); i++) {
+    const auto start = std::chrono::steady_clock::now();
+    plugins[i]->update();
+    if (updateTimers[i] != nullptr) {
+      getMetrics()->recordTime(updateTimers[i], (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
   }
 }
\ No newline at end of file
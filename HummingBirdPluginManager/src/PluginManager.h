@@ -12,14 +12,100 @@
 #include <iostream>
 #include <vector>
 
+#include <chrono>
 #include <dlfcn.h>
 #include <iostream>
+#include <map>
+#include <memory>
 
 struct PluginData{
   std::string name;
   std::filesystem::path fullPath;
 };
 
+/**
+ * @brief Handed to every plugin instead of the host registry. Remembers what the plugin added so the manager can take
+ * it out of the host again on cleanup, the actions point into the plugin's library.
+ */
+class TrackingCommandRegistry : public HummingBird::Plugins::ICommandRegistry {
+  public:
+  explicit TrackingCommandRegistry(HummingBird::Plugins::ICommandRegistry *host) : host(host) {
+  }
+
+  void addCommand(const char *category, const char *name, std::function<void()> action) override {
+    if (host == nullptr)
+      return;
+    added.emplace_back(category, name);
+    host->addCommand(category, name, std::move(action));
+  }
+
+  void removeCommand(const char *category, const char *name) override {
+    if (host == nullptr)
+      return;
+    std::erase(added, std::make_pair(std::string(category), std::string(name)));
+    host->removeCommand(category, name);
+  }
+
+  /**
+   * @brief Removes every command added through this registry from the host.
+   */
+  void removeAll() {
+    for (const auto &[category, name]: added) {
+      host->removeCommand(category.c_str(), name.c_str());
+    }
+    added.clear();
+  }
+
+  protected:
+  HummingBird::Plugins::ICommandRegistry *host;
+  std::vector<std::pair<std::string, std::string>> added;
+};
+
+/**
+ * @brief Handed to a lazy plugin. The commands its manifest lists are already in the palette as stubs that load the
+ * plugin, those are kept here for the stub to run, everything else goes to the host.
+ */
+class LazyCommandRegistry : public TrackingCommandRegistry {
+  public:
+  using Actions = std::map<std::string, std::shared_ptr<std::function<void()>>>;
+
+  LazyCommandRegistry(HummingBird::Plugins::ICommandRegistry *host, Actions actions) : TrackingCommandRegistry(host), actions(std::move(actions)) {
+  }
+
+  void addCommand(const char *category, const char *name, std::function<void()> action) override {
+    auto it = actions.find(std::string(category) + "/" + name);
+    if (it != actions.end()) {
+      *it->second = std::move(action);
+    } else {
+      TrackingCommandRegistry::addCommand(category, name, std::move(action));
+    }
+  }
+
+  /**
+   * @brief Adds the command that loads the plugin, it is removed with the rest on cleanup.
+   */
+  void addStub(const std::string &category, const std::string &name, std::function<void()> stub) {
+    TrackingCommandRegistry::addCommand(category.c_str(), name.c_str(), std::move(stub));
+  }
+
+  private:
+  Actions actions;
+};
+
+enum PluginState {
+  PluginStateRegistered,
+  PluginStateLoading,
+  PluginStateLoaded,
+  PluginStateFailed
+};
+
+struct PluginEntry {
+  HummingBird::Plugins::PluginManifest manifest;
+  PluginState state = PluginStateRegistered;
+  //a LazyCommandRegistry for lazy plugins, lives as long as the plugin can add commands
+  std::unique_ptr<TrackingCommandRegistry> commandRegistry = nullptr;
+};
+
 class PluginManager : public HummingBird::Plugins::IPlugin {
   public:
   PluginManager(HummingBirdCore::UI::WindowManager *windowManagerPtr, ImGuiContext *imGuiContext,
@@ -29,7 +115,55 @@ class PluginManager : public HummingBird::Plugins::IPlugin {
   void update() override;
   void cleanup() override;
 
-  bool addPlugin(const std::filesystem::path &path) {
+  /**
+   * @brief Loads the plugin now, or only adds its commands and windows to the palette when the manifest marks it lazy.
+   * Called in dependency order, the dependencies of a plugin are registered before it.
+   */
+  bool addPlugin(const HummingBird::Plugins::PluginManifest &manifest) {
+    entries.push_back({manifest});
+    const size_t index = entries.size() - 1;
+    if (!manifest.lazy) {
+      entries[index].commandRegistry = std::make_unique<TrackingCommandRegistry>(getCommandRegistry());
+      return loadEntry(index);
+    }
+
+    LazyCommandRegistry::Actions actions;
+    for (const auto &command: manifest.commands) {
+      actions[command.category + "/" + command.name] = std::make_shared<std::function<void()>>();
+    }
+    for (const auto &window: manifest.windows) {
+      actions[manifest.name + "/Open " + window] = std::make_shared<std::function<void()>>();
+    }
+    auto registry = std::make_unique<LazyCommandRegistry>(getCommandRegistry(), actions);
+
+    //the first use loads the plugin, which fills in the action it registers under this name
+    for (const auto &command: manifest.commands) {
+      registry->addStub(command.category, command.name, [this, index, action = actions[command.category + "/" + command.name]] {
+        if (loadEntry(index) && *action)
+          (*action)();
+      });
+    }
+    //a plugin that does not register a command to open its window added it in initialize(), it only needs the focus
+    for (const auto &window: manifest.windows) {
+      registry->addStub(manifest.name, "Open " + window, [this, index, window, action = actions[manifest.name + "/Open " + window]] {
+        if (!loadEntry(index))
+          return;
+        if (*action) {
+          (*action)();
+        } else if (getWindowRegistry() == nullptr || !getWindowRegistry()->focusWindow(window.c_str())) {
+          std::cerr << "Plugin " << entries[index].manifest.name << " did not open window " << window << std::endl;
+        }
+      });
+    }
+    entries[index].commandRegistry = std::move(registry);
+    return true;
+  }
+
+  /**
+   * @brief Loads the library now, commandRegistry is what the plugin adds its commands through.
+   * Without one the plugin gets its own registry that is cleaned up with the manager.
+   */
+  bool addPlugin(const std::filesystem::path &path, TrackingCommandRegistry *commandRegistry = nullptr) {
     // Pass the context to the libraries
     void *handle = dlopen(path.string().c_str(),
                           RTLD_LAZY);
@@ -61,6 +195,10 @@ class PluginManager : public HummingBird::Plugins::IPlugin {
     ImGuiMemFreeFunc p_free;
     void *p_user_data;
     ImGui::GetAllocatorFunctions(&p_alloc, &p_free, &p_user_data);
+    //account the plugin's ImGui memory to the plugin itself
+    if (getAllocatorRegistry() != nullptr) {
+      p_user_data = getAllocatorRegistry()->registerOwner(path.stem().string().c_str());
+    }
     HummingBird::Plugins::IPlugin *plugin = create_plugin(
             HummingBirdCore::UI::WindowManager::getInstance(), ImGui::GetCurrentContext(), p_alloc, p_free, p_user_data);
 
@@ -71,12 +209,61 @@ class PluginManager : public HummingBird::Plugins::IPlugin {
     }
 
     plugins.push_back(plugin);
+    //update() times every plugin on its own, the host shows the cost per plugin
+    updateTimers.push_back(getMetrics() != nullptr ? getMetrics()->getTimer(("plugin." + path.stem().string() + ".update_time").c_str()) : nullptr);
+    plugin->setTaskScheduler(getTaskScheduler());
+    plugin->setAllocatorRegistry(getAllocatorRegistry());
+    plugin->setMetrics(getMetrics());
+    if (commandRegistry == nullptr) {
+      ownedRegistries.push_back(std::make_unique<TrackingCommandRegistry>(getCommandRegistry()));
+      commandRegistry = ownedRegistries.back().get();
+    }
+    plugin->setCommandRegistry(getCommandRegistry() != nullptr ? commandRegistry : nullptr);
+    plugin->setWindowRegistry(getWindowRegistry());
     plugin->initialize();
     return true;
   }
 
   private:
+  /**
+   * @brief Loads a registered plugin after its dependencies, does nothing when it is already loaded.
+   */
+  bool loadEntry(size_t index) {
+    PluginEntry &entry = entries[index];
+    if (entry.state == PluginStateLoaded)
+      return true;
+    if (entry.state != PluginStateRegistered)
+      return false;
+
+    entry.state = PluginStateLoading;
+    for (const auto &dependency: entry.manifest.dependencies) {
+      auto it = std::find_if(entries.begin(), entries.end(), [&](const PluginEntry &other) { return other.manifest.name == dependency; });
+      if (it == entries.end() || !loadEntry((size_t) (it - entries.begin()))) {
+        std::cerr << "Cannot load plugin " << entry.manifest.name << ", dependency " << dependency << " failed to load" << std::endl;
+        entries[index].state = PluginStateFailed;
+        return false;
+      }
+    }
+
+    //loading a dependency may have added entries, take the reference again
+    PluginEntry &loading = entries[index];
+    const auto start = std::chrono::steady_clock::now();
+    const bool loaded = addPlugin(loading.manifest.library, loading.commandRegistry.get());
+    loading.state = loaded ? PluginStateLoaded : PluginStateFailed;
+    if (loaded && getMetrics() != nullptr) {
+      void *timer = getMetrics()->getTimer(("plugin." + loading.manifest.name + ".load_time").c_str());
+      getMetrics()->recordTime(timer, (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    return loaded;
+  }
+
+  private:
+  //registered plugins in dependency order, only appended to so the lazy stubs can keep an index
+  std::vector<PluginEntry> entries = {};
   std::vector<HummingBird::Plugins::IPlugin *> plugins = {};
+  //for plugins loaded by path, without an entry
+  std::vector<std::unique_ptr<TrackingCommandRegistry>> ownedRegistries = {};
+  std::vector<void *> updateTimers = {};
   std::vector<void *> handles = {};
 };
 
@@ -90,4 +277,8 @@ extern "C" bool loadPlugin(const std::filesystem::path &path, HummingBird::Plugi
   return static_cast<PluginManager *>(pluginManager)->addPlugin(path);
 }
 
+extern "C" bool registerPlugin(const HummingBird::Plugins::PluginManifest &manifest, HummingBird::Plugins::IPlugin *pluginManager) {
+  return static_cast<PluginManager *>(pluginManager)->addPlugin(manifest);
+}
+
 #endif//HUMMINGBIRD_PLUGINMANAGER_H